@@ -0,0 +1,188 @@
+/**
+ * @file adaptive_fanout_benchmark.cpp
+ * @brief Convergence time and bandwidth of fixed and cluster-size-adaptive fanout
+ *
+ * Simulates a cluster of N cores exchanging JSON-serialized messages in
+ * memory, every core knowing every member from the start. After a warmup,
+ * U members change their metadata in the same round and the cluster runs
+ * until every member has seen every change. Rounds are heartbeats, so at
+ * the default 100 ms interval ten rounds are a second.
+ *
+ * Compared are the fixed defaults (3 pings per tick, 2 entries per
+ * message), adaptive_fanout (both grow as ceil(ln(N))) and adaptive_fanout
+ * with a per-tick budget. Reported are the effective fanout and entries,
+ * the rounds to convergence and the idle bytes per second each member
+ * sends.
+ */
+
+#include "bench_util.hpp"
+#include "net/json_serializer.hpp"
+#include <algorithm>
+#include <cstdio>
+#include <deque>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace libgossip;
+
+namespace {
+
+    uint32_t index_of(const node_id_t &id) {
+        return (static_cast<uint32_t>(id[13]) << 16) | (static_cast<uint32_t>(id[14]) << 8) | id[15];
+    }
+
+    struct variant {
+        const char *name;
+        bool adaptive;
+        uint32_t budget;
+    };
+
+    class simulated_cluster {
+    public:
+        simulated_cluster(uint32_t n, const variant &v) : n_(n), updated_(static_cast<size_t>(n) * n, false) {
+            gossip_core_options options;
+            options.failure_timeout_ms = 600000;// Rounds run faster than real time
+            options.max_nodes = 0;
+            options.adaptive_fanout = v.adaptive;
+            options.tick_budget_bytes = v.budget;
+
+            for (uint32_t i = 0; i < n; ++i) {
+                cores_.push_back(std::make_unique<gossip_core>(
+                        bench::make_node(i),
+                        [this](const gossip_message &msg, const node_view &target) {
+                            if (seeding_) {
+                                return;
+                            }
+                            std::vector<uint8_t> bytes;
+                            serializer_.serialize(msg, bytes);
+                            bytes_sent_ += bytes.size();
+                            queue_.push_back({index_of(target.id), std::move(bytes)});
+                        },
+                        [this, i](const node_view &node, node_status) {
+                            auto it = node.metadata.find("epoch");
+                            const size_t cell = static_cast<size_t>(i) * n_ + index_of(node.id);
+                            if (it != node.metadata.end() && it->second == "v2" && !updated_[cell]) {
+                                updated_[cell] = true;
+                                ++updated_count_;
+                            }
+                        },
+                        options));
+            }
+
+            seeding_ = true;
+            for (uint32_t i = 0; i < n; ++i) {
+                for (uint32_t j = 0; j < n; ++j) {
+                    if (i != j) {
+                        cores_[i]->meet(bench::make_node(j));
+                    }
+                }
+            }
+            seeding_ = false;
+        }
+
+        /// One heartbeat: every core ticks, then all messages (and replies) are delivered
+        void round() {
+            for (auto &core: cores_) {
+                core->tick();
+            }
+            deliver();
+        }
+
+        void update_metadata(uint32_t member) {
+            cores_[member]->update_self_metadata({{"epoch", "v2"}});
+        }
+
+        /// Whether every core has seen the change of every member in updated
+        bool converged(size_t updates) const { return updated_count_ == updates * (n_ - 1); }
+
+        size_t bytes_sent() const { return bytes_sent_; }
+        gossip_stats stats() const { return cores_[0]->get_stats(); }
+
+    private:
+        struct envelope {
+            uint32_t to;
+            std::vector<uint8_t> bytes;
+        };
+
+        void deliver() {
+            while (!queue_.empty()) {
+                envelope e = std::move(queue_.front());
+                queue_.pop_front();
+                gossip_message msg;
+                if (serializer_.deserialize(e.bytes, msg) == serialization_error::success && e.to < cores_.size()) {
+                    cores_[e.to]->handle_message(msg, clock::now());
+                }
+            }
+        }
+
+        uint32_t n_;
+        json_serializer serializer_;
+        std::vector<std::unique_ptr<gossip_core>> cores_;
+        std::deque<envelope> queue_;
+        std::vector<bool> updated_;// [core * n + member]: core has seen member's change
+        size_t updated_count_ = 0;
+        bool seeding_ = false;
+        size_t bytes_sent_ = 0;
+    };
+
+}// namespace
+
+int main() {
+    const std::vector<uint32_t> sizes = {16, 64, 256, 512};
+    const std::vector<variant> variants = {
+            {"fixed", false, 0},
+            {"adaptive", true, 0},
+            {"adaptive 4KB", true, 4096},
+    };
+    const size_t updates = 4;
+    const int warmup_rounds = 10;
+    const int idle_rounds = 10;
+    const int max_rounds = 500;
+    const double rounds_per_second = 1000.0 / config::DEFAULT_HEARTBEAT_INTERVAL_MS;
+
+    std::printf("%8s %14s %8s %8s %8s %12s %18s\n", "members", "fanout", "pings", "entries", "rounds",
+                "converge ms", "idle B/s/member");
+
+    for (uint32_t n: sizes) {
+        for (const auto &v: variants) {
+            simulated_cluster cluster(n, v);
+            for (int r = 0; r < warmup_rounds; ++r) {
+                cluster.round();
+            }
+
+            size_t before = cluster.bytes_sent();
+            for (int r = 0; r < idle_rounds; ++r) {
+                cluster.round();
+            }
+            const double idle = static_cast<double>(cluster.bytes_sent() - before) / idle_rounds *
+                                rounds_per_second / n;
+
+            std::mt19937 rng(n);
+            std::vector<uint32_t> updated;
+            while (updated.size() < updates) {
+                const auto member = static_cast<uint32_t>(rng() % n);
+                if (std::find(updated.begin(), updated.end(), member) == updated.end()) {
+                    updated.push_back(member);
+                    cluster.update_metadata(member);
+                }
+            }
+            int rounds = 0;
+            while (!cluster.converged(updates) && rounds < max_rounds) {
+                cluster.round();
+                ++rounds;
+            }
+
+            const gossip_stats stats = cluster.stats();
+            const bool done = rounds < max_rounds;
+            std::printf("%8u %14s %8d %8d %8s %12s %18.0f\n", n, v.name, stats.gossip_nodes, stats.sync_nodes,
+                        done ? std::to_string(rounds).c_str() : "n/a",
+                        done ? std::to_string(static_cast<int>(rounds * 1000 / rounds_per_second)).c_str() : "n/a",
+                        idle);
+            std::fflush(stdout);
+        }
+    }
+
+    return 0;
+}
@@ -0,0 +1,170 @@
+/**
+ * @file anti_entropy_benchmark.cpp
+ * @brief Time to convergence after a 50/50 partition heals, with and without Merkle anti-entropy
+ *
+ * Simulates a cluster of N cores exchanging JSON-serialized messages in
+ * memory. Every core starts out knowing every member. The cluster is then
+ * split in two halves that cannot reach each other, and every member
+ * changes its metadata. After the split has run for a while it heals, and
+ * the benchmark counts the rounds (heartbeats) and bytes until every core
+ * has every member's new metadata.
+ *
+ * Rounds run faster than real time, so anti_entropy_interval_ms = 1 means
+ * one session per member per round (a session between peers that are in
+ * sync is a single root hash).
+ */
+
+#include "bench_util.hpp"
+#include "net/json_serializer.hpp"
+#include <cstdio>
+#include <deque>
+#include <memory>
+#include <string>
+#include <vector>
+
+using namespace libgossip;
+
+namespace {
+
+    uint32_t index_of(const node_id_t &id) {
+        return (static_cast<uint32_t>(id[13]) << 16) | (static_cast<uint32_t>(id[14]) << 8) | id[15];
+    }
+
+    class simulated_cluster {
+    public:
+        simulated_cluster(uint32_t n, dissemination_mode mode, bool anti_entropy)
+            : n_(n), updated_(static_cast<size_t>(n) * n, false) {
+            gossip_core_options options;
+            options.dissemination = mode;
+            options.failure_timeout_ms = 600000;// Rounds run faster than real time
+            options.anti_entropy_interval_ms = anti_entropy ? 1 : 0;
+
+            for (uint32_t i = 0; i < n; ++i) {
+                cores_.push_back(std::make_unique<gossip_core>(
+                        bench::make_node(i),
+                        [this, i](const gossip_message &msg, const node_view &target) {
+                            const uint32_t to = index_of(target.id);
+                            if (seeding_ || (split_ && (i < n_ / 2) != (to < n_ / 2))) {
+                                return;
+                            }
+                            std::vector<uint8_t> bytes;
+                            serializer_.serialize(msg, bytes);
+                            bytes_sent_ += bytes.size();
+                            queue_.push_back({to, std::move(bytes)});
+                        },
+                        [this, i](const node_view &node, node_status) {
+                            auto it = node.metadata.find("epoch");
+                            const size_t cell = static_cast<size_t>(i) * n_ + index_of(node.id);
+                            if (it != node.metadata.end() && it->second == "v2" && !updated_[cell]) {
+                                updated_[cell] = true;
+                                ++updated_count_;
+                            }
+                        },
+                        options));
+            }
+
+            seeding_ = true;
+            for (uint32_t i = 0; i < n; ++i) {
+                for (uint32_t j = 0; j < n; ++j) {
+                    if (i != j) {
+                        cores_[i]->meet(bench::make_node(j));
+                    }
+                }
+            }
+            seeding_ = false;
+        }
+
+        /// One heartbeat: every core ticks, then all messages (and replies) are delivered
+        void round() {
+            for (auto &core: cores_) {
+                core->tick();
+            }
+            deliver();
+        }
+
+        void split(bool on) { split_ = on; }
+
+        /// Every member changes its metadata
+        void update_all() {
+            for (auto &core: cores_) {
+                core->update_self_metadata({{"epoch", "v2"}});
+            }
+        }
+
+        /// Whether every core has seen every other member's change
+        bool converged() const { return updated_count_ == static_cast<size_t>(n_) * (n_ - 1); }
+
+        size_t bytes_sent() const { return bytes_sent_; }
+
+    private:
+        struct envelope {
+            uint32_t to;
+            std::vector<uint8_t> bytes;
+        };
+
+        void deliver() {
+            while (!queue_.empty()) {
+                envelope e = std::move(queue_.front());
+                queue_.pop_front();
+                gossip_message msg;
+                if (serializer_.deserialize(e.bytes, msg) == serialization_error::success && e.to < cores_.size()) {
+                    cores_[e.to]->handle_message(msg, clock::now());
+                }
+            }
+        }
+
+        uint32_t n_;
+        json_serializer serializer_;
+        std::vector<std::unique_ptr<gossip_core>> cores_;
+        std::deque<envelope> queue_;
+        std::vector<bool> updated_;// [core * n + member]: core has seen member's change
+        size_t updated_count_ = 0;
+        bool seeding_ = false;
+        bool split_ = false;
+        size_t bytes_sent_ = 0;
+    };
+
+}// namespace
+
+int main() {
+    const std::vector<uint32_t> sizes = {100, 250};
+    const int warmup_rounds = 20;
+    const int split_rounds = 30;
+    const int max_rounds = 2000;
+
+    std::printf("%8s %16s %13s %16s %16s\n", "members", "mode", "anti-entropy", "rounds to heal", "bytes to heal");
+
+    for (uint32_t n: sizes) {
+        for (auto mode: {dissemination_mode::random_entries, dissemination_mode::digest_sync}) {
+            for (bool anti_entropy: {false, true}) {
+                simulated_cluster cluster(n, mode, anti_entropy);
+                for (int r = 0; r < warmup_rounds; ++r) {
+                    cluster.round();
+                }
+
+                cluster.split(true);
+                cluster.update_all();
+                for (int r = 0; r < split_rounds; ++r) {
+                    cluster.round();
+                }
+                cluster.split(false);
+
+                const size_t before = cluster.bytes_sent();
+                int rounds = 0;
+                while (!cluster.converged() && rounds < max_rounds) {
+                    cluster.round();
+                    ++rounds;
+                }
+
+                std::printf("%8u %16s %13s %16s %16zu\n", n,
+                            mode == dissemination_mode::digest_sync ? "digest_sync" : "random_entries",
+                            anti_entropy ? "on" : "off",
+                            rounds < max_rounds ? std::to_string(rounds).c_str() : "n/a",
+                            cluster.bytes_sent() - before);
+                std::fflush(stdout);
+            }
+        }
+    }
+
+    return 0;
+}
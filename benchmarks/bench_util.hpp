@@ -0,0 +1,55 @@
+/**
+ * @file bench_util.hpp
+ * @brief Small helpers shared by the libgossip benchmarks
+ */
+
+#pragma once
+
+#include "core/gossip_core.hpp"
+#include <chrono>
+#include <cstdint>
+#include <string>
+
+namespace libgossip::bench {
+
+    /// Deterministic node ID derived from an index
+    inline node_id_t make_id(uint32_t n) {
+        node_id_t id{};
+        id[0] = 0xbe;
+        id[12] = static_cast<uint8_t>(n >> 24);
+        id[13] = static_cast<uint8_t>(n >> 16);
+        id[14] = static_cast<uint8_t>(n >> 8);
+        id[15] = static_cast<uint8_t>(n);
+        return id;
+    }
+
+    /// Node with a unique 10.x.y.z address and a realistic amount of metadata
+    inline node_view make_node(uint32_t n) {
+        node_view node;
+        node.id = make_id(n);
+        node.ip = "10." + std::to_string((n >> 16) & 0xFF) + "." +
+                  std::to_string((n >> 8) & 0xFF) + "." + std::to_string(n & 0xFF);
+        node.port = 7946;
+        node.heartbeat = 1;
+        node.config_epoch = 1;
+        node.status = node_status::online;
+        node.role = "master";
+        node.region = "us-east-1";
+        node.metadata["slots"] = "0-5460";
+        node.metadata["version"] = "1.4.2";
+        return node;
+    }
+
+    /// Average nanoseconds per call of fn over iterations runs
+    template<typename Fn>
+    double ns_per_op(size_t iterations, Fn &&fn) {
+        auto start = std::chrono::steady_clock::now();
+        for (size_t i = 0; i < iterations; ++i) {
+            fn(i);
+        }
+        auto elapsed = std::chrono::steady_clock::now() - start;
+        return static_cast<double>(std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count()) /
+               static_cast<double>(iterations);
+    }
+
+}// namespace libgossip::bench
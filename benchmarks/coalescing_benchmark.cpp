@@ -0,0 +1,212 @@
+/**
+ * @file coalescing_benchmark.cpp
+ * @brief Datagrams per second saved by merging sends to the same target
+ *
+ * Simulates a cluster of N cores in virtual time: each core ticks every
+ * 100 ms and every datagram arrives 0.5 ms after it is sent. The cores'
+ * ticks are either spread evenly over the interval or aligned (all within
+ * the first millisecond, as with members started by the same scheduler). Each core sends through a
+ * frame_coalescer flushed when its window closes, the way udp_transport
+ * does with a coalesce window; a window of 0 sends every message as its
+ * own datagram. Reported per mode and window are the messages and the
+ * datagrams the cluster sends per second.
+ */
+
+#include "bench_util.hpp"
+#include "net/frame_coalescer.hpp"
+#include "net/json_serializer.hpp"
+#include <cstdio>
+#include <memory>
+#include <queue>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+using namespace libgossip;
+
+namespace {
+
+    using micros = std::chrono::microseconds;
+
+    class simulated_cluster {
+    public:
+        simulated_cluster(uint32_t n, micros window, bool full_broadcast, bool aligned)
+            : window_(window), full_broadcast_(full_broadcast) {
+            gossip_core_options options;
+            options.failure_timeout_ms = 600000;// Virtual time runs ahead of the cores' clock
+
+            for (uint32_t i = 0; i < n; ++i) {
+                node_view self = bench::make_node(i);
+                self.port = 7946;
+                index_[self.ip.str()] = i;
+                coalescers_.emplace_back();
+                cores_.push_back(std::make_unique<gossip_core>(
+                        self,
+                        [this, i](const gossip_message &msg, const node_view &target) { send(i, msg, target); },
+                        nullptr, options));
+            }
+            for (uint32_t i = 1; i < n; ++i) {
+                cores_[i]->meet(cores_[0]->self());
+            }
+            for (uint32_t i = 0; i < n; ++i) {
+                const micros spread = aligned ? micros(1000) : tick_interval;
+                schedule(micros(spread.count() * i / n), event_kind::tick, i);
+            }
+        }
+
+        /// Process every event up to until
+        void run(micros until) {
+            while (!events_.empty() && events_.top().at <= until) {
+                event e = events_.top();
+                events_.pop();
+                now_ = e.at;
+                switch (e.kind) {
+                    case event_kind::tick:
+                        if (full_broadcast_) {
+                            cores_[e.node]->tick_full_broadcast();
+                        } else {
+                            cores_[e.node]->tick();
+                        }
+                        schedule(now_ + tick_interval, event_kind::tick, e.node);
+                        break;
+                    case event_kind::flush:
+                        coalescers_[e.node].flush(emitter(e.node));
+                        break;
+                    case event_kind::arrive:
+                        receive(e.node, payloads_[e.payload]);
+                        payloads_[e.payload].clear();
+                        free_.push_back(e.payload);
+                        break;
+                }
+            }
+            now_ = until;
+        }
+
+        size_t messages() const { return messages_; }
+        size_t datagrams() const { return datagrams_; }
+
+        static constexpr micros tick_interval{100000};
+        static constexpr micros latency{500};
+
+    private:
+        enum class event_kind { tick, flush, arrive };
+
+        struct event {
+            micros at;
+            uint64_t seq;
+            event_kind kind;
+            uint32_t node;
+            size_t payload;
+            bool operator>(const event &other) const { return at != other.at ? at > other.at : seq > other.seq; }
+        };
+
+        void schedule(micros at, event_kind kind, uint32_t node, size_t payload = 0) {
+            events_.push({at, seq_++, kind, node, payload});
+        }
+
+        void send(uint32_t from, const gossip_message &msg, const node_view &target) {
+            std::vector<uint8_t> bytes;
+            serializer_.serialize(msg, bytes);
+            messages_++;
+            if (window_.count() == 0) {
+                std::vector<uint8_t> datagram;
+                net::frame_coalescer::frame(bytes, datagram);
+                emit(target.ip, target.port, datagram);
+            } else if (coalescers_[from].append(target.ip, target.port, bytes, emitter(from))) {
+                schedule(now_ + window_, event_kind::flush, from);
+            }
+        }
+
+        net::frame_coalescer::emit_fn emitter(uint32_t) {
+            return [this](const ip_address &ip, int port, const std::vector<uint8_t> &datagram) { emit(ip, port, datagram); };
+        }
+
+        void emit(const ip_address &ip, int, const std::vector<uint8_t> &datagram) {
+            auto it = index_.find(ip.str());
+            if (it == index_.end()) {
+                return;
+            }
+            datagrams_++;
+            size_t slot;
+            if (free_.empty()) {
+                slot = payloads_.size();
+                payloads_.emplace_back();
+            } else {
+                slot = free_.back();
+                free_.pop_back();
+            }
+            payloads_[slot] = datagram;
+            schedule(now_ + latency, event_kind::arrive, it->second, slot);
+        }
+
+        /// Parse the frames of a datagram as udp_transport's receive loop does
+        void receive(uint32_t to, const std::vector<uint8_t> &datagram) {
+            size_t offset = 0;
+            while (offset + 4 <= datagram.size()) {
+                const uint32_t length = (static_cast<uint32_t>(datagram[offset]) << 24) |
+                                        (static_cast<uint32_t>(datagram[offset + 1]) << 16) |
+                                        (static_cast<uint32_t>(datagram[offset + 2]) << 8) |
+                                        static_cast<uint32_t>(datagram[offset + 3]);
+                offset += 4;
+                if (offset + length > datagram.size()) {
+                    break;
+                }
+                std::vector<uint8_t> bytes(datagram.begin() + static_cast<std::ptrdiff_t>(offset),
+                                           datagram.begin() + static_cast<std::ptrdiff_t>(offset + length));
+                offset += length;
+                gossip_message msg;
+                if (serializer_.deserialize(bytes, msg) == serialization_error::success) {
+                    cores_[to]->handle_message(msg, clock::now());
+                }
+            }
+        }
+
+        micros window_;
+        bool full_broadcast_;
+        micros now_{0};
+        uint64_t seq_ = 0;
+        json_serializer serializer_;
+        std::vector<std::unique_ptr<gossip_core>> cores_;
+        std::vector<net::frame_coalescer> coalescers_;
+        std::unordered_map<std::string, uint32_t> index_;
+        std::priority_queue<event, std::vector<event>, std::greater<event>> events_;
+        std::vector<std::vector<uint8_t>> payloads_;
+        std::vector<size_t> free_;
+        size_t messages_ = 0;
+        size_t datagrams_ = 0;
+    };
+
+}// namespace
+
+int main() {
+    const micros warmup(2000000);
+    const int seconds = 5;
+
+    std::printf("ticks every 100 ms, 0.5 ms latency, %d s measured\n", seconds);
+    std::printf("%-16s %-10s %8s %10s %14s %14s %8s\n", "mode", "ticks", "members", "window", "messages/s",
+                "datagrams/s", "saved");
+
+    for (bool full_broadcast: {false, true}) {
+        for (bool aligned: {false, true}) {
+            // Full broadcast sends N^2 messages per round; keep it to small clusters
+            for (uint32_t members: full_broadcast ? std::vector<uint32_t>{8, 32} : std::vector<uint32_t>{8, 32, 128}) {
+                for (int window_ms: {0, 1, 5, 20}) {
+                    simulated_cluster cluster(members, micros(window_ms * 1000), full_broadcast, aligned);
+                    cluster.run(warmup);
+                    const size_t messages_before = cluster.messages();
+                    const size_t datagrams_before = cluster.datagrams();
+                    cluster.run(warmup + micros(seconds * 1000000));
+
+                    const double messages = static_cast<double>(cluster.messages() - messages_before) / seconds;
+                    const double datagrams = static_cast<double>(cluster.datagrams() - datagrams_before) / seconds;
+                    std::printf("%-16s %-10s %8u %7d ms %14.0f %14.0f %7.1f%%\n",
+                                full_broadcast ? "full_broadcast" : "tick", aligned ? "aligned" : "spread", members,
+                                window_ms, messages, datagrams,
+                                messages > 0 ? 100.0 * (messages - datagrams) / messages : 0.0);
+                    std::fflush(stdout);
+                }
+            }
+        }
+    }
+    return 0;
+}
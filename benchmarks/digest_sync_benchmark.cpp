@@ -0,0 +1,164 @@
+/**
+ * @file digest_sync_benchmark.cpp
+ * @brief Steady-state gossip bytes per round for each dissemination mode
+ *
+ * Simulates a cluster of N cores exchanging JSON-serialized messages in
+ * memory. Every core starts out knowing every member; once the views have
+ * settled, the cluster runs idle (only heartbeats advance) and the bytes,
+ * messages and full node views sent per round are reported. That is the
+ * cost of keeping a stable cluster in sync. The last scenario adds 1 KB of
+ * metadata per member, e.g. a slot map.
+ *
+ * Per-member traffic does not depend on N (each core sends gossip_nodes
+ * pings per round plus the replies), so the total for larger clusters
+ * scales linearly from the per-member figure.
+ */
+
+#include "bench_util.hpp"
+#include "net/json_serializer.hpp"
+#include <cstdio>
+#include <deque>
+#include <memory>
+#include <string>
+#include <vector>
+
+using namespace libgossip;
+
+namespace {
+
+    uint32_t index_of(const node_id_t &id) {
+        return (static_cast<uint32_t>(id[13]) << 16) | (static_cast<uint32_t>(id[14]) << 8) | id[15];
+    }
+
+    const char *mode_name(dissemination_mode mode) {
+        switch (mode) {
+            case dissemination_mode::broadcast_queue:
+                return "broadcast_queue";
+            case dissemination_mode::digest_sync:
+                return "digest_sync";
+            default:
+                return "random_entries";
+        }
+    }
+
+    /// bench::make_node() plus extra_metadata bytes of labels (e.g. a slot map)
+    node_view make_member(uint32_t n, size_t extra_metadata) {
+        node_view node = bench::make_node(n);
+        if (extra_metadata > 0) {
+            node.metadata["labels"] = std::string(extra_metadata, 'x');
+        }
+        return node;
+    }
+
+    class simulated_cluster {
+    public:
+        simulated_cluster(uint32_t n, dissemination_mode mode, size_t extra_metadata) {
+            gossip_core_options options;
+            options.dissemination = mode;
+            options.failure_timeout_ms = 600000;// Rounds run faster than real time
+
+            for (uint32_t i = 0; i < n; ++i) {
+                cores_.push_back(std::make_unique<gossip_core>(
+                        make_member(i, extra_metadata),
+                        [this](const gossip_message &msg, const node_view &target) {
+                            if (seeding_) {
+                                return;
+                            }
+                            std::vector<uint8_t> bytes;
+                            serializer_.serialize(msg, bytes);
+                            bytes_sent_ += bytes.size();
+                            messages_sent_++;
+                            views_sent_ += msg.entries.size();
+                            queue_.push_back({index_of(target.id), std::move(bytes)});
+                        },
+                        nullptr, options));
+            }
+
+            // Full membership up front: the benchmark is about keeping it in sync
+            seeding_ = true;
+            for (uint32_t i = 0; i < n; ++i) {
+                for (uint32_t j = 0; j < n; ++j) {
+                    if (i != j) {
+                        cores_[i]->meet(make_member(j, extra_metadata));
+                    }
+                }
+            }
+            seeding_ = false;
+        }
+
+        /// One heartbeat: every core ticks, then all messages (and replies) are delivered
+        void round() {
+            for (auto &core: cores_) {
+                core->tick();
+            }
+            deliver();
+        }
+
+        size_t bytes_sent() const { return bytes_sent_; }
+        size_t messages_sent() const { return messages_sent_; }
+        size_t views_sent() const { return views_sent_; }
+
+    private:
+        struct envelope {
+            uint32_t to;
+            std::vector<uint8_t> bytes;
+        };
+
+        void deliver() {
+            while (!queue_.empty()) {
+                envelope e = std::move(queue_.front());
+                queue_.pop_front();
+                gossip_message msg;
+                if (serializer_.deserialize(e.bytes, msg) == serialization_error::success && e.to < cores_.size()) {
+                    cores_[e.to]->handle_message(msg, clock::now());
+                }
+            }
+        }
+
+        json_serializer serializer_;
+        std::vector<std::unique_ptr<gossip_core>> cores_;
+        std::deque<envelope> queue_;
+        bool seeding_ = false;
+        size_t bytes_sent_ = 0;
+        size_t messages_sent_ = 0;
+        size_t views_sent_ = 0;
+    };
+
+}// namespace
+
+int main() {
+    struct scenario {
+        uint32_t members;
+        size_t extra_metadata;
+    };
+    const std::vector<scenario> scenarios = {{100, 0}, {500, 0}, {100, 1024}};
+    const int warmup_rounds = 150;
+    const int measured_rounds = 20;
+
+    std::printf("%8s %10s %16s %14s %12s %12s %14s\n", "members", "metadata+", "mode", "bytes/round", "msgs/round",
+                "views/round", "bytes/member");
+
+    for (const auto &s: scenarios) {
+        for (auto mode: {dissemination_mode::random_entries, dissemination_mode::broadcast_queue,
+                         dissemination_mode::digest_sync}) {
+            simulated_cluster cluster(s.members, mode, s.extra_metadata);
+            for (int r = 0; r < warmup_rounds; ++r) {
+                cluster.round();
+            }
+
+            const size_t bytes = cluster.bytes_sent();
+            const size_t messages = cluster.messages_sent();
+            const size_t views = cluster.views_sent();
+            for (int r = 0; r < measured_rounds; ++r) {
+                cluster.round();
+            }
+            const double per_round = static_cast<double>(cluster.bytes_sent() - bytes) / measured_rounds;
+
+            std::printf("%8u %10zu %16s %14.0f %12.0f %12.0f %14.0f\n", s.members, s.extra_metadata, mode_name(mode),
+                        per_round, static_cast<double>(cluster.messages_sent() - messages) / measured_rounds,
+                        static_cast<double>(cluster.views_sent() - views) / measured_rounds, per_round / s.members);
+        }
+    }
+
+    return 0;
+}
@@ -0,0 +1,167 @@
+/**
+ * @file dissemination_benchmark.cpp
+ * @brief Bytes and rounds needed to spread updates, random entries vs broadcast queue
+ *
+ * Simulates a cluster of N cores exchanging JSON-serialized messages in
+ * memory. Once membership has converged and is idle, U members change their
+ * metadata in the same round, and the cluster runs until every member has
+ * seen every change. Reports rounds to convergence, the bytes sent per
+ * converged update, and the idle bytes per round (what the cluster costs
+ * when nothing changes).
+ */
+
+#include "bench_util.hpp"
+#include "net/json_serializer.hpp"
+#include <algorithm>
+#include <cstdio>
+#include <deque>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace libgossip;
+
+namespace {
+
+    uint32_t index_of(const node_id_t &id) {
+        return (static_cast<uint32_t>(id[13]) << 16) | (static_cast<uint32_t>(id[14]) << 8) | id[15];
+    }
+
+    class simulated_cluster {
+    public:
+        simulated_cluster(uint32_t n, dissemination_mode mode) {
+            gossip_core_options options;
+            options.dissemination = mode;
+            options.failure_timeout_ms = 600000;// Rounds run faster than real time
+
+            for (uint32_t i = 0; i < n; ++i) {
+                cores_.push_back(std::make_unique<gossip_core>(
+                        bench::make_node(i),
+                        [this](const gossip_message &msg, const node_view &target) {
+                            std::vector<uint8_t> bytes;
+                            serializer_.serialize(msg, bytes);
+                            bytes_sent_ += bytes.size();
+                            queue_.push_back({index_of(target.id), std::move(bytes)});
+                        },
+                        nullptr, options));
+            }
+            for (uint32_t i = 1; i < n; ++i) {
+                cores_[i]->meet(bench::make_node(0));
+            }
+            deliver();
+        }
+
+        /// One heartbeat: every core ticks, then all messages (and replies) are delivered
+        void round() {
+            for (auto &core: cores_) {
+                core->tick();
+            }
+            deliver();
+        }
+
+        /// Whether every core knows every other member with metadata key = value for members in updated
+        bool converged(const std::vector<uint32_t> &updated, const std::string &value) const {
+            for (uint32_t i = 0; i < cores_.size(); ++i) {
+                if (cores_[i]->size() != cores_.size() - 1) {
+                    return false;
+                }
+                for (uint32_t u: updated) {
+                    if (u == i) {
+                        continue;
+                    }
+                    auto view = cores_[i]->find_node(bench::make_id(u));
+                    auto it = view ? view->metadata.find("epoch") : std::map<std::string, std::string>::const_iterator{};
+                    if (!view || it == view->metadata.end() || it->second != value) {
+                        return false;
+                    }
+                }
+            }
+            return true;
+        }
+
+        void update_metadata(uint32_t member, const std::string &value) {
+            cores_[member]->update_self_metadata({{"epoch", value}});
+        }
+
+        size_t bytes_sent() const { return bytes_sent_; }
+
+    private:
+        struct envelope {
+            uint32_t to;
+            std::vector<uint8_t> bytes;
+        };
+
+        void deliver() {
+            while (!queue_.empty()) {
+                envelope e = std::move(queue_.front());
+                queue_.pop_front();
+                gossip_message msg;
+                if (serializer_.deserialize(e.bytes, msg) == serialization_error::success && e.to < cores_.size()) {
+                    cores_[e.to]->handle_message(msg, clock::now());
+                }
+            }
+        }
+
+        json_serializer serializer_;
+        std::vector<std::unique_ptr<gossip_core>> cores_;
+        std::deque<envelope> queue_;
+        size_t bytes_sent_ = 0;
+    };
+
+}// namespace
+
+int main() {
+    const std::vector<uint32_t> sizes = {32, 128};
+    const uint32_t updates = 8;
+    const int max_rounds = 500;
+
+    std::printf("%8s %16s %8s %18s %16s\n", "members", "mode", "rounds", "bytes/update", "idle bytes/round");
+
+    for (uint32_t n: sizes) {
+        for (auto mode: {dissemination_mode::random_entries, dissemination_mode::broadcast_queue}) {
+            simulated_cluster cluster(n, mode);
+
+            // Converge membership, then let the join broadcasts drain
+            int warmup = 0;
+            while (!cluster.converged({}, "") && warmup < max_rounds) {
+                cluster.round();
+                ++warmup;
+            }
+            for (int r = 0; r < 50; ++r) {
+                cluster.round();
+            }
+
+            size_t before = cluster.bytes_sent();
+            const int idle_rounds = 20;
+            for (int r = 0; r < idle_rounds; ++r) {
+                cluster.round();
+            }
+            const double idle_bytes = static_cast<double>(cluster.bytes_sent() - before) / idle_rounds;
+
+            std::mt19937 rng(n);
+            std::vector<uint32_t> updated;
+            while (updated.size() < updates) {
+                uint32_t member = static_cast<uint32_t>(rng() % n);
+                if (std::find(updated.begin(), updated.end(), member) == updated.end()) {
+                    updated.push_back(member);
+                    cluster.update_metadata(member, "v2");
+                }
+            }
+
+            before = cluster.bytes_sent();
+            int rounds = 0;
+            while (!cluster.converged(updated, "v2") && rounds < max_rounds) {
+                cluster.round();
+                ++rounds;
+            }
+            const double per_update = static_cast<double>(cluster.bytes_sent() - before) / updates;
+
+            std::printf("%8u %16s %8s %18.0f %16.0f\n", n,
+                        mode == dissemination_mode::random_entries ? "random_entries" : "broadcast_queue",
+                        rounds < max_rounds ? std::to_string(rounds).c_str() : "n/a", per_update, idle_bytes);
+        }
+    }
+
+    return 0;
+}
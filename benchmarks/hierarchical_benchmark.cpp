@@ -0,0 +1,192 @@
+/**
+ * @file hierarchical_benchmark.cpp
+ * @brief Per-member state and bandwidth of flat and hierarchical membership
+ *
+ * Simulates N cores in groups (regions) of 64, exchanging JSON-serialized
+ * messages in memory. Both modes bootstrap alike: every member meets the
+ * first member of its group, and the first member of every group meets
+ * member 0. A run converges when every member holds all it is meant to:
+ * the whole cluster (flat), or its group plus a summary of every group
+ * naming the right representative (hierarchical). Then the idle traffic
+ * is measured. Rounds are heartbeats, ten per second at the default
+ * interval. Both modes use adaptive_fanout, so the entries a message
+ * carries grow with ln of the members a core knows: the whole cluster
+ * (flat) or its group (hierarchical).
+ *
+ * Reported per member: the views held (the table dominates a core's
+ * memory, see node_footprint_benchmark), the group summaries held, the
+ * bytes sent until converged, and the bytes sent per second once converged.
+ */
+
+#include "bench_util.hpp"
+#include "net/json_serializer.hpp"
+#include <cstdio>
+#include <deque>
+#include <memory>
+#include <string>
+#include <vector>
+
+using namespace libgossip;
+
+namespace {
+
+    constexpr uint32_t group_size = 64;
+
+    uint32_t index_of(const node_id_t &id) {
+        return (static_cast<uint32_t>(id[13]) << 16) | (static_cast<uint32_t>(id[14]) << 8) | id[15];
+    }
+
+    node_view make_member(uint32_t i) {
+        node_view node = bench::make_node(i);
+        node.region = "region-" + std::to_string(i / group_size);
+        return node;
+    }
+
+    class simulated_cluster {
+    public:
+        simulated_cluster(uint32_t n, bool hierarchical) : n_(n), hierarchical_(hierarchical) {
+            gossip_core_options options;
+            options.failure_timeout_ms = 600000;// Rounds run faster than real time
+            options.max_nodes = 0;
+            options.hierarchical = hierarchical;
+            options.adaptive_fanout = true;
+
+            for (uint32_t i = 0; i < n; ++i) {
+                cores_.push_back(std::make_unique<gossip_core>(
+                        make_member(i),
+                        [this](const gossip_message &msg, const node_view &target) {
+                            std::vector<uint8_t> bytes;
+                            serializer_.serialize(msg, bytes);
+                            bytes_sent_ += bytes.size();
+                            queue_.push_back({index_of(target.id), std::move(bytes)});
+                        },
+                        nullptr, options));
+            }
+            for (uint32_t i = 0; i < n; ++i) {
+                const uint32_t first = i / group_size * group_size;
+                if (i != first) {
+                    cores_[i]->meet(make_member(first));
+                } else if (i != 0) {
+                    cores_[i]->meet(make_member(0));
+                }
+            }
+            deliver();
+        }
+
+        /// One heartbeat: every core ticks, then all messages (and replies) are delivered
+        void round() {
+            for (auto &core: cores_) {
+                core->tick();
+            }
+            deliver();
+        }
+
+        bool converged() const {
+            const uint32_t groups = (n_ + group_size - 1) / group_size;
+            for (uint32_t i = 0; i < n_; ++i) {
+                const gossip_core &core = *cores_[i];
+                if (!hierarchical_) {
+                    if (core.size() != n_ - 1) {
+                        return false;
+                    }
+                    continue;
+                }
+                const uint32_t first = i / group_size * group_size;
+                if (core.size() != std::min(group_size, n_ - first) - 1) {
+                    return false;
+                }
+                const auto summaries = core.get_groups();
+                if (summaries.size() != groups) {
+                    return false;
+                }
+                for (const auto &summary: summaries) {
+                    // The lowest ID of a group is its first member
+                    if (summary.term == 0 || index_of(summary.representative.id) % group_size != 0) {
+                        return false;
+                    }
+                }
+            }
+            return true;
+        }
+
+        size_t bytes_sent() const { return bytes_sent_; }
+
+        double views_per_member() const {
+            size_t total = 0;
+            for (const auto &core: cores_) {
+                total += core->size();
+            }
+            return static_cast<double>(total) / n_;
+        }
+
+        double summaries_per_member() const {
+            size_t total = 0;
+            for (const auto &core: cores_) {
+                total += core->get_stats().groups;
+            }
+            return static_cast<double>(total) / n_;
+        }
+
+    private:
+        struct envelope {
+            uint32_t to;
+            std::vector<uint8_t> bytes;
+        };
+
+        void deliver() {
+            while (!queue_.empty()) {
+                envelope e = std::move(queue_.front());
+                queue_.pop_front();
+                gossip_message msg;
+                if (serializer_.deserialize(e.bytes, msg) == serialization_error::success && e.to < cores_.size()) {
+                    cores_[e.to]->handle_message(msg, clock::now());
+                }
+            }
+        }
+
+        uint32_t n_;
+        bool hierarchical_;
+        json_serializer serializer_;
+        std::vector<std::unique_ptr<gossip_core>> cores_;
+        std::deque<envelope> queue_;
+        size_t bytes_sent_ = 0;
+    };
+
+}// namespace
+
+int main() {
+    const std::vector<uint32_t> sizes = {256, 512};
+    const int idle_rounds = 10;
+    const int max_rounds = 200;
+    const double rounds_per_second = 1000.0 / config::DEFAULT_HEARTBEAT_INTERVAL_MS;
+
+    std::printf("groups of %u members, %.0f rounds per second\n", group_size, rounds_per_second);
+    std::printf("%8s %14s %8s %14s %18s %18s %18s\n", "members", "mode", "rounds", "views/member",
+                "summaries/member", "KB/member (join)", "idle B/s/member");
+
+    for (uint32_t n: sizes) {
+        for (bool hierarchical: {false, true}) {
+            simulated_cluster cluster(n, hierarchical);
+            int rounds = 0;
+            while (!cluster.converged() && rounds < max_rounds) {
+                cluster.round();
+                ++rounds;
+            }
+
+            const double join = static_cast<double>(cluster.bytes_sent()) / 1024 / n;
+            const size_t before = cluster.bytes_sent();
+            for (int r = 0; r < idle_rounds; ++r) {
+                cluster.round();
+            }
+            const double idle = static_cast<double>(cluster.bytes_sent() - before) / idle_rounds *
+                                rounds_per_second / n;
+
+            std::printf("%8u %14s %8s %14.0f %18.1f %18.1f %18.0f\n", n, hierarchical ? "hierarchical" : "flat",
+                        rounds < max_rounds ? std::to_string(rounds).c_str() : "n/a", cluster.views_per_member(),
+                        cluster.summaries_per_member(), join, idle);
+            std::fflush(stdout);
+        }
+    }
+
+    return 0;
+}
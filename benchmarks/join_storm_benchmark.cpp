@@ -0,0 +1,122 @@
+/**
+ * @file join_storm_benchmark.cpp
+ * @brief Event callbacks made while 1000 nodes join within 20 ticks
+ *
+ * One gossip_core watches a join storm: each tick, 50 new nodes ping it as
+ * joining, and 300 pings from already joined nodes carry their sender plus
+ * three random joined members, online, with advancing heartbeats and a
+ * metadata change every fifth tick. Reported per delivery mode are the
+ * events queued by the core, the callbacks made and the changes handed to
+ * them:
+ *
+ *   per_event     event callback, one call per event
+ *   per_message   batch callback, after_unlock: one call per handle_message
+ *   per_tick      batch callback, manual + dispatch_events() after tick()
+ */
+
+#include "bench_util.hpp"
+#include <cstdio>
+#include <vector>
+
+using namespace libgossip;
+
+namespace {
+
+    enum class mode { per_event, per_message, per_tick };
+
+    const char *mode_name(mode m) {
+        switch (m) {
+            case mode::per_event:
+                return "per_event";
+            case mode::per_message:
+                return "per_message";
+            default:
+                return "per_tick";
+        }
+    }
+
+    struct result {
+        size_t events;
+        size_t callbacks;
+        size_t changes;
+        double ms;
+    };
+
+    node_view member(uint32_t n, uint32_t tick, node_status status) {
+        node_view node = bench::make_node(n);
+        node.status = status;
+        node.heartbeat = tick + 1;
+        node.metadata["slots"] = std::to_string(tick / 5);
+        return node;
+    }
+
+    result run(uint32_t joiners, uint32_t ticks, mode m) {
+        gossip_core_options options;
+        options.event_overflow = event_overflow_policy::grow;
+        options.delivery = m == mode::per_tick ? event_delivery::manual : event_delivery::after_unlock;
+
+        result r{0, 0, 0, 0};
+        gossip_core core(
+                bench::make_node(joiners), [](const gossip_message &, const node_view &) {},
+                [&r](const node_view &, node_status) {
+                    r.callbacks++;
+                    r.changes++;
+                },
+                options);
+        if (m != mode::per_event) {
+            core.set_batch_event_callback([&r](const std::vector<membership_change> &changes) {
+                r.callbacks++;
+                r.changes += changes.size();
+            });
+        }
+
+        xoshiro256ss rng(7);
+        const uint32_t per_tick = joiners / ticks;
+        uint32_t joined = 0;
+        const auto start = std::chrono::steady_clock::now();
+        for (uint32_t tick = 0; tick < ticks; ++tick) {
+            for (uint32_t i = 0; i < per_tick; ++i, ++joined) {
+                gossip_message ping;
+                ping.sender = bench::make_id(joined);
+                ping.type = message_type::ping;
+                ping.timestamp = tick + 1;
+                ping.entries.push_back(member(joined, tick, node_status::joining));
+                core.handle_message(ping, clock::now());
+            }
+            for (int i = 0; i < 300; ++i) {
+                gossip_message ping;
+                const uint32_t sender = static_cast<uint32_t>(rng.uniform(joined));
+                ping.sender = bench::make_id(sender);
+                ping.type = message_type::ping;
+                ping.timestamp = tick + 1;
+                ping.entries.push_back(member(sender, tick, node_status::online));
+                for (int e = 0; e < 3; ++e) {
+                    ping.entries.push_back(member(static_cast<uint32_t>(rng.uniform(joined)), tick, node_status::online));
+                }
+                core.handle_message(ping, clock::now());
+            }
+            core.tick();
+            if (m == mode::per_tick) {
+                core.dispatch_events();
+            }
+        }
+        r.ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+        r.events = core.get_stats().events_delivered;
+        return r;
+    }
+
+}// namespace
+
+int main() {
+    const uint32_t joiners = 1000;
+    const uint32_t ticks = 20;
+
+    std::printf("%u nodes joining over %u ticks\n", joiners, ticks);
+    std::printf("%12s %10s %10s %10s %10s\n", "mode", "events", "callbacks", "changes", "ms");
+    for (auto m: {mode::per_event, mode::per_message, mode::per_tick}) {
+        result r = run(joiners, ticks, m);
+        std::printf("%12s %10zu %10zu %10zu %10.1f\n", mode_name(m), r.events, r.callbacks, r.changes, r.ms);
+        std::fflush(stdout);
+    }
+    return 0;
+}
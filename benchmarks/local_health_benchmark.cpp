@@ -0,0 +1,162 @@
+/**
+ * @file local_health_benchmark.cpp
+ * @brief False suspicions raised by a core whose process stalls, with and without local health
+ *
+ * Runs N cores in real time on one thread, ticking every 20 ms with a
+ * 300 ms failure timeout. Messages are delivered in memory, stamped with
+ * the time they were sent. One victim core is stalled every second for a
+ * while, as a CPU-starved or GC-paused host would be: it neither ticks
+ * nor handles messages, which pile up in its mailbox. When the stall ends
+ * its tick runs before the backlog is drained, the way a tick thread
+ * wakes up while the IO thread is still behind.
+ *
+ * Every member is alive throughout, so every suspicion the victim raises
+ * is false. Also reported are the suspicions the other members raise
+ * about the victim, which did go quiet, and the victim's highest local
+ * health score.
+ */
+
+#include "bench_util.hpp"
+#include <algorithm>
+#include <cstdio>
+#include <deque>
+#include <memory>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+using namespace libgossip;
+
+namespace {
+
+    using steady = std::chrono::steady_clock;
+
+    struct result {
+        size_t false_suspects = 0;// Raised by the victim
+        size_t victim_suspected = 0;
+        uint32_t victim_peak_health = 0;
+    };
+
+    class realtime_cluster {
+    public:
+        realtime_cluster(uint32_t n, int indirect_probes, uint32_t local_health_max) : mailboxes_(n) {
+            gossip_core_options options;
+            options.heartbeat_interval_ms = tick_interval.count();
+            options.failure_timeout_ms = 300;
+            options.indirect_probes = indirect_probes;
+            options.indirect_probe_timeout_ms = 50;
+            options.local_health_max = local_health_max;
+
+            for (uint32_t i = 0; i < n; ++i) {
+                node_view self = bench::make_node(i);
+                index_[self.ip.str()] = i;
+                cores_.push_back(std::make_unique<gossip_core>(
+                        self,
+                        [this](const gossip_message &msg, const node_view &target) {
+                            auto it = index_.find(target.ip.str());
+                            if (it != index_.end()) {
+                                mailboxes_[it->second].push_back({msg, steady::now()});
+                            }
+                        },
+                        [this, i](const node_view &node, node_status old_status) {
+                            if (node.status != node_status::suspect || old_status == node_status::suspect) {
+                                return;
+                            }
+                            if (i == victim) {
+                                result_.false_suspects++;
+                            } else if (node.id == cores_[victim]->self().id) {
+                                result_.victim_suspected++;
+                            }
+                        },
+                        options));
+            }
+            for (uint32_t i = 0; i < n; ++i) {
+                for (uint32_t j = 0; j < n; ++j) {
+                    if (i != j) {
+                        cores_[i]->meet(cores_[j]->self());
+                    }
+                }
+            }
+        }
+
+        result run(std::chrono::milliseconds duration, std::chrono::milliseconds stall) {
+            const auto start = steady::now();
+            std::vector<steady::time_point> next_tick(cores_.size());
+            for (size_t i = 0; i < cores_.size(); ++i) {
+                next_tick[i] = start + tick_interval * i / cores_.size();
+            }
+            auto next_stall = start + stall_every;
+            steady::time_point stalled_until{};
+
+            while (steady::now() - start < duration) {
+                const auto now = steady::now();
+                if (stall.count() > 0 && now >= next_stall) {
+                    stalled_until = now + stall;
+                    next_stall += stall_every;
+                }
+                for (uint32_t i = 0; i < cores_.size(); ++i) {
+                    if (i == victim && now < stalled_until) {
+                        continue;
+                    }
+                    // Tick before draining: after a stall the backlog is handled late
+                    if (now >= next_tick[i]) {
+                        cores_[i]->tick();
+                        if (i == victim) {
+                            result_.victim_peak_health =
+                                    std::max(result_.victim_peak_health, cores_[i]->get_stats().local_health);
+                        }
+                        next_tick[i] = std::max(next_tick[i] + tick_interval, now);
+                    }
+                    auto &mailbox = mailboxes_[i];
+                    while (!mailbox.empty()) {
+                        letter l = std::move(mailbox.front());
+                        mailbox.pop_front();
+                        cores_[i]->handle_message(l.msg, l.sent);
+                    }
+                }
+                std::this_thread::sleep_for(std::chrono::microseconds(500));
+            }
+            return result_;
+        }
+
+        static constexpr std::chrono::milliseconds tick_interval{20};
+        static constexpr std::chrono::milliseconds stall_every{1000};
+        static constexpr uint32_t victim = 0;
+
+    private:
+        struct letter {
+            gossip_message msg;
+            steady::time_point sent;
+        };
+
+        std::vector<std::unique_ptr<gossip_core>> cores_;
+        std::vector<std::deque<letter>> mailboxes_;
+        std::unordered_map<std::string, uint32_t> index_;
+        result result_;
+    };
+
+}// namespace
+
+int main() {
+    const uint32_t members = 16;
+    const std::chrono::milliseconds duration(4000);
+
+    std::printf("%u members, 20 ms ticks, 300 ms failure timeout, member 0 stalled every 1000 ms, %lld ms per run\n",
+                members, static_cast<long long>(duration.count()));
+    std::printf("%16s %10s %14s %14s %18s %14s\n", "indirect probes", "stall", "local health", "false suspects",
+                "victim suspected", "peak score");
+
+    for (int indirect_probes: {0, 3}) {
+        for (int stall_ms: {0, 100, 250, 500}) {
+            for (uint32_t max_score: {0u, 8u}) {
+                realtime_cluster cluster(members, indirect_probes, max_score);
+                const result r = cluster.run(duration, std::chrono::milliseconds(stall_ms));
+                std::printf("%16d %7d ms %14s %14zu %18zu %14u\n", indirect_probes, stall_ms,
+                            max_score == 0 ? "off" : "max 8", r.false_suspects, r.victim_suspected, r.victim_peak_health);
+                std::fflush(stdout);
+            }
+        }
+    }
+    return 0;
+}
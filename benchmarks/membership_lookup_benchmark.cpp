@@ -0,0 +1,75 @@
+/**
+ * @file membership_lookup_benchmark.cpp
+ * @brief Cost of node lookups and message handling as the membership grows
+ *
+ * Populates a gossip_core with 100 .. 100k members and measures:
+ * - find_node() on a known ID
+ * - handle_message() for a pong from a known sender carrying 3 known entries
+ *   (receive path only, no reply is generated)
+ * - handle_message() for a ping, which additionally builds a pong reply
+ *
+ * With the hash-indexed membership table the ID lookups are O(1), so the
+ * find_node column must stay flat across sizes.
+ */
+
+#include "bench_util.hpp"
+#include <cstdio>
+#include <vector>
+
+using namespace libgossip;
+
+int main() {
+    const std::vector<uint32_t> sizes = {100, 1000, 10000, 100000};
+
+    std::printf("%10s %16s %18s %18s\n", "members", "find_node ns", "handle(pong) ns", "handle(ping) ns");
+
+    for (uint32_t n: sizes) {
+        node_view self = bench::make_node(0xFFFFFF);
+        gossip_core_options options;
+        options.max_nodes = 0;// Past config::DEFAULT_MAX_NODES
+        gossip_core core(self, [](const gossip_message &, const node_view &) {}, nullptr, options);
+
+        for (uint32_t i = 0; i < n; ++i) {
+            core.meet(bench::make_node(i));
+        }
+
+        const size_t iterations = 20000;
+        double find_ns = bench::ns_per_op(iterations, [&](size_t i) {
+            auto found = core.find_node(bench::make_id(static_cast<uint32_t>(i % n)));
+            if (!found) {
+                std::abort();
+            }
+        });
+
+        // Every message comes from a known member and gossips about two others
+        std::vector<gossip_message> messages(64);
+        for (size_t m = 0; m < messages.size(); ++m) {
+            auto sender_index = static_cast<uint32_t>((m * 7919) % n);
+            gossip_message &msg = messages[m];
+            msg.sender = bench::make_id(sender_index);
+            msg.timestamp = 2;
+            msg.entries.push_back(bench::make_node(sender_index));
+            msg.entries.push_back(bench::make_node(static_cast<uint32_t>((m * 104729) % n)));
+            msg.entries.push_back(bench::make_node(static_cast<uint32_t>((m * 1299709) % n)));
+        }
+
+        auto now = clock::now();
+        for (auto &msg: messages) {
+            msg.type = message_type::pong;
+        }
+        double pong_ns = bench::ns_per_op(iterations / 10, [&](size_t i) {
+            core.handle_message(messages[i % messages.size()], now);
+        });
+
+        for (auto &msg: messages) {
+            msg.type = message_type::ping;
+        }
+        double ping_ns = bench::ns_per_op(iterations / 100, [&](size_t i) {
+            core.handle_message(messages[i % messages.size()], now);
+        });
+
+        std::printf("%10u %16.1f %18.1f %18.1f\n", n, find_ns, pong_ns, ping_ns);
+    }
+
+    return 0;
+}
@@ -0,0 +1,167 @@
+/**
+ * @file metadata_delta_benchmark.cpp
+ * @brief Gossip bytes with a 200-key metadata map, one key changing every second
+ *
+ * Simulates a cluster of N cores exchanging JSON-serialized messages in
+ * memory, ten rounds (heartbeats) per simulated second. Every member
+ * carries 200 metadata keys of about 40 bytes each; one member rewrites one
+ * of its keys every second. Reported per metadata_delta_window are the
+ * bytes sent per second, the metadata bytes among them (keys and values of
+ * all gossiped entries), the full views fetched after a delta gap and
+ * whether every member holds the latest value at the end of each second.
+ *
+ * A window of 0 gossips full maps, the behaviour before metadata deltas.
+ */
+
+#include "bench_util.hpp"
+#include "net/json_serializer.hpp"
+#include <cstdio>
+#include <deque>
+#include <memory>
+#include <string>
+#include <vector>
+
+using namespace libgossip;
+
+namespace {
+
+    uint32_t index_of(const node_id_t &id) {
+        return (static_cast<uint32_t>(id[13]) << 16) | (static_cast<uint32_t>(id[14]) << 8) | id[15];
+    }
+
+    std::string key_name(uint32_t k) {
+        char name[16];
+        std::snprintf(name, sizeof(name), "key-%03u", k);
+        return name;
+    }
+
+    class simulated_cluster {
+    public:
+        simulated_cluster(uint32_t n, uint32_t keys, uint32_t window) {
+            gossip_core_options options;
+            options.failure_timeout_ms = 600000;// Rounds run faster than real time
+            options.metadata_delta_window = window;
+
+            for (uint32_t i = 0; i < n; ++i) {
+                node_view self = bench::make_node(i);
+                for (uint32_t k = 0; k < keys; ++k) {
+                    self.metadata[key_name(k)] = "value-0000000000000000000000000";
+                }
+                cores_.push_back(std::make_unique<gossip_core>(
+                        self,
+                        [this](const gossip_message &msg, const node_view &target) {
+                            std::vector<uint8_t> bytes;
+                            serializer_.serialize(msg, bytes);
+                            bytes_sent_ += bytes.size();
+                            for (const auto &entry: msg.entries) {
+                                metadata_sent_ += metadata_bytes(entry.metadata);
+                            }
+                            queue_.push_back({index_of(target.id), std::move(bytes)});
+                        },
+                        nullptr, options));
+            }
+            for (uint32_t i = 1; i < n; ++i) {
+                cores_[i]->meet(cores_[0]->self());
+            }
+            deliver();
+        }
+
+        /// One heartbeat: every core ticks, then all messages (and replies) are delivered
+        void round() {
+            for (auto &core: cores_) {
+                core->tick();
+            }
+            deliver();
+        }
+
+        void update(uint32_t member, const std::string &key, const std::string &value) {
+            cores_[member]->update_self_metadata({{key, value}});
+        }
+
+        /// Whether every other core holds member's metadata as it is now
+        bool converged(uint32_t member) const {
+            const auto &metadata = cores_[member]->self().metadata;
+            for (uint32_t i = 0; i < cores_.size(); ++i) {
+                if (i == member) {
+                    continue;
+                }
+                auto view = cores_[i]->find_node(cores_[member]->self().id);
+                if (!view || view->metadata != metadata) {
+                    return false;
+                }
+            }
+            return true;
+        }
+
+        size_t requests() const {
+            size_t total = 0;
+            for (const auto &core: cores_) {
+                total += core->get_stats().metadata_requests;
+            }
+            return total;
+        }
+
+        size_t bytes_sent() const { return bytes_sent_; }
+        size_t metadata_sent() const { return metadata_sent_; }
+
+    private:
+        struct envelope {
+            uint32_t to;
+            std::vector<uint8_t> bytes;
+        };
+
+        void deliver() {
+            while (!queue_.empty()) {
+                envelope e = std::move(queue_.front());
+                queue_.pop_front();
+                gossip_message msg;
+                if (serializer_.deserialize(e.bytes, msg) == serialization_error::success && e.to < cores_.size()) {
+                    cores_[e.to]->handle_message(msg, clock::now());
+                }
+            }
+        }
+
+        json_serializer serializer_;
+        std::vector<std::unique_ptr<gossip_core>> cores_;
+        std::deque<envelope> queue_;
+        size_t bytes_sent_ = 0;
+        size_t metadata_sent_ = 0;
+    };
+
+}// namespace
+
+int main() {
+    const uint32_t members = 16;
+    const uint32_t keys = 200;
+    const int rounds_per_second = 10;
+    const int seconds = 30;
+
+    std::printf("%u members, %u keys each, one key of member 0 changes every second\n", members, keys);
+    std::printf("%8s %14s %16s %10s %12s\n", "window", "bytes/s", "metadata B/s", "requests", "converged");
+
+    for (uint32_t window: {0u, config::DEFAULT_METADATA_DELTA_WINDOW}) {
+        simulated_cluster cluster(members, keys, window);
+        for (int r = 0; r < 5 * rounds_per_second; ++r) {
+            cluster.round();
+        }
+
+        const size_t bytes_before = cluster.bytes_sent();
+        const size_t metadata_before = cluster.metadata_sent();
+        const size_t requests_before = cluster.requests();
+        int converged = 0;
+        for (int s = 0; s < seconds; ++s) {
+            cluster.update(0, key_name(static_cast<uint32_t>(s) % keys), "value-" + std::to_string(s + 1));
+            for (int r = 0; r < rounds_per_second; ++r) {
+                cluster.round();
+            }
+            converged += cluster.converged(0) ? 1 : 0;
+        }
+
+        std::printf("%8u %14.0f %16.0f %10zu %9d/%d\n", window,
+                    static_cast<double>(cluster.bytes_sent() - bytes_before) / seconds,
+                    static_cast<double>(cluster.metadata_sent() - metadata_before) / seconds,
+                    cluster.requests() - requests_before, converged, seconds);
+        std::fflush(stdout);
+    }
+    return 0;
+}
@@ -0,0 +1,100 @@
+/**
+ * @file node_footprint_benchmark.cpp
+ * @brief Bytes per node and copy cost of node_view
+ *
+ * Builds 10k node_views the way a real cluster looks: IPv4 and IPv6
+ * addresses, two roles, five regions, with and without two metadata
+ * entries. Reported are sizeof(node_view), the heap bytes each node owns
+ * (live bytes, counted through a replaced operator new) and the time to copy all of
+ * them, which is what get_nodes(), message building and events pay.
+ */
+
+#include "bench_util.hpp"
+#include <cstdio>
+#include <cstddef>
+#include <cstdlib>
+#include <new>
+#include <vector>
+
+namespace {
+    size_t heap_bytes = 0;// Live bytes
+    constexpr size_t header = alignof(std::max_align_t);
+}// namespace
+
+void *operator new(std::size_t size) {
+    auto *p = static_cast<unsigned char *>(std::malloc(size + header));
+    if (!p) {
+        throw std::bad_alloc();
+    }
+    *reinterpret_cast<std::size_t *>(p) = size;
+    heap_bytes += size;
+    return p + header;
+}
+
+void operator delete(void *p) noexcept {
+    if (p) {
+        auto *block = static_cast<unsigned char *>(p) - header;
+        heap_bytes -= *reinterpret_cast<std::size_t *>(block);
+        std::free(block);
+    }
+}
+
+void operator delete(void *p, std::size_t) noexcept {
+    operator delete(p);
+}
+
+using namespace libgossip;
+
+namespace {
+
+    const char *const regions[] = {"us-east-1", "us-west-2", "eu-central-1", "ap-southeast-2", "sa-east-1"};
+
+    node_view make_member(uint32_t n, bool with_metadata) {
+        node_view node;
+        node.id = bench::make_id(n);
+        if (n % 2 == 0) {
+            node.ip = "10." + std::to_string((n >> 16) & 0xFF) + "." + std::to_string((n >> 8) & 0xFF) + "." +
+                      std::to_string(n & 0xFF);
+        } else {
+            char ip[64];
+            std::snprintf(ip, sizeof(ip), "2001:db8:85a3:%x::8a2e:%x", (n >> 16) & 0xFFFF, n & 0xFFFF);
+            node.ip = std::string(ip);
+        }
+        node.port = 7946;
+        node.role = n % 3 == 0 ? "master" : "replica";
+        node.region = regions[n % 5];
+        if (with_metadata) {
+            node.metadata["slots"] = "0-5460";
+            node.metadata["version"] = "1.4.2";
+        }
+        return node;
+    }
+
+}// namespace
+
+int main() {
+    const uint32_t count = 10000;
+
+    std::printf("sizeof(node_view): %zu\n", sizeof(node_view));
+    std::printf("%10s %16s %16s %16s\n", "metadata", "bytes/node", "heap bytes/node", "copy ns/node");
+    for (bool with_metadata: {false, true}) {
+        const size_t heap_before = heap_bytes;
+        std::vector<node_view> nodes;
+        nodes.reserve(count);
+        for (uint32_t n = 0; n < count; ++n) {
+            nodes.push_back(make_member(n, with_metadata));
+        }
+        // Only what the nodes own: the vector itself is sizeof(node_view) per node
+        const double heap_per_node =
+                static_cast<double>(heap_bytes - heap_before - count * sizeof(node_view)) / count;
+
+        std::vector<node_view> copy;
+        copy.reserve(count);
+        const double copy_ns = bench::ns_per_op(count, [&](size_t i) { copy.push_back(nodes[i]); });
+
+        std::printf("%10s %16.1f %16.1f %16.1f\n", with_metadata ? "2 entries" : "none",
+                    sizeof(node_view) + heap_per_node, heap_per_node, copy_ns);
+        std::fflush(stdout);
+    }
+    return 0;
+}
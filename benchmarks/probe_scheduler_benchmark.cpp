@@ -0,0 +1,102 @@
+/**
+ * @file probe_scheduler_benchmark.cpp
+ * @brief Time to first probe of a failed member, random vs round-robin
+ *
+ * Runs one gossip_core with N members for about 20 * N / k ticks and
+ * records which members are pinged on each tick. For sampled (member,
+ * failure tick) pairs it measures how many ticks pass until that member
+ * is probed next, i.e. how long a failure goes unnoticed by this node.
+ *
+ * Random selection has a geometric tail (unbounded worst case), while
+ * round-robin bounds the wait by two rounds of ceil(N / k) ticks.
+ */
+
+#include "bench_util.hpp"
+#include <algorithm>
+#include <cstdio>
+#include <random>
+#include <vector>
+
+using namespace libgossip;
+
+namespace {
+
+    struct probe_log {
+        std::vector<std::vector<uint32_t>> ticks_by_member;
+    };
+
+    probe_log record_probes(uint32_t n, probe_scheduler scheduler, int ticks) {
+        gossip_core_options options;
+        options.scheduler = scheduler;
+        options.max_nodes = 0;// Past config::DEFAULT_MAX_NODES
+
+        probe_log log;
+        log.ticks_by_member.resize(n);
+        int current_tick = 0;
+
+        node_view self = bench::make_node(0xFFFFFF);
+        gossip_core core(
+                self,
+                [&](const gossip_message &msg, const node_view &target) {
+                    if (msg.type == message_type::ping) {
+                        // Members are identified by the low bytes of their ID
+                        uint32_t index = (static_cast<uint32_t>(target.id[13]) << 16) |
+                                         (static_cast<uint32_t>(target.id[14]) << 8) | target.id[15];
+                        log.ticks_by_member[index].push_back(static_cast<uint32_t>(current_tick));
+                    }
+                },
+                nullptr, options);
+
+        for (uint32_t i = 0; i < n; ++i) {
+            core.meet(bench::make_node(i));
+        }
+        for (current_tick = 0; current_tick < ticks; ++current_tick) {
+            core.tick();
+        }
+        return log;
+    }
+
+    double percentile(std::vector<uint32_t> &values, double p) {
+        size_t index = static_cast<size_t>(p * static_cast<double>(values.size() - 1));
+        std::nth_element(values.begin(), values.begin() + static_cast<std::ptrdiff_t>(index), values.end());
+        return values[index];
+    }
+
+}// namespace
+
+int main() {
+    const std::vector<uint32_t> sizes = {100, 1000, 10000};
+    const int k = config::DEFAULT_GOSSIP_NODES;
+
+    std::printf("%8s %12s %8s %8s %8s %8s %10s\n", "members", "scheduler", "p50", "p90", "p99", "max",
+                "ceil(N/k)");
+
+    for (uint32_t n: sizes) {
+        const int round_ticks = static_cast<int>((n + k - 1) / k);
+        const int ticks = 20 * round_ticks;
+
+        for (auto scheduler: {probe_scheduler::random, probe_scheduler::round_robin}) {
+            probe_log log = record_probes(n, scheduler, ticks);
+
+            // A member fails at a random tick in the first half of the run;
+            // the wait is the number of ticks until its next probe
+            std::mt19937 rng(7);
+            std::vector<uint32_t> waits;
+            for (int sample = 0; sample < 100000; ++sample) {
+                uint32_t member = static_cast<uint32_t>(rng() % n);
+                uint32_t failed_at = static_cast<uint32_t>(rng() % static_cast<uint32_t>(ticks / 2));
+                const auto &probes = log.ticks_by_member[member];
+                auto next = std::lower_bound(probes.begin(), probes.end(), failed_at);
+                waits.push_back(next == probes.end() ? static_cast<uint32_t>(ticks) - failed_at
+                                                     : *next - failed_at);
+            }
+
+            std::printf("%8u %12s %8.0f %8.0f %8.0f %8.0f %10d\n", n,
+                        scheduler == probe_scheduler::random ? "random" : "round_robin",
+                        percentile(waits, 0.5), percentile(waits, 0.9), percentile(waits, 0.99),
+                        static_cast<double>(*std::max_element(waits.begin(), waits.end())), round_ticks);
+        }
+    }
+
+    return 0;
+}
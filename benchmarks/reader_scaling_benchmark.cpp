@@ -0,0 +1,126 @@
+/**
+ * @file reader_scaling_benchmark.cpp
+ * @brief Membership queries from 1-32 threads against an active receive loop
+ *
+ * One writer thread drives a 1000-member gossip_core the way an IO thread
+ * does: a stream of pings carrying two entries each, plus a tick every 100
+ * messages. Meanwhile N reader threads look up random members. Reported are
+ * the readers' total lookups per second and the writer's messages per
+ * second, for three reader paths:
+ *
+ *   snapshot    core.snapshot()->find(id): one atomic load, no copy
+ *   find_node   core.find_node(id): lock-free, copies the node_view
+ *   locked      core.suspicion_level(id): still takes the core's mutex,
+ *               i.e. what every query cost before snapshots
+ */
+
+#include "bench_util.hpp"
+#include <atomic>
+#include <cstdio>
+#include <thread>
+#include <vector>
+
+using namespace libgossip;
+
+namespace {
+
+    enum class reader_path { snapshot, find_node, locked };
+
+    const char *path_name(reader_path path) {
+        switch (path) {
+            case reader_path::snapshot:
+                return "snapshot";
+            case reader_path::find_node:
+                return "find_node";
+            default:
+                return "locked";
+        }
+    }
+
+    struct result {
+        double lookups_per_sec;
+        double messages_per_sec;
+    };
+
+    result run(uint32_t members, int readers, reader_path path, std::chrono::milliseconds duration) {
+        gossip_core core(bench::make_node(members), [](const gossip_message &, const node_view &) {}, nullptr);
+        for (uint32_t n = 0; n < members; ++n) {
+            core.meet(bench::make_node(n));
+        }
+
+        std::atomic<bool> stop{false};
+        std::atomic<size_t> lookups{0};
+        std::vector<std::thread> threads;
+        for (int t = 0; t < readers; ++t) {
+            threads.emplace_back([&, t] {
+                xoshiro256ss rng(static_cast<uint64_t>(t) + 1);
+                size_t local = 0;
+                size_t found = 0;
+                while (!stop.load(std::memory_order_relaxed)) {
+                    const node_id_t id = bench::make_id(rng.uniform(members));
+                    switch (path) {
+                        case reader_path::snapshot:
+                            found += core.snapshot()->find(id) != nullptr;
+                            break;
+                        case reader_path::find_node:
+                            found += core.find_node(id).has_value();
+                            break;
+                        case reader_path::locked:
+                            found += core.suspicion_level(id).has_value();
+                            break;
+                    }
+                    ++local;
+                }
+                lookups += local + (found == 0);// Keep the lookups observable
+            });
+        }
+
+        // Writer: the receive loop
+        xoshiro256ss rng(42);
+        size_t messages = 0;
+        const auto start = std::chrono::steady_clock::now();
+        auto elapsed = std::chrono::steady_clock::duration::zero();
+        while (elapsed < duration) {
+            for (int i = 0; i < 100; ++i) {
+                node_view sender = bench::make_node(rng.uniform(members));
+                sender.heartbeat = messages + 2;
+                gossip_message ping;
+                ping.sender = sender.id;
+                ping.type = message_type::ping;
+                ping.timestamp = sender.heartbeat;
+                ping.entries.push_back(sender);
+                ping.entries.push_back(bench::make_node(rng.uniform(members)));
+                core.handle_message(ping, clock::now());
+                ++messages;
+            }
+            core.tick();
+            elapsed = std::chrono::steady_clock::now() - start;
+        }
+        stop = true;
+        for (auto &thread: threads) {
+            thread.join();
+        }
+
+        const double seconds = std::chrono::duration<double>(elapsed).count();
+        return {static_cast<double>(lookups.load()) / seconds, static_cast<double>(messages) / seconds};
+    }
+
+}// namespace
+
+int main() {
+    const uint32_t members = 1000;
+    const auto duration = std::chrono::milliseconds(300);
+
+    std::printf("hardware threads: %u\n", std::thread::hardware_concurrency());
+    std::printf("%8s %10s %16s %16s\n", "readers", "path", "lookups/s", "writer msgs/s");
+
+    for (int readers: {1, 2, 4, 8, 16, 32}) {
+        for (auto path: {reader_path::snapshot, reader_path::find_node, reader_path::locked}) {
+            result r = run(members, readers, path, duration);
+            std::printf("%8d %10s %16.0f %16.0f\n", readers, path_name(path), r.lookups_per_sec, r.messages_per_sec);
+            std::fflush(stdout);
+        }
+    }
+
+    return 0;
+}
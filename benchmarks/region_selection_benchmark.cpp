@@ -0,0 +1,203 @@
+/**
+ * @file region_selection_benchmark.cpp
+ * @brief Cross-region bandwidth and convergence time of region-aware peer selection
+ *
+ * Simulates N cores spread evenly over three regions, exchanging
+ * JSON-serialized messages in memory; every core knows every member from
+ * the start. Every byte sent between members of different regions counts
+ * as cross-region (WAN) traffic. After a warmup the idle traffic is
+ * measured, then U members change their metadata in the same round and the
+ * cluster runs until every member has seen every change. Rounds are
+ * heartbeats, so at the default 100 ms interval ten rounds are a second.
+ *
+ * Uniform selection sends about two thirds of the traffic across regions;
+ * region_aware sends cross_region_fraction of the pings (and with them
+ * their replies) to other regions.
+ */
+
+#include "bench_util.hpp"
+#include "net/json_serializer.hpp"
+#include <algorithm>
+#include <cstdio>
+#include <deque>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace libgossip;
+
+namespace {
+
+    const char *const regions[] = {"us-east-1", "eu-west-1", "ap-south-1"};
+
+    uint32_t index_of(const node_id_t &id) {
+        return (static_cast<uint32_t>(id[13]) << 16) | (static_cast<uint32_t>(id[14]) << 8) | id[15];
+    }
+
+    node_view make_member(uint32_t i) {
+        node_view node = bench::make_node(i);
+        node.region = regions[i % 3];
+        return node;
+    }
+
+    struct variant {
+        const char *name;
+        bool region_aware;
+        double cross_region_fraction;
+    };
+
+    class simulated_cluster {
+    public:
+        simulated_cluster(uint32_t n, const variant &v) : n_(n), updated_(static_cast<size_t>(n) * n, false) {
+            gossip_core_options options;
+            options.failure_timeout_ms = 600000;// Rounds run faster than real time
+            options.max_nodes = 0;
+            options.region_aware = v.region_aware;
+            options.cross_region_fraction = v.cross_region_fraction;
+
+            for (uint32_t i = 0; i < n; ++i) {
+                cores_.push_back(std::make_unique<gossip_core>(
+                        make_member(i),
+                        [this, i](const gossip_message &msg, const node_view &target) {
+                            if (seeding_) {
+                                return;
+                            }
+                            std::vector<uint8_t> bytes;
+                            serializer_.serialize(msg, bytes);
+                            const uint32_t to = index_of(target.id);
+                            bytes_sent_ += bytes.size();
+                            if (to % 3 != i % 3) {
+                                cross_region_bytes_ += bytes.size();
+                            }
+                            queue_.push_back({to, std::move(bytes)});
+                        },
+                        [this, i](const node_view &node, node_status) {
+                            auto it = node.metadata.find("epoch");
+                            const size_t cell = static_cast<size_t>(i) * n_ + index_of(node.id);
+                            if (it != node.metadata.end() && it->second == "v2" && !updated_[cell]) {
+                                updated_[cell] = true;
+                                ++updated_count_;
+                            }
+                        },
+                        options));
+            }
+
+            seeding_ = true;
+            for (uint32_t i = 0; i < n; ++i) {
+                for (uint32_t j = 0; j < n; ++j) {
+                    if (i != j) {
+                        cores_[i]->meet(make_member(j));
+                    }
+                }
+            }
+            seeding_ = false;
+        }
+
+        /// One heartbeat: every core ticks, then all messages (and replies) are delivered
+        void round() {
+            for (auto &core: cores_) {
+                core->tick();
+            }
+            deliver();
+        }
+
+        void update_metadata(uint32_t member) {
+            cores_[member]->update_self_metadata({{"epoch", "v2"}});
+        }
+
+        /// Whether every core has seen the change of every member in updated
+        bool converged(size_t updates) const { return updated_count_ == updates * (n_ - 1); }
+
+        size_t bytes_sent() const { return bytes_sent_; }
+        size_t cross_region_bytes() const { return cross_region_bytes_; }
+
+    private:
+        struct envelope {
+            uint32_t to;
+            std::vector<uint8_t> bytes;
+        };
+
+        void deliver() {
+            while (!queue_.empty()) {
+                envelope e = std::move(queue_.front());
+                queue_.pop_front();
+                gossip_message msg;
+                if (serializer_.deserialize(e.bytes, msg) == serialization_error::success && e.to < cores_.size()) {
+                    cores_[e.to]->handle_message(msg, clock::now());
+                }
+            }
+        }
+
+        uint32_t n_;
+        json_serializer serializer_;
+        std::vector<std::unique_ptr<gossip_core>> cores_;
+        std::deque<envelope> queue_;
+        std::vector<bool> updated_;// [core * n + member]: core has seen member's change
+        size_t updated_count_ = 0;
+        bool seeding_ = false;
+        size_t bytes_sent_ = 0;
+        size_t cross_region_bytes_ = 0;
+    };
+
+}// namespace
+
+int main() {
+    const std::vector<uint32_t> sizes = {96, 300};
+    const std::vector<variant> variants = {
+            {"uniform", false, 0.0},
+            {"region 0.25", true, 0.25},
+            {"region 0.10", true, 0.10},
+            {"region 0.05", true, 0.05},
+    };
+    const size_t updates = 4;
+    const int warmup_rounds = 10;
+    const int idle_rounds = 20;
+    const int max_rounds = 1000;
+    const double rounds_per_second = 1000.0 / config::DEFAULT_HEARTBEAT_INTERVAL_MS;
+
+    std::printf("3 regions, %zu metadata updates, %.0f rounds per second\n", updates, rounds_per_second);
+    std::printf("%8s %12s %14s %16s %12s %8s %12s\n", "members", "selection", "B/s/member", "WAN B/s/member",
+                "WAN share", "rounds", "converge ms");
+
+    for (uint32_t n: sizes) {
+        for (const auto &v: variants) {
+            simulated_cluster cluster(n, v);
+            for (int r = 0; r < warmup_rounds; ++r) {
+                cluster.round();
+            }
+
+            const size_t total_before = cluster.bytes_sent();
+            const size_t cross_before = cluster.cross_region_bytes();
+            for (int r = 0; r < idle_rounds; ++r) {
+                cluster.round();
+            }
+            const auto total = static_cast<double>(cluster.bytes_sent() - total_before);
+            const auto cross = static_cast<double>(cluster.cross_region_bytes() - cross_before);
+            const double per_member = rounds_per_second / idle_rounds / n;
+
+            std::mt19937 rng(n);
+            std::vector<uint32_t> updated;
+            while (updated.size() < updates) {
+                const auto member = static_cast<uint32_t>(rng() % n);
+                if (std::find(updated.begin(), updated.end(), member) == updated.end()) {
+                    updated.push_back(member);
+                    cluster.update_metadata(member);
+                }
+            }
+            int rounds = 0;
+            while (!cluster.converged(updates) && rounds < max_rounds) {
+                cluster.round();
+                ++rounds;
+            }
+
+            const bool done = rounds < max_rounds;
+            std::printf("%8u %12s %14.0f %16.0f %11.1f%% %8s %12s\n", n, v.name, total * per_member,
+                        cross * per_member, 100.0 * cross / total, done ? std::to_string(rounds).c_str() : "n/a",
+                        done ? std::to_string(static_cast<int>(rounds * 1000 / rounds_per_second)).c_str() : "n/a");
+            std::fflush(stdout);
+        }
+    }
+
+    return 0;
+}
@@ -0,0 +1,173 @@
+/**
+ * @file simulation_benchmark.cpp
+ * @brief Convergence and crash detection of large simulated clusters
+ *
+ * Runs sim::simulator on three clusters:
+ *   - flat: 500 members with full membership, each meets member 0
+ *   - hierarchical: 5,000 members in regions of 100, each meets the first
+ *     member of its region, which meets member 0
+ *   - partial: 10,000 members (or argv[1], e.g. 100000) holding at most 32
+ *     members each (max_nodes), each meets 3 random members; membership
+ *     never converges, so only detection is measured
+ * Once converged (partial: after 30 s), 1% of the members crash at once and
+ * the run continues for 30 s. Reported: simulated time to converge, time
+ * from a crash to the first member failing the node and to every member
+ * that held it failing it (median and p99 over the crashed members), false
+ * failures of members that are up, messages per member per second, heap
+ * bytes per member (live bytes, through a replaced operator new) and wall
+ * time per simulated second. The network delays messages 0.5-1.5 ms and
+ * drops 1%.
+ */
+
+#include "sim/simulator.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+#include <string>
+#include <vector>
+
+using namespace libgossip;
+using namespace libgossip::sim;
+using namespace std::chrono_literals;
+
+namespace {
+    size_t heap_bytes = 0;// Live bytes
+    constexpr size_t header = alignof(std::max_align_t);
+}// namespace
+
+void *operator new(std::size_t size) {
+    auto *p = static_cast<unsigned char *>(std::malloc(size + header));
+    if (!p) {
+        throw std::bad_alloc();
+    }
+    *reinterpret_cast<std::size_t *>(p) = size;
+    heap_bytes += size;
+    return p + header;
+}
+
+void operator delete(void *p) noexcept {
+    if (p) {
+        auto *block = static_cast<unsigned char *>(p) - header;
+        heap_bytes -= *reinterpret_cast<std::size_t *>(block);
+        std::free(block);
+    }
+}
+
+void operator delete(void *p, std::size_t) noexcept {
+    operator delete(p);
+}
+
+namespace {
+
+    enum class cluster { flat, hierarchical, partial };
+
+    constexpr uint32_t region_size = 100;
+    constexpr uint32_t partial_view = 32;
+
+    double seconds(sim_duration d) {
+        return std::chrono::duration<double>(d).count();
+    }
+
+    // Median and p99 of the detection times present
+    std::pair<double, double> percentiles(std::vector<double> times) {
+        if (times.empty()) {
+            return {-1, -1};
+        }
+        std::sort(times.begin(), times.end());
+        return {times[times.size() / 2], times[std::min(times.size() - 1, times.size() * 99 / 100)]};
+    }
+
+    void run(cluster kind, uint32_t n) {
+        simulation_options options;
+        options.seed = 2025;
+        options.network.loss = 0.01;
+        options.core.event_queue_capacity = 8;// Defaults preallocate ~200 KB per core
+        options.core.event_overflow = event_overflow_policy::grow;
+        options.core.max_nodes = kind == cluster::partial ? partial_view : 0;
+        options.core.hierarchical = kind == cluster::hierarchical;
+
+        const size_t heap_before = heap_bytes;
+        const auto wall_start = std::chrono::steady_clock::now();
+        simulator sim(options);
+        if (kind == cluster::hierarchical) {
+            sim.add_nodes(n, [](uint32_t i) { return "region-" + std::to_string(i / region_size); });
+        } else {
+            sim.add_nodes(n);
+        }
+
+        xoshiro256ss rng(options.seed);
+        for (uint32_t i = 0; i < n; ++i) {
+            if (kind == cluster::partial) {
+                for (int k = 0; k < 3; ++k) {
+                    const uint32_t peer = rng.uniform(n);
+                    if (peer != i) {
+                        sim.meet(i, peer);
+                    }
+                }
+                continue;
+            }
+            const uint32_t first = kind == cluster::hierarchical ? i / region_size * region_size : 0;
+            if (i != first) {
+                sim.meet(i, first);
+            } else if (i != 0) {
+                sim.meet(i, 0);
+            }
+        }
+
+        std::string converge = "n/a";
+        if (kind == cluster::partial) {
+            sim.run_for(30s);
+        } else {
+            auto took = sim.run_until([&sim] { return sim.converged(); }, 120s);
+            converge = took ? std::to_string(seconds(*took)).substr(0, 5) : "> 120";
+        }
+        const size_t heap = heap_bytes - heap_before;
+
+        const uint64_t sent_before = sim.stats().messages_sent;
+        const sim_duration crashed_at = sim.elapsed();
+        for (uint32_t i = 0; i < n / 100; ++i) {
+            sim.crash(rng.uniform(n));
+        }
+        sim.run_for(30s);
+
+        std::vector<double> first_failed;
+        std::vector<double> all_failed;
+        for (const auto &d: sim.detections()) {
+            if (d.first_failed) {
+                first_failed.push_back(seconds(*d.first_failed));
+            }
+            if (d.all_failed) {
+                all_failed.push_back(seconds(*d.all_failed));
+            }
+        }
+        const auto first = percentiles(first_failed);
+        const auto all = percentiles(all_failed);
+        const double simulated = seconds(sim.elapsed());
+        const double per_second = static_cast<double>(sim.stats().messages_sent - sent_before) /
+                                  seconds(sim.elapsed() - crashed_at) / n;
+        const double wall = std::chrono::duration<double>(std::chrono::steady_clock::now() - wall_start).count();
+
+        const char *names[] = {"flat", "hierarchical", "partial"};
+        std::printf("%8u %13s %9s %11.2f %9.2f %11.2f %9.2f %6zu/%-6zu %8llu %9.1f %9.1f %8.2f\n", n,
+                    names[static_cast<int>(kind)], converge.c_str(), first.first, first.second, all.first, all.second,
+                    all_failed.size(), sim.detections().size(),
+                    static_cast<unsigned long long>(sim.stats().false_failures), per_second,
+                    static_cast<double>(heap) / 1024 / n, wall / simulated);
+        std::fflush(stdout);
+    }
+
+}// namespace
+
+int main(int argc, char **argv) {
+    const uint32_t partial_nodes = argc > 1 ? static_cast<uint32_t>(std::strtoul(argv[1], nullptr, 10)) : 10000;
+
+    std::printf("%8s %13s %9s %11s %9s %11s %9s %13s %8s %9s %9s %8s\n", "members", "cluster", "converge",
+                "first p50", "p99", "all p50", "p99", "detected", "false", "msgs/s", "KB/member", "wall/s");
+    run(cluster::flat, 500);
+    run(cluster::hierarchical, 5000);
+    run(cluster::partial, partial_nodes);
+    return 0;
+}
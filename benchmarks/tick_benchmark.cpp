@@ -0,0 +1,50 @@
+/**
+ * @file tick_benchmark.cpp
+ * @brief Cost of tick() and cleanup_expired() on a quiet cluster
+ *
+ * Populates a gossip_core with 100 .. 100k healthy members (recently seen,
+ * none due to time out) and measures:
+ * - tick(), which probes gossip_nodes members and runs failure detection
+ * - cleanup_expired(), with no member old enough to be removed
+ *
+ * Deadlines are kept in timer wheels, so neither column should grow with
+ * the membership while nothing is expiring.
+ */
+
+#include "bench_util.hpp"
+#include <cstdio>
+#include <vector>
+
+using namespace libgossip;
+
+int main() {
+    const std::vector<uint32_t> sizes = {100, 1000, 10000, 100000};
+
+    std::printf("%10s %14s %20s\n", "members", "tick ns", "cleanup_expired ns");
+
+    for (uint32_t n: sizes) {
+        node_view self = bench::make_node(0xFFFFFF);
+        gossip_core_options options;
+        options.max_nodes = 0;// Past config::DEFAULT_MAX_NODES
+        gossip_core core(self, [](const gossip_message &, const node_view &) {}, nullptr, options);
+
+        // Members arrive as online entries of a message, stamped now
+        gossip_message msg;
+        msg.sender = self.id;
+        msg.type = message_type::update;
+        for (uint32_t i = 0; i < n; ++i) {
+            msg.entries.push_back(bench::make_node(i));
+        }
+        core.handle_message(msg, clock::now());
+
+        const size_t iterations = 2000;
+        double tick_ns = bench::ns_per_op(iterations, [&](size_t) { core.tick(); });
+        double cleanup_ns = bench::ns_per_op(iterations, [&](size_t) {
+            core.cleanup_expired(std::chrono::milliseconds(60000));
+        });
+
+        std::printf("%10u %14.1f %20.1f\n", n, tick_ns, cleanup_ns);
+    }
+
+    return 0;
+}
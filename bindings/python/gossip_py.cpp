@@ -79,6 +79,12 @@ PYBIND11_MODULE(libgossip_py, m) {
             .value("JOIN", libgossip::message_type::join)
             .value("LEAVE", libgossip::message_type::leave)
             .value("UPDATE", libgossip::message_type::update)
+            .value("PING_REQ", libgossip::message_type::ping_req)
+            .value("INDIRECT_ACK", libgossip::message_type::indirect_ack)
+            .value("SYNC_TREE", libgossip::message_type::sync_tree)
+            .value("SYNC_BUCKET", libgossip::message_type::sync_bucket)
+            .value("GROUP_SYNC", libgossip::message_type::group_sync)
+            .value("GROUP_SYNC_ACK", libgossip::message_type::group_sync_ack)
             .export_values();
 
     // Bindings for node_id_t
@@ -113,36 +119,95 @@ PYBIND11_MODULE(libgossip_py, m) {
     py::class_<libgossip::node_view>(m, "NodeView")
             .def(py::init<>())
             .def_readwrite("id", &libgossip::node_view::id)
-            .def_readwrite("ip", &libgossip::node_view::ip)
+            .def_property(
+                    "ip", [](const libgossip::node_view &n) { return n.ip.str(); },
+                    [](libgossip::node_view &n, const std::string &value) { n.ip = value; })
             .def_readwrite("port", &libgossip::node_view::port)
             .def_readwrite("config_epoch", &libgossip::node_view::config_epoch)
             .def_readwrite("heartbeat", &libgossip::node_view::heartbeat)
             .def_readwrite("version", &libgossip::node_view::version)
             .def_readwrite("seen_time", &libgossip::node_view::seen_time)
             .def_readwrite("status", &libgossip::node_view::status)
-            .def_readwrite("role", &libgossip::node_view::role)
-            .def_readwrite("region", &libgossip::node_view::region)
+            .def_property(
+                    "role", [](const libgossip::node_view &n) { return n.role.str(); },
+                    [](libgossip::node_view &n, const std::string &value) { n.role = value; })
+            .def_property(
+                    "region", [](const libgossip::node_view &n) { return n.region.str(); },
+                    [](libgossip::node_view &n, const std::string &value) { n.region = value; })
             .def_readwrite("metadata", &libgossip::node_view::metadata)
+            .def_readwrite("metadata_version", &libgossip::node_view::metadata_version)
+            .def_readwrite("metadata_hash", &libgossip::node_view::metadata_hash)
+            .def_readwrite("metadata_versions", &libgossip::node_view::metadata_versions)
+            .def_readwrite("metadata_since", &libgossip::node_view::metadata_since)
             .def_readwrite("suspicion_count", &libgossip::node_view::suspicion_count)
             .def_readwrite("last_suspected", &libgossip::node_view::last_suspected)
             .def("newer_than", &libgossip::node_view::newer_than)
             .def("can_replace", &libgossip::node_view::can_replace);
 
+    // Bindings for node_digest
+    py::class_<libgossip::node_digest>(m, "NodeDigest")
+            .def(py::init<>())
+            .def_readwrite("id", &libgossip::node_digest::id)
+            .def_readwrite("heartbeat", &libgossip::node_digest::heartbeat)
+            .def_readwrite("config_epoch", &libgossip::node_digest::config_epoch)
+            .def_readwrite("state_hash", &libgossip::node_digest::state_hash);
+
+    // Bindings for merkle_hash
+    py::class_<libgossip::merkle_hash>(m, "MerkleHash")
+            .def(py::init<>())
+            .def_readwrite("index", &libgossip::merkle_hash::index)
+            .def_readwrite("hash", &libgossip::merkle_hash::hash);
+
     // Bindings for gossip_message
     py::class_<libgossip::gossip_message>(m, "GossipMessage")
             .def(py::init<>())
             .def_readwrite("sender", &libgossip::gossip_message::sender)
             .def_readwrite("type", &libgossip::gossip_message::type)
             .def_readwrite("timestamp", &libgossip::gossip_message::timestamp)
-            .def_readwrite("entries", &libgossip::gossip_message::entries);
+            .def_readwrite("entries", &libgossip::gossip_message::entries)
+            .def_readwrite("digests", &libgossip::gossip_message::digests)
+            .def_readwrite("tree", &libgossip::gossip_message::tree);
 
     // Bindings for gossip_stats
     py::class_<libgossip::gossip_stats>(m, "GossipStats")
             .def(py::init<>())
             .def_readwrite("known_nodes", &libgossip::gossip_stats::known_nodes)
+            .def_readwrite("gossip_nodes", &libgossip::gossip_stats::gossip_nodes)
+            .def_readwrite("sync_nodes", &libgossip::gossip_stats::sync_nodes)
             .def_readwrite("sent_messages", &libgossip::gossip_stats::sent_messages)
             .def_readwrite("received_messages", &libgossip::gossip_stats::received_messages)
-            .def_readwrite("last_tick_duration", &libgossip::gossip_stats::last_tick_duration);
+            .def_readwrite("last_tick_duration", &libgossip::gossip_stats::last_tick_duration)
+            .def_readwrite("indirect_probes_sent", &libgossip::gossip_stats::indirect_probes_sent)
+            .def_readwrite("indirect_probe_rescues", &libgossip::gossip_stats::indirect_probe_rescues)
+            .def_readwrite("indirect_probe_timeouts", &libgossip::gossip_stats::indirect_probe_timeouts)
+            .def_readwrite("anti_entropy_sessions", &libgossip::gossip_stats::anti_entropy_sessions)
+            .def_readwrite("anti_entropy_buckets", &libgossip::gossip_stats::anti_entropy_buckets)
+            .def_readwrite("events_delivered", &libgossip::gossip_stats::events_delivered)
+            .def_readwrite("events_dropped", &libgossip::gossip_stats::events_dropped)
+            .def_readwrite("event_batches", &libgossip::gossip_stats::event_batches)
+            .def_readwrite("metadata_requests", &libgossip::gossip_stats::metadata_requests)
+            .def_readwrite("metadata_rejected", &libgossip::gossip_stats::metadata_rejected)
+            .def_readwrite("nodes_evicted", &libgossip::gossip_stats::nodes_evicted)
+            .def_readwrite("nodes_rejected", &libgossip::gossip_stats::nodes_rejected)
+            .def_readwrite("tombstones", &libgossip::gossip_stats::tombstones)
+            .def_readwrite("local_health", &libgossip::gossip_stats::local_health)
+            .def_readwrite("groups", &libgossip::gossip_stats::groups)
+            .def_readwrite("representative", &libgossip::gossip_stats::representative)
+            .def_readwrite("event_queue_depth", &libgossip::gossip_stats::event_queue_depth)
+            .def_readwrite("event_queue_peak", &libgossip::gossip_stats::event_queue_peak)
+            .def_readwrite("event_latency_avg", &libgossip::gossip_stats::event_latency_avg)
+            .def_readwrite("event_latency_max", &libgossip::gossip_stats::event_latency_max);
+
+    // Bindings for group_summary (hierarchical mode)
+    py::class_<libgossip::group_summary>(m, "GroupSummary")
+            .def(py::init<>())
+            .def_property(
+                    "group", [](const libgossip::group_summary &g) { return g.group.str(); },
+                    [](libgossip::group_summary &g, const std::string &value) { g.group = value; })
+            .def_readwrite("representative", &libgossip::group_summary::representative)
+            .def_readwrite("term", &libgossip::group_summary::term)
+            .def_readwrite("version", &libgossip::group_summary::version)
+            .def_readwrite("members", &libgossip::group_summary::members);
 
     // Bindings for gossip_core with shared_ptr for proper memory management
     py::class_<libgossip::gossip_core, std::shared_ptr<libgossip::gossip_core>>(m, "GossipCore")
@@ -158,7 +223,9 @@ PYBIND11_MODULE(libgossip_py, m) {
             .def("self", &libgossip::gossip_core::self, py::return_value_policy::reference_internal)
             .def("get_nodes", &libgossip::gossip_core::get_nodes)
             .def("find_node", &libgossip::gossip_core::find_node)
+            .def("find_tombstone", &libgossip::gossip_core::find_tombstone)
             .def("size", &libgossip::gossip_core::size)
+            .def("get_groups", &libgossip::gossip_core::get_groups)
             .def("cleanup_expired", &libgossip::gossip_core::cleanup_expired)
             .def("reset", &libgossip::gossip_core::reset)
             .def("get_stats", &libgossip::gossip_core::get_stats)
@@ -125,11 +125,26 @@ ext_modules = [
             native_path("src", "core", "gossip_core.cpp"),
             native_path("src", "core", "gossip_c.cpp"),
             native_path("src", "core", "node_id_utils.cpp"),
+            native_path("src", "core", "membership_table.cpp"),
+            native_path("src", "core", "timer_wheel.cpp"),
+            native_path("src", "core", "failure_detector.cpp"),
+            native_path("src", "core", "local_health.cpp"),
+            native_path("src", "core", "broadcast_queue.cpp"),
+            native_path("src", "core", "merkle_tree.cpp"),
+            native_path("src", "core", "membership_snapshot.cpp"),
+            native_path("src", "core", "event_queue.cpp"),
+            native_path("src", "core", "interned_string.cpp"),
+            native_path("src", "core", "ip_address.cpp"),
+            native_path("src", "core", "eviction_index.cpp"),
+            native_path("src", "core", "region_index.cpp"),
+            native_path("src", "core", "group_directory.cpp"),
+            native_path("src", "core", "tombstone_store.cpp"),
             native_path("src", "net", "udp_transport.cpp"),
             native_path("src", "net", "tcp_transport.cpp"),
             native_path("src", "net", "transport_factory.cpp"),
             native_path("src", "net", "serializer_factory.cpp"),
             native_path("src", "net", "json_serializer.cpp"),
+            native_path("src", "net", "frame_coalescer.cpp"),
         ],
         include_dirs=[
             native_path("include"),
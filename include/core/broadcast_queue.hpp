@@ -0,0 +1,89 @@
+/**
+ * @file broadcast_queue.hpp
+ * @brief Piggyback dissemination queue with bounded retransmissions
+ *
+ * Holds at most one pending broadcast per membership_table slot: the
+ * node's current view is read from the table when a message is built, so a
+ * newer change simply restarts the node's transmit count. Broadcasts are
+ * kept in one intrusive list per transmit count, newest first, which makes
+ * "least transmitted, then most recent" selection O(entries taken) and
+ * every other operation O(1) without allocating once grown.
+ *
+ * A broadcast is dropped once it has been sent retransmit_limit times.
+ *
+ * @note Not thread-safe; the owning gossip_core serializes access.
+ */
+
+#pragma once
+
+#include "config.hpp"
+#include "membership_table.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace libgossip {
+
+    class LIBGOSSIP_API broadcast_queue {
+    public:
+        /// Queue a broadcast for the node, or restart its transmit count
+        void push(node_handle handle);
+
+        /// Drop the broadcast of slot index, if any
+        void remove(uint32_t index) noexcept;
+
+        /// Drop everything
+        void clear() noexcept;
+
+        /// Number of queued broadcasts
+        size_t size() const noexcept { return queued_count_; }
+
+        bool empty() const noexcept { return queued_count_ == 0; }
+
+        /// Pick up to max broadcasts for one message, least transmitted and
+        /// most recent first, skipping those for which accept(handle) is false.
+        /// Picked broadcasts count as transmitted once; those that reach
+        /// retransmit_limit (or were already past a lowered limit) are dropped.
+        /// @param out Receives the picked handles; cleared first
+        template<typename Accept>
+        void take(size_t max, uint32_t retransmit_limit, Accept &&accept, std::vector<node_handle> &out) {
+            out.clear();
+            for (uint32_t transmits = 0; transmits < heads_.size() && out.size() < max; ++transmits) {
+                uint32_t index = heads_[transmits];
+                while (index != nil && out.size() < max) {
+                    const uint32_t next = entries_[index].next;
+                    node_handle handle{index, entries_[index].generation};
+                    if (transmits >= retransmit_limit) {
+                        unlink(index);
+                    } else if (accept(handle)) {
+                        out.push_back(handle);
+                    }
+                    index = next;
+                }
+            }
+            for (const auto &handle: out) {
+                transmitted(handle.index, retransmit_limit);
+            }
+        }
+
+    private:
+        static constexpr uint32_t nil = 0xFFFFFFFFu;
+
+        struct entry {
+            uint32_t generation = 0;
+            uint32_t transmits = 0;
+            uint32_t prev = nil;
+            uint32_t next = nil;
+            bool queued = false;
+        };
+
+        void link_front(uint32_t index);
+        void unlink(uint32_t index) noexcept;
+        void transmitted(uint32_t index, uint32_t retransmit_limit);
+
+        std::vector<uint32_t> heads_;// Newest broadcast per transmit count
+        std::vector<entry> entries_; // Indexed by table slot
+        size_t queued_count_ = 0;
+    };
+
+}// namespace libgossip
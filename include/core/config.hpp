@@ -54,14 +54,69 @@ constexpr uint32_t DEFAULT_FAILURE_TIMEOUT_MS = 2000;
 constexpr uint32_t DEFAULT_GOSSIP_NODES = 3;
 constexpr uint32_t DEFAULT_SYNC_NODES = 2;
 
+// Adaptive fanout: pings per tick and entries per message grow as ceil(ln(N)),
+// within a per-tick budget of TICK_BUDGET_BYTES (0 for no budget). The budget
+// is spent at the estimated JSON wire size of a message and of each entry
+// (a view plus its owner's metadata, or a digest).
+constexpr uint32_t DEFAULT_TICK_BUDGET_BYTES = 0;
+constexpr size_t ESTIMATED_MESSAGE_BYTES = 96;
+constexpr size_t ESTIMATED_VIEW_BYTES = 224;
+constexpr size_t ESTIMATED_DIGEST_BYTES = 64;
+
+// Region-aware peer selection: chance that a peer is drawn from another region
+constexpr double DEFAULT_CROSS_REGION_FRACTION = 0.1;
+
+// Timer wheels for failure detection and expiry (10ms x 512 buckets ~ 5s per revolution)
+constexpr uint32_t DEFAULT_TIMER_WHEEL_RESOLUTION_MS = 10;
+constexpr size_t DEFAULT_TIMER_WHEEL_BUCKETS = 512;
+
+// Phi-accrual failure detector (used when selected in gossip_config)
+constexpr double DEFAULT_PHI_THRESHOLD = 8.0;
+constexpr uint32_t DEFAULT_PHI_MIN_STD_DEVIATION_MS = 100;
+
+// Indirect probing (SWIM ping-req) before a node is escalated
+constexpr uint32_t DEFAULT_INDIRECT_PROBES = 3;
+constexpr uint32_t DEFAULT_INDIRECT_PROBE_TIMEOUT_MS = 500;
+
+// Broadcast queue dissemination: each change is sent RETRANSMIT_MULT * ceil(log10(N + 1)) times
+constexpr uint32_t DEFAULT_RETRANSMIT_MULT = 3;
+constexpr uint32_t DEFAULT_MAX_PIGGYBACK_ENTRIES = 8;
+
+// Merkle anti-entropy: one session with a random peer per interval (0 disables,
+// about ten heartbeats is a sensible value), at most MAX_DIGESTS digests per bucket message
+constexpr uint32_t DEFAULT_ANTI_ENTROPY_INTERVAL_MS = 0;
+constexpr uint32_t DEFAULT_ANTI_ENTROPY_MAX_DIGESTS = 128;
+
+// Local health (Lifeguard): failure, ack and indirect probe timeouts are
+// multiplied by score + 1, with the score capped at LOCAL_HEALTH_MAX
+// (0 disables it, Lifeguard uses 8)
+constexpr uint32_t DEFAULT_LOCAL_HEALTH_MAX = 0;
+
+// Membership events queued under the core's lock and delivered after it is released
+constexpr size_t DEFAULT_EVENT_QUEUE_CAPACITY = 1024;
+
 // Network Configuration
 constexpr size_t DEFAULT_TCP_RECV_BUFFER_SIZE = 65536;
 constexpr size_t DEFAULT_UDP_RECV_BUFFER_SIZE = 65536;
 constexpr size_t DEFAULT_MAX_MESSAGE_SIZE = 1024 * 1024; // 1MB
 
+// UDP sends to the same target within COALESCE_WINDOW_US share one datagram
+// of at most MAX_DATAGRAM_SIZE bytes (0 sends every message on its own)
+constexpr uint32_t DEFAULT_UDP_COALESCE_WINDOW_US = 0;
+constexpr size_t DEFAULT_UDP_MAX_DATAGRAM_SIZE = 65507;
+
+// Distinct role, region and host name strings interned per process; values
+// past it (e.g. from a peer sending many) are stored per view instead
+constexpr size_t DEFAULT_INTERN_POOL_LIMIT = 4096;
+
 // Node Configuration
-constexpr size_t DEFAULT_MAX_NODES = 1000;
-constexpr size_t DEFAULT_NODE_METADATA_SIZE_LIMIT = 65536; // 64KB
+constexpr size_t DEFAULT_MAX_NODES = 1000; // Members a gossip_core holds besides itself
+constexpr size_t DEFAULT_NODE_METADATA_SIZE_LIMIT = 65536; // 64KB of keys and values per node
+
+// Gossiped views carry the metadata keys written in the owner's last
+// METADATA_DELTA_WINDOW metadata versions instead of the whole map, to
+// peers that version their own metadata (older releases get full maps)
+constexpr uint32_t DEFAULT_METADATA_DELTA_WINDOW = 8;
 
 } // namespace libgossip::config
 
@@ -105,9 +160,11 @@ constexpr size_t DEFAULT_NODE_METADATA_SIZE_LIMIT = 65536; // 64KB
 #if LIBGOSSIP_ENABLE_LOGGING
     #define LIBGOSSIP_LOG(level, message) \
         do { \
-            std::stringstream ss; \
-            ss << message; \
-            libgossip::Logger::Instance().Log(libgossip::LogLevel::level, ss.str()); \
+            if (libgossip::Logger::Instance().Enabled(libgossip::LogLevel::level)) { \
+                std::stringstream ss; \
+                ss << message; \
+                libgossip::Logger::Instance().Log(libgossip::LogLevel::level, ss.str()); \
+            } \
         } while(0)
 #else
     #define LIBGOSSIP_LOG(level, message) ((void)0)
@@ -0,0 +1,105 @@
+/**
+ * @file event_queue.hpp
+ * @brief Bounded ring of membership events awaiting delivery
+ *
+ * gossip_core queues events while its mutex is held and hands them to the
+ * event callback once the mutex is released. Slots are preallocated and
+ * reused: pop() swaps the node_view out, so its strings and metadata keep
+ * their capacity for the next event. Events come out in the order they went
+ * in, so the events of one node are always delivered in the order they
+ * happened; on overflow the event_overflow_policy decides which are lost.
+ *
+ * change_batch folds a run of queued events into one membership_change per
+ * node, for consumers that rebuild derived state once per batch.
+ *
+ * @note Not thread-safe; the owning gossip_core serializes access.
+ */
+
+#pragma once
+
+#include "config.hpp"
+#include "gossip_config.hpp"
+#include "membership_table.hpp"
+#include "node_view.hpp"
+#include <cstddef>
+#include <unordered_map>
+#include <vector>
+
+namespace libgossip {
+
+    struct queued_event {
+        node_view node;
+        node_status old_status = node_status::unknown;
+        time_point queued_at{};
+    };
+
+    /// Net change of one node over a batch of events
+    struct membership_change {
+        node_view node;                               // Latest view
+        node_status old_status = node_status::unknown;// Status before the batch (unknown: new node)
+    };
+
+    class LIBGOSSIP_API event_queue {
+    public:
+        event_queue(size_t capacity, event_overflow_policy policy);
+
+        /// Queue an event
+        /// @return false if an event was dropped to respect the capacity
+        bool push(const node_view &node, node_status old_status, time_point now);
+
+        /// Move the oldest event into out
+        /// @return false if the queue is empty
+        bool pop(queued_event &out);
+
+        /// Drop every queued event (not counted as dropped)
+        void clear() noexcept;
+
+        size_t size() const noexcept { return count_; }
+        bool empty() const noexcept { return count_ == 0; }
+        size_t capacity() const noexcept { return ring_.size(); }
+
+        /// Highest number of events queued at once
+        size_t peak() const noexcept { return peak_; }
+
+        /// Events lost to overflow
+        size_t dropped() const noexcept { return dropped_; }
+
+    private:
+        void grow();
+
+        std::vector<queued_event> ring_;
+        size_t head_ = 0;// Oldest event
+        size_t count_ = 0;
+        size_t peak_ = 0;
+        size_t dropped_ = 0;
+        event_overflow_policy policy_;
+    };
+
+    class LIBGOSSIP_API change_batch {
+    public:
+        /// Fold an event into the batch (its node_view is moved from)
+        void add(queued_event &event);
+
+        /// Drop the nodes whose status changed and changed back with nothing
+        /// else changing. Call once, after the last add().
+        void finish();
+
+        /// One change per node, in order of each node's first event
+        const std::vector<membership_change> &changes() const noexcept { return changes_; }
+
+        bool empty() const noexcept { return changes_.empty(); }
+
+        /// Start a new batch
+        void clear() noexcept;
+
+    private:
+        struct id_hash {
+            size_t operator()(const node_id_t &id) const noexcept { return static_cast<size_t>(hash_node_id(id)); }
+        };
+
+        std::vector<membership_change> changes_;
+        std::vector<bool> state_changed_;// Per change: more than status flips (new node, metadata, ...)
+        std::unordered_map<node_id_t, size_t, id_hash> index_;
+    };
+
+}// namespace libgossip
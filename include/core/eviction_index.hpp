@@ -0,0 +1,69 @@
+/**
+ * @file eviction_index.hpp
+ * @brief Order in which members leave a membership table at capacity
+ *
+ * Every member sits in exactly one of a fixed number of eviction classes,
+ * lowest first: gossip_core uses failed, then suspect, then one class per
+ * region priority for live members. Each class is an intrusive list from
+ * least to most recently updated, and touch() moves a member to the back,
+ * so the member to evict is the front of the lowest non-empty class. All
+ * operations are O(1) (victim() is O(classes)) and nothing allocates once
+ * the per-slot array has grown.
+ *
+ * @note Not thread-safe; the owning gossip_core serializes access.
+ */
+
+#pragma once
+
+#include "config.hpp"
+#include "membership_table.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace libgossip {
+
+    class LIBGOSSIP_API eviction_index {
+    public:
+        explicit eviction_index(uint32_t classes = 1);
+
+        /// Put the node at the back of class cls (most recently updated)
+        void touch(node_handle handle, uint32_t cls);
+
+        /// Drop slot index, if present
+        void remove(uint32_t index) noexcept;
+
+        /// Drop everything
+        void clear() noexcept;
+
+        /// Least recently updated member of the lowest non-empty class below
+        /// limit, skipping pinned; an invalid handle if there is none
+        node_handle victim(uint32_t limit, node_handle pinned = {}) const noexcept;
+
+        /// Class of slot index, or classes() if it is not present
+        uint32_t class_of(uint32_t index) const noexcept;
+
+        uint32_t classes() const noexcept { return static_cast<uint32_t>(heads_.size()); }
+
+        /// Number of members in class cls
+        size_t size(uint32_t cls) const noexcept { return cls < counts_.size() ? counts_[cls] : 0; }
+
+    private:
+        static constexpr uint32_t nil = 0xFFFFFFFFu;
+
+        struct entry {
+            uint32_t generation = 0;
+            uint32_t cls = nil;// nil: not present
+            uint32_t prev = nil;
+            uint32_t next = nil;
+        };
+
+        void unlink(uint32_t index) noexcept;
+
+        std::vector<uint32_t> heads_;// Least recently updated per class
+        std::vector<uint32_t> tails_;// Most recently updated per class
+        std::vector<size_t> counts_;
+        std::vector<entry> entries_;// Indexed by table slot
+    };
+
+}// namespace libgossip
@@ -0,0 +1,127 @@
+/**
+ * @file failure_detector.hpp
+ * @brief Failure detector policies used by gossip_core
+ *
+ * A failure detector decides when an online node that has gone quiet
+ * becomes suspect. gossip_core feeds it every arrival it attributes to a
+ * node and asks it for the node's suspicion deadline, which is what the
+ * failure timer wheel is armed with. The suspect -> failed escalation stays
+ * in gossip_core.
+ *
+ * Per-node state is kept in arrays indexed by membership_table slot and is
+ * reset when a slot is reused (different handle generation), so updates
+ * are O(1) and do not allocate once the arrays have grown to the table.
+ *
+ * @note Not thread-safe; the owning gossip_core serializes access.
+ */
+
+#pragma once
+
+#include "config.hpp"
+#include "gossip_config.hpp"
+#include "membership_table.hpp"
+#include "node_view.hpp"
+#include <array>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace libgossip {
+
+    class LIBGOSSIP_API failure_detector {
+    public:
+        virtual ~failure_detector() = default;
+
+        /// Something was heard from (or about) the node at arrival
+        virtual void heartbeat(node_handle handle, time_point arrival) = 0;
+
+        /// The node was removed from the table
+        virtual void forget(node_handle handle) noexcept = 0;
+
+        /// Drop all per-node state
+        virtual void clear() noexcept = 0;
+
+        /// Time at which the node becomes suspect if nothing more is heard
+        virtual time_point suspect_deadline(node_handle handle, const node_view &node) const noexcept = 0;
+
+        /// Current suspicion level of the node, for diagnostics.
+        /// Detector specific: elapsed / timeout for the timeout detector, phi for phi-accrual.
+        virtual double suspicion(node_handle handle, const node_view &node, time_point now) const noexcept = 0;
+    };
+
+    /// Fixed timeout: suspect once seen_time + timeout has passed (the default)
+    class LIBGOSSIP_API timeout_detector final : public failure_detector {
+    public:
+        explicit timeout_detector(duration_ms timeout) noexcept : timeout_(timeout) {}
+
+        void heartbeat(node_handle, time_point) override {}
+        void forget(node_handle) noexcept override {}
+        void clear() noexcept override {}
+
+        time_point suspect_deadline(node_handle, const node_view &node) const noexcept override {
+            return node.seen_time + timeout_;
+        }
+
+        double suspicion(node_handle handle, const node_view &node, time_point now) const noexcept override;
+
+    private:
+        duration_ms timeout_;
+    };
+
+    /**
+     * @brief Phi-accrual detector (Hayashibara et al.)
+     *
+     * Keeps the last window_size heartbeat inter-arrival times of each node in
+     * a ring with running sums, and models them as a normal distribution.
+     * phi = -log10(P(no heartbeat yet after t)), using the logistic
+     * approximation of the normal CDF. Since the threshold is fixed, the
+     * deviation at which phi crosses it is solved once, and the suspicion
+     * deadline is last_arrival + mean + y_threshold * stddev.
+     *
+     * Until a node has produced a few intervals the detector falls back to
+     * the fixed timeout.
+     */
+    class LIBGOSSIP_API phi_accrual_detector final : public failure_detector {
+    public:
+        static constexpr size_t window_size = 32;
+        static constexpr size_t min_samples = 3;
+
+        phi_accrual_detector(double threshold, duration_ms min_std_deviation, duration_ms fallback_timeout);
+
+        void heartbeat(node_handle handle, time_point arrival) override;
+        void forget(node_handle handle) noexcept override;
+        void clear() noexcept override;
+        time_point suspect_deadline(node_handle handle, const node_view &node) const noexcept override;
+        double suspicion(node_handle handle, const node_view &node, time_point now) const noexcept override;
+
+        /// phi of a silence of elapsed_ms given the interval distribution
+        static double phi(double elapsed_ms, double mean_ms, double std_deviation_ms) noexcept;
+
+    private:
+        struct history {
+            std::array<uint32_t, window_size> intervals_ms{};// Ring of inter-arrival times
+            uint64_t sum = 0;                                // Running sums over the ring
+            uint64_t sum_squares = 0;
+            time_point last_arrival{};
+            uint32_t generation = 0;
+            uint16_t count = 0;
+            uint16_t head = 0;
+            bool used = false;
+        };
+
+        /// History of a live handle, or nullptr if none was recorded
+        const history *find(node_handle handle) const noexcept;
+
+        void moments(const history &h, double &mean_ms, double &std_deviation_ms) const noexcept;
+
+        std::vector<history> histories_;// Indexed by table slot
+        double threshold_;
+        double min_std_deviation_ms_;
+        duration_ms fallback_timeout_;
+        double threshold_deviations_;// y at which phi(y) == threshold
+    };
+
+    /// Create the detector selected by options
+    LIBGOSSIP_API std::unique_ptr<failure_detector> make_failure_detector(const gossip_core_options &options);
+
+}// namespace libgossip
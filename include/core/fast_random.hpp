@@ -0,0 +1,70 @@
+/**
+ * @file fast_random.hpp
+ * @brief Small, fast pseudo-random generator for the gossip hot paths
+ *
+ * Peer selection runs several times per tick, so it cannot afford to build
+ * a std::random_device and seed a std::mt19937 on every call. Each
+ * gossip_core owns one xoshiro256** generator that is seeded once.
+ *
+ * @note Not cryptographically secure, and not thread-safe.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <limits>
+
+namespace libgossip {
+
+    /**
+     * @brief xoshiro256** generator (Blackman & Vigna)
+     *
+     * Satisfies UniformRandomBitGenerator, so it can also be passed to
+     * std::shuffle and the standard distributions.
+     */
+    class xoshiro256ss {
+    public:
+        using result_type = uint64_t;
+
+        explicit xoshiro256ss(uint64_t seed = 0x9E3779B97F4A7C15ULL) noexcept { this->seed(seed); }
+
+        /// Re-seed; the 256-bit state is expanded from seed with splitmix64
+        void seed(uint64_t seed) noexcept {
+            for (auto &word: state_) {
+                seed += 0x9E3779B97F4A7C15ULL;
+                uint64_t z = seed;
+                z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+                z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+                word = z ^ (z >> 31);
+            }
+        }
+
+        static constexpr result_type min() noexcept { return 0; }
+        static constexpr result_type max() noexcept { return std::numeric_limits<result_type>::max(); }
+
+        result_type operator()() noexcept {
+            const uint64_t result = rotl(state_[1] * 5, 7) * 9;
+            const uint64_t t = state_[1] << 17;
+            state_[2] ^= state_[0];
+            state_[3] ^= state_[1];
+            state_[1] ^= state_[2];
+            state_[0] ^= state_[3];
+            state_[2] ^= t;
+            state_[3] = rotl(state_[3], 45);
+            return result;
+        }
+
+        /// Uniform integer in [0, bound), bound > 0 (Lemire's multiply-shift, bias at most bound / 2^32)
+        uint32_t uniform(uint32_t bound) noexcept {
+            return static_cast<uint32_t>(((*this)() >> 32) * bound >> 32);
+        }
+
+    private:
+        static uint64_t rotl(uint64_t x, int k) noexcept {
+            return (x << k) | (x >> (64 - k));
+        }
+
+        uint64_t state_[4]{};
+    };
+
+}// namespace libgossip
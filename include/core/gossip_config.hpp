@@ -11,10 +11,115 @@
 #include "config.hpp"
 #include "node_id_utils.hpp"
 #include <chrono>
+#include <cstddef>
+#include <cstdint>
 #include <string>
+#include <vector>
 
 namespace libgossip {
 
+/**
+ * @brief Order in which gossip_core::tick() picks the peers it pings
+ */
+enum class probe_scheduler : uint8_t {
+    random,     ///< gossip_nodes uniformly random peers per tick (default)
+    round_robin ///< SWIM-style walk over a shuffled member list, every member
+                ///< is pinged within 2 * ceil(N / gossip_nodes) ticks
+};
+
+/**
+ * @brief Policy deciding when a quiet node becomes suspect
+ */
+enum class failure_detector_type : uint8_t {
+    timeout,    ///< Fixed failure_timeout_ms since the node was last seen (default)
+    phi_accrual ///< Phi-accrual over each node's heartbeat inter-arrival times
+};
+
+/**
+ * @brief What node entries ride along on pings and pongs
+ */
+enum class dissemination_mode : uint8_t {
+    random_entries, ///< sync_nodes random node views per message (default)
+    broadcast_queue,///< Recent changes from a queue, each retransmitted
+                    ///< retransmit_mult * ceil(log10(N + 1)) times
+    digest_sync     ///< Digests of self plus sync_nodes random peers; full
+                    ///< views are only sent to peers that are behind
+};
+
+/**
+ * @brief What happens when an event arrives at a full event queue
+ */
+enum class event_overflow_policy : uint8_t {
+    drop_oldest,///< Overwrite the oldest queued event, the newest state always arrives (default)
+    drop_newest,///< Discard the incoming event
+    grow        ///< Never drop: the queue doubles, event_queue_capacity is only preallocated
+};
+
+/**
+ * @brief Who delivers queued membership events to the event callback
+ */
+enum class event_delivery : uint8_t {
+    after_unlock,///< The thread that caused them, after releasing the core's mutex (default)
+    manual       ///< Whoever calls gossip_core::dispatch_events(), e.g. a dispatcher thread
+};
+
+/**
+ * @brief Who makes room when the membership table is at max_nodes
+ *
+ * A newcomer only ever displaces a member of a lower eviction class:
+ * suspect, then live members by region priority. Within a class the least
+ * recently updated member goes first. Failed and left members are not in
+ * the table but in the tombstone store, also max_nodes long, which drops
+ * its oldest tombstone to make room whatever the policy.
+ */
+enum class eviction_policy : uint8_t {
+    tiered,   ///< Suspect, then live members of lower-priority regions (default)
+    dead_only,///< Suspect members only; live members are never displaced
+    none      ///< Nobody: newcomers are refused while the table is full
+};
+
+/**
+ * @brief Tunables of a gossip_core instance
+ *
+ * gossip_manager derives these from gossip_config. Code that drives
+ * gossip_core directly can pass them to its constructor.
+ */
+struct gossip_core_options {
+    uint32_t heartbeat_interval_ms = config::DEFAULT_HEARTBEAT_INTERVAL_MS;
+    uint32_t failure_timeout_ms = config::DEFAULT_FAILURE_TIMEOUT_MS;
+    int gossip_nodes = config::DEFAULT_GOSSIP_NODES;  ///< Number of nodes to gossip with per tick
+    int sync_nodes = config::DEFAULT_SYNC_NODES;      ///< Number of nodes to sync per message
+    bool adaptive_fanout = false;                     ///< Grow both with ceil(ln(N)), the above are floors
+    uint32_t tick_budget_bytes = config::DEFAULT_TICK_BUDGET_BYTES;///< adaptive_fanout: estimated bytes of
+                                                                   ///< pings per tick, 0 for no budget
+    probe_scheduler scheduler = probe_scheduler::random;
+    bool region_aware = false;                        ///< Prefer members of self's region as peers
+    double cross_region_fraction = config::DEFAULT_CROSS_REGION_FRACTION;///< region_aware: share of peers from other regions
+    bool hierarchical = false;                        ///< Hold our region only; representatives exchange group summaries
+    std::string representative_role;                  ///< hierarchical: role a representative must have, empty for any
+    failure_detector_type detector = failure_detector_type::timeout;
+    double phi_threshold = config::DEFAULT_PHI_THRESHOLD;                    ///< phi at which a node becomes suspect
+    uint32_t phi_min_std_deviation_ms = config::DEFAULT_PHI_MIN_STD_DEVIATION_MS;///< Floor for the interval deviation
+    int indirect_probes = config::DEFAULT_INDIRECT_PROBES;                   ///< ping_req helpers per escalation, 0 disables
+    uint32_t indirect_probe_timeout_ms = config::DEFAULT_INDIRECT_PROBE_TIMEOUT_MS;///< Wait for a relayed ack
+    uint32_t local_health_max = config::DEFAULT_LOCAL_HEALTH_MAX;            ///< Highest local health score, 0 disables
+    dissemination_mode dissemination = dissemination_mode::random_entries;
+    uint32_t retransmit_mult = config::DEFAULT_RETRANSMIT_MULT;              ///< broadcast_queue: lambda in lambda * log(N)
+    uint32_t max_piggyback_entries = config::DEFAULT_MAX_PIGGYBACK_ENTRIES;  ///< broadcast_queue: queued entries per message
+    uint32_t anti_entropy_interval_ms = config::DEFAULT_ANTI_ENTROPY_INTERVAL_MS;///< Merkle sync with a random peer, 0 disables
+    uint32_t anti_entropy_max_digests = config::DEFAULT_ANTI_ENTROPY_MAX_DIGESTS;///< Digests per sync_bucket message
+    size_t event_queue_capacity = config::DEFAULT_EVENT_QUEUE_CAPACITY;      ///< Events buffered for delivery
+    event_overflow_policy event_overflow = event_overflow_policy::drop_oldest;
+    event_delivery delivery = event_delivery::after_unlock;                  ///< Who calls the event callback
+    size_t metadata_size_limit = config::DEFAULT_NODE_METADATA_SIZE_LIMIT;  ///< Bytes of metadata keys and values per node
+    uint32_t metadata_delta_window = config::DEFAULT_METADATA_DELTA_WINDOW;  ///< Metadata versions per gossiped delta, 0 sends full maps
+    size_t max_nodes = config::DEFAULT_MAX_NODES;                            ///< Members (and tombstones) held besides self, 0 for no limit
+    eviction_policy eviction = eviction_policy::tiered;                      ///< Who makes room at max_nodes
+    std::vector<std::string> region_priorities;                              ///< Regions to keep, most important first;
+                                                                             ///< unlisted regions are evicted first
+    uint64_t seed = 0;                                                       ///< Peer-selection generator seed, 0 for a random one
+};
+
 /**
  * @brief Configuration for GossipManager initialization
  *
@@ -34,10 +139,50 @@ struct gossip_config {
     // Gossip configuration
     int gossip_nodes = config::DEFAULT_GOSSIP_NODES;  ///< Number of nodes to gossip with per tick
     int sync_nodes = config::DEFAULT_SYNC_NODES;      ///< Number of nodes to sync per message
+    bool adaptive_fanout = false;                     ///< Derive both from the cluster size (they become floors)
+    uint32_t tick_budget_bytes = config::DEFAULT_TICK_BUDGET_BYTES; ///< adaptive_fanout: ping bytes per tick (0: no budget)
+    probe_scheduler scheduler = probe_scheduler::random; ///< Ping target selection
+    bool region_aware = false;                           ///< Pick peers mostly from our own region
+    double cross_region_fraction = config::DEFAULT_CROSS_REGION_FRACTION; ///< region_aware: chance a peer is from another region
+    bool hierarchical = false;                           ///< Two tiers: full state within our region, summaries across
+    std::string representative_role;                     ///< hierarchical: only members with this role represent a region
+
+    // Failure detection
+    failure_detector_type detector = failure_detector_type::timeout; ///< Suspicion policy
+    double phi_threshold = config::DEFAULT_PHI_THRESHOLD;              ///< phi_accrual only
+    uint32_t phi_min_std_deviation_ms = config::DEFAULT_PHI_MIN_STD_DEVIATION_MS; ///< phi_accrual only
+    int indirect_probes = config::DEFAULT_INDIRECT_PROBES;             ///< Members asked to probe a node before it is escalated (0 disables)
+    uint32_t indirect_probe_timeout_ms = config::DEFAULT_INDIRECT_PROBE_TIMEOUT_MS; ///< How long to wait for their ack
+    uint32_t local_health_max = config::DEFAULT_LOCAL_HEALTH_MAX;      ///< Scale timeouts while we are slow ourselves (0 disables)
+
+    // Dissemination
+    dissemination_mode dissemination = dissemination_mode::random_entries; ///< Entries carried per message
+    uint32_t retransmit_mult = config::DEFAULT_RETRANSMIT_MULT;            ///< broadcast_queue only
+    uint32_t max_piggyback_entries = config::DEFAULT_MAX_PIGGYBACK_ENTRIES;///< broadcast_queue only
+
+    // Anti-entropy
+    uint32_t anti_entropy_interval_ms = config::DEFAULT_ANTI_ENTROPY_INTERVAL_MS;///< Merkle tree sync period (0 disables)
+    uint32_t anti_entropy_max_digests = config::DEFAULT_ANTI_ENTROPY_MAX_DIGESTS;///< Bucket digests per message
+
+    // Event delivery
+    size_t event_queue_capacity = config::DEFAULT_EVENT_QUEUE_CAPACITY;        ///< Events buffered for the callback
+    event_overflow_policy event_overflow = event_overflow_policy::drop_oldest; ///< When the buffer is full
+    bool batch_events_per_tick = false;                                        ///< Deliver events from tick() only
+
+    // Metadata
+    size_t metadata_size_limit = config::DEFAULT_NODE_METADATA_SIZE_LIMIT;   ///< Larger updates are rejected
+    uint32_t metadata_delta_window = config::DEFAULT_METADATA_DELTA_WINDOW;   ///< 0 gossips full metadata maps
+
+    // Membership capacity
+    size_t max_nodes = config::DEFAULT_MAX_NODES;        ///< Members held besides self (0: no limit)
+    eviction_policy eviction = eviction_policy::tiered;  ///< Who makes room when full
+    std::vector<std::string> region_priorities;          ///< Regions to keep, most important first
 
     // Transport configuration
     bool use_tcp = false;              ///< false = UDP, true = TCP
     std::string serializer = "json";   ///< Serializer name (default: "json")
+    uint32_t udp_coalesce_window_us = config::DEFAULT_UDP_COALESCE_WINDOW_US; ///< UDP: merge sends to one target
+                                                                               ///< within this window (0: off)
 
     // Node metadata
     std::string role = "master";       ///< Node role ("master", "replica")
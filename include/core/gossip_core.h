@@ -67,7 +67,13 @@ typedef enum gossip_message_type {
     GOSSIP_MSG_MEET,
     GOSSIP_MSG_JOIN,
     GOSSIP_MSG_LEAVE,
-    GOSSIP_MSG_UPDATE
+    GOSSIP_MSG_UPDATE,
+    GOSSIP_MSG_PING_REQ,
+    GOSSIP_MSG_INDIRECT_ACK,
+    GOSSIP_MSG_SYNC_TREE,
+    GOSSIP_MSG_SYNC_BUCKET,
+    GOSSIP_MSG_GROUP_SYNC,
+    GOSSIP_MSG_GROUP_SYNC_ACK
 } gossip_message_type_t;
 
 // Forward declaration
@@ -46,14 +46,28 @@
 #ifndef LIBGOSSIP_CORE_HPP
 #define LIBGOSSIP_CORE_HPP
 
+#include "broadcast_queue.hpp"
 #include "config.hpp"
-#include "magic_enum/magic_enum.hpp"
-#include <array>
+#include "event_queue.hpp"
+#include "eviction_index.hpp"
+#include "failure_detector.hpp"
+#include "fast_random.hpp"
+#include "gossip_config.hpp"
+#include "group_directory.hpp"
+#include "local_health.hpp"
+#include "membership_snapshot.hpp"
+#include "membership_table.hpp"
+#include "merkle_tree.hpp"
+#include "node_view.hpp"
+#include "region_index.hpp"
+#include "timer_wheel.hpp"
+#include "tombstone_store.hpp"
+#include <atomic>
 #include <chrono>
 #include <cstdint>
 #include <functional>
-#include <list>
 #include <map>
+#include <memory>
 #include <mutex>
 #include <optional>
 #include <string>
@@ -62,98 +76,63 @@
 namespace libgossip {
 
     // ---------------------------------------------------------
-    // Basic type definitions
-    // ---------------------------------------------------------
-
-    /// Node unique ID, 16 bytes (e.g. UUID or MD5)
-    using node_id_t = std::array<uint8_t, 16>;
-
-    /// Time point type (using steady_clock)
-    using time_point = std::chrono::steady_clock::time_point;
-
-    /// Millisecond duration
-    using duration_ms = std::chrono::milliseconds;
-
-    // ---------------------------------------------------------
-    // Node status flags
+    // Gossip message types
     // ---------------------------------------------------------
 
-    enum class node_status {
-        unknown = 0,
-        joining,// Joining
-        online, // Online
-        suspect,// Suspected offline (timeout)
-        failed  // Confirmed offline
+    enum class message_type : uint8_t {
+        ping = 0,
+        pong,
+        meet,
+        join, // Explicit join
+        leave,// Explicit leave
+        update,
+        ping_req,    // Indirect probe request: ping entries[0] on the sender's behalf
+        indirect_ack,// Relayed ack: entries[0] answered an indirect probe
+        sync_tree,   // Anti-entropy: Merkle tree node hashes to compare
+        sync_bucket, // Anti-entropy: digests of the differing leaf buckets in tree
+        group_sync,  // Hierarchical: a representative's group directory, entries[0] is the sender
+        group_sync_ack// Hierarchical: the receiver's group directory in return
     };
-    template<typename E>
-    auto to_string(E value) -> std::enable_if_t<std::is_enum_v<E>, std::string> {
-        return std::string{magic_enum::enum_name(value)};
-    }
+
 
     // ---------------------------------------------------------
-    // Node view: summary information of each node in the cluster
+    // Node digest: what a peer knows about a node, without the node itself
     // ---------------------------------------------------------
 
-    struct node_view {
+    struct node_digest {
         node_id_t id{};
-        std::string ip;
-        int port = 0;
-        uint64_t config_epoch = 0;// Configuration version (for master-slave election)
-        uint64_t heartbeat = 0;   // Logical heartbeat (incremental sequence number)
-        uint64_t version = 0;     // Version number (version++ on each local update)
-        time_point seen_time{};   // The last time this node's message was received
-        node_status status = node_status::unknown;
-
-        // Business extension fields
-        std::string role;  // "master", "replica"
-        std::string region;// "us-east-1"
-        std::map<std::string, std::string> metadata;
-
-        // Suspicion mechanism fields
-        int suspicion_count = 0;
-        time_point last_suspected{};
+        uint64_t heartbeat = 0;
+        uint64_t config_epoch = 0;
+        uint32_t state_hash = 0;// state_hash() of the view; heartbeat 0 requests the full view instead
 
-        // Comparison operators
-        bool operator==(const node_view &other) const noexcept {
+        bool operator==(const node_digest &other) const noexcept {
             return id == other.id &&
-                   ip == other.ip &&
-                   port == other.port &&
-                   config_epoch == other.config_epoch &&
                    heartbeat == other.heartbeat &&
-                   version == other.version &&
-                   seen_time == other.seen_time &&
-                   status == other.status &&
-                   role == other.role &&
-                   region == other.region &&
-                   metadata == other.metadata &&
-                   suspicion_count == other.suspicion_count &&
-                   last_suspected == other.last_suspected;
+                   config_epoch == other.config_epoch &&
+                   state_hash == other.state_hash;
         }
 
-        bool operator!=(const node_view &other) const noexcept {
+        bool operator!=(const node_digest &other) const noexcept {
             return !(*this == other);
         }
-
-        // Comparison: used to determine if an update is needed
-        bool newer_than(const node_view &other) const noexcept;
-
-        // For master-slave failover
-        bool can_replace(const node_view &other) const noexcept;
     };
 
     // ---------------------------------------------------------
-    // Gossip message types
+    // Merkle tree node hash, exchanged by anti-entropy sessions
     // ---------------------------------------------------------
 
-    enum class message_type : uint8_t {
-        ping = 0,
-        pong,
-        meet,
-        join, // Explicit join
-        leave,// Explicit leave
-        update
-    };
+    struct merkle_hash {
+        uint32_t index = 0;// Tree node (see merkle_tree)
+        uint64_t hash = 0;
 
+        bool operator==(const merkle_hash &other) const noexcept {
+            return index == other.index && hash == other.hash;
+        }
+
+        bool operator!=(const merkle_hash &other) const noexcept {
+            return !(*this == other);
+        }
+    };
 
     // ---------------------------------------------------------
     // Gossip message: used for information exchange between nodes
@@ -164,13 +143,19 @@ namespace libgossip {
         message_type type = message_type::ping;
         uint64_t timestamp = 0;        // Usually the sender's heartbeat
         std::vector<node_view> entries;// Carried node information (0~N nodes)
+        std::vector<node_digest> digests;// Digest reconciliation (dissemination_mode::digest_sync)
+        std::vector<merkle_hash> tree;   // Anti-entropy (sync_tree, sync_bucket)
+        std::vector<group_summary> groups;// Hierarchical: group directory (group_sync) or its recent changes
 
         // Comparison operators
         bool operator==(const gossip_message &other) const noexcept {
             return sender == other.sender &&
                    type == other.type &&
                    timestamp == other.timestamp &&
-                   entries == other.entries;
+                   entries == other.entries &&
+                   digests == other.digests &&
+                   tree == other.tree &&
+                   groups == other.groups;
         }
 
         bool operator!=(const gossip_message &other) const noexcept {
@@ -182,36 +167,71 @@ namespace libgossip {
     // Callback function types
     // ---------------------------------------------------------
 
-    /// Send message callback: core requests to send a message to target node
+    /// Send message callback: core requests to send a message to target node.
+    /// The message is only valid during the call; the core reuses its buffers.
     using send_callback = std::function<void(const gossip_message &, const node_view &target)>;
 
-    /// Event notification callback: node status changes
+    /// Event notification callback: node status changes.
+    /// Called without the core's mutex held (see event_delivery), so it may call back into the core.
     using event_callback = std::function<void(const node_view &, node_status old_status)>;
 
+    /// Batch event callback: the net changes of one batch of events, one per node
+    using batch_event_callback = std::function<void(const std::vector<membership_change> &)>;
+
     // ---------------------------------------------------------
     // Statistics
     // ---------------------------------------------------------
 
     struct gossip_stats {
         size_t known_nodes = 0;
+        int gossip_nodes = 0;              // Pings per tick (adaptive_fanout: derived from known_nodes)
+        int sync_nodes = 0;                // Entries per message besides self
         size_t sent_messages = 0;
         size_t received_messages = 0;
         duration_ms last_tick_duration = duration_ms(0);
+        size_t indirect_probes_sent = 0;   // ping_req messages sent
+        size_t indirect_probe_rescues = 0; // Escalations cancelled by a relayed ack (false failures prevented)
+        size_t indirect_probe_timeouts = 0;// Probe rounds without an ack, node escalated
+        size_t anti_entropy_sessions = 0;  // Merkle sync sessions started
+        size_t anti_entropy_buckets = 0;   // Differing leaf buckets reconciled
+        size_t events_delivered = 0;       // Event callbacks made
+        size_t events_dropped = 0;         // Events lost to event queue overflow
+        size_t event_batches = 0;          // Batch callbacks made
+        size_t metadata_requests = 0;      // Full views asked for after a metadata delta we could not apply
+        size_t metadata_rejected = 0;      // Metadata updates over the size limit, not applied
+        size_t nodes_evicted = 0;          // Members displaced by a newcomer at max_nodes
+        size_t nodes_rejected = 0;         // Newcomers refused at max_nodes
+        size_t tombstones = 0;             // Failed and left members retained, not in known_nodes
+        uint32_t local_health = 0;         // Local health score; timeouts are scaled by local_health + 1
+        size_t groups = 0;                 // Hierarchical: groups in the directory, ours included
+        bool representative = false;       // Hierarchical: we represent our group
+        size_t event_queue_depth = 0;      // Events waiting for delivery
+        size_t event_queue_peak = 0;       // Highest event_queue_depth so far
+        std::chrono::microseconds event_latency_avg{0};// Queued -> callback, mean
+        std::chrono::microseconds event_latency_max{0};// Queued -> callback, worst
     };
 
     // ---------------------------------------------------------
-    // Clock policy (replaceable, for testing)
+    // Clock policy (replaceable, for testing and simulation)
+    // Every core in the process reads the same source: steady_clock unless
+    // a source is installed, e.g. the virtual clock of sim::simulator.
     // ---------------------------------------------------------
 
-    struct clock {
-        static time_point now() {
-            return std::chrono::steady_clock::now();
-        }
+    struct LIBGOSSIP_API clock {
+        using source = time_point (*)();
+
+        static time_point now() noexcept;
+
+        /// Install a time source (nullptr restores steady_clock). Install it
+        /// before creating cores and keep it while any core is in use.
+        static void set_source(source fn) noexcept;
     };
 
     // ---------------------------------------------------------
     // Gossip core class
-    // Thread safety must be guaranteed by upper layer (single-threaded driver model)
+    // Mutating calls are serialized by an internal mutex. Readers (snapshot(),
+    // get_nodes(), find_node(), size(), get_stats()) do not take it: they read
+    // the immutable membership_snapshot published after every mutating call.
     // ---------------------------------------------------------
 
     class LIBGOSSIP_API gossip_core {
@@ -221,6 +241,12 @@ namespace libgossip {
                              send_callback sender,
                              event_callback event_handler);
 
+        /// Constructor with explicit tunables
+        gossip_core(node_view self,
+                    send_callback sender,
+                    event_callback event_handler,
+                    const gossip_core_options &options);
+
         /// Destructor
         ~gossip_core() = default;
 
@@ -259,60 +285,372 @@ namespace libgossip {
         /// Get self node view
         const node_view &self() const noexcept { return self_; }
 
-        /// Get all currently known nodes (excluding self)
+        /// Get the options this core was created with
+        const gossip_core_options &options() const noexcept { return options_; }
+
+        /// Current membership snapshot: one atomic load, no lock, no copies.
+        /// Reflects every mutating call that returned before this one started.
+        std::shared_ptr<const membership_snapshot> snapshot() const noexcept {
+            return std::atomic_load(&snapshot_);
+        }
+
+        /// Get all currently known nodes (excluding self), copied from the snapshot
         std::vector<node_view> get_nodes() const;
 
-        /// Find node by ID
+        /// Find node by ID, copied from the snapshot
         std::optional<node_view> find_node(const node_id_t &id) const;
 
+        /// Tombstone of a failed or left node (its last view, without
+        /// metadata), retained until cleanup_expired() drops it. Dead nodes
+        /// are never returned by get_nodes() or find_node().
+        /// @note Takes the core's mutex
+        std::optional<node_view> find_tombstone(const node_id_t &id) const;
+
         /// Get node count
-        size_t size() const noexcept { return nodes_.size(); }
+        size_t size() const noexcept { return snapshot()->size(); }
+
+        /// Hierarchical mode: the summary of every group we know, ours included
+        /// @note Takes the core's mutex
+        std::vector<group_summary> get_groups() const;
 
-        /// Clean up expired nodes (optional call)
+        /// Suspicion level of a node according to the configured failure detector
+        /// (elapsed / timeout for the timeout detector, phi for phi-accrual)
+        std::optional<double> suspicion_level(const node_id_t &id) const;
+
+        /// Clean up expired nodes (optional call): tombstones buried more than
+        /// timeout ago, and joining or suspect members not heard from for as long
         void cleanup_expired(duration_ms timeout);
 
         /// Reset core state (for testing or restart)
         void reset();
 
-        /// Get statistics
+        /// Get statistics (without the core's mutex, the counters are atomics)
         gossip_stats get_stats() const;
 
+        /// Deliver the queued events to the event callback, in order. Called
+        /// automatically after each mutating call with event_delivery::after_unlock;
+        /// with event_delivery::manual the application calls it (any thread).
+        /// Returns at once if another thread (or a callback up the stack) is delivering.
+        /// @return Number of events delivered by this call
+        size_t dispatch_events();
+
+        /// Opt in to batched events: each dispatch (one per mutating call with
+        /// event_delivery::after_unlock, one per dispatch_events() call with
+        /// event_delivery::manual) makes a single callback with one
+        /// membership_change per node, instead of calling the event callback
+        /// once per event. Pass nullptr to go back to per-event delivery.
+        void set_batch_event_callback(batch_event_callback callback);
+
         /// Update self metadata (thread-safe, can be called from any thread)
         /// @param metadata Map of key-value pairs to update in self node's metadata
+        /// @return false, changing nothing, if the metadata would exceed
+        ///         gossip_core_options::metadata_size_limit
         /// @note This allows dynamic updates to self node's metadata without requiring node status change
-        void update_self_metadata(const std::map<std::string, std::string> &metadata) noexcept;
+        bool update_self_metadata(const std::map<std::string, std::string> &metadata) noexcept;
 
     private:
         // ---------------------------------------------------------
         // Private methods
         // ---------------------------------------------------------
 
-        /// Randomly select up to k nodes (excluding self and optional exclude)
-        std::vector<node_view> select_random_peers(int k, const node_id_t *exclude = nullptr) const;
+        /// handle_message() body, called with mutex_ held
+        void process_message(const gossip_message &msg, time_point recv_time);
+
+        /// Publish a new snapshot if anything changed since the last one (mutex_ held)
+        void publish_snapshot();
+
+        /// dispatch_events() if delivery is after_unlock and events are waiting (mutex_ released)
+        void deliver_events();
 
-        /// Update local perception of a node
-        node_view &update_node(const node_view &remote, time_point seen_time);
+        /// dispatch_events() helpers: drain the queue one callback per event, or as one batch
+        size_t deliver_each();
+        size_t deliver_batch(const batch_event_callback &callback);
 
-        /// Trigger event
+        /// Account the queue-to-callback latency of an event
+        void record_event_latency(time_point queued_at);
+
+        /// Randomly select up to k distinct nodes (excluding self and optional exclude).
+        /// O(k): samples dense table positions without copying any node_view.
+        /// @param out Receives the handles; cleared first, capacity is reused
+        void select_random_peers(int k, const node_id_t *exclude, std::vector<node_handle> &out);
+
+        /// select_random_peers() for probe targets, anti-entropy partners and
+        /// ping_req helpers: with region_aware, each pick is a member of
+        /// another region with probability cross_region_fraction and of our
+        /// own otherwise (the other group fills in when one runs short). O(k).
+        void select_peers_by_region(int k, const node_id_t *exclude, std::vector<node_handle> &out);
+
+        /// Append self plus, depending on the dissemination mode, up to sync_nodes_
+        /// random peers or max_piggyback_entries queued broadcasts (never target).
+        /// digest_sync appends the digests of self and sync_nodes_ random peers instead.
+        /// Every mode also carries up to max_piggyback_entries recent tombstones,
+        /// each in at most retransmit_limit() messages.
+        /// Metadata goes out as deltas unless full_metadata is set or target's
+        /// view carries no metadata_version (it would replace its map with them).
+        void append_gossip_entries(gossip_message &msg, const node_id_t &target, bool full_metadata = false);
+
+        /// Digest of a view as we know it
+        static node_digest make_digest(const node_view &node) noexcept;
+
+        /// Reconcile the digests of msg against our views. Heartbeat-only
+        /// advances are applied in place; reply receives the full views the
+        /// sender is behind on (or requested) and, if request_views, requests
+        /// (all-zero digests) for the views we are behind on.
+        void reconcile_digests(const gossip_message &msg, time_point recv_time, bool request_views,
+                               gossip_message &reply);
+
+        /// Pick up to k distinct ping targets according to the configured scheduler
+        void select_probe_targets(int k, std::vector<node_handle> &out);
+
+        /// Round-robin scheduler: take up to k live, non-failed members from the probe order
+        void next_round_robin_targets(int k, std::vector<node_handle> &out);
+
+        /// Round-robin scheduler: place a new member at a random not-yet-probed position
+        void schedule_new_member(node_handle handle);
+
+        /// Insert a node into the table and the probe order; an invalid
+        /// handle if the table is at max_nodes and nobody may make room
+        node_handle add_node(const node_view &node);
+
+        /// Below max_nodes, or evicted a member of a lower class than node
+        bool make_room(const node_view &node);
+
+        /// adaptive_fanout: derive gossip_nodes_ and sync_nodes_ from the
+        /// cluster size and the tick budget, O(1) after every join and leave
+        void adapt_fanout();
+
+        /// Eviction class of a node: suspect, then live by region priority
+        uint32_t eviction_class(const node_view &node) const noexcept;
+
+        /// Remove a node from the table and disarm its timers
+        void erase_node(node_handle handle);
+
+        /// Move a node that failed or left from the table to the tombstones
+        void bury(node_handle handle, time_point died);
+
+        /// Whether a node belongs in our table: with hierarchical, members of our group only
+        bool in_group(const node_view &node) const noexcept {
+            return !options_.hierarchical || node.region == self_.region;
+        }
+
+        /// Whether a node may represent our group (representative_role, if set)
+        bool eligible_representative(const node_view &node) const noexcept;
+
+        /// Hierarchical: O(1) update of the representative after node changed;
+        /// losing the current one leaves the election to elect_representative()
+        void consider_representative(const node_view &node);
+
+        /// Hierarchical: lowest-ID online eligible member, self included. O(N),
+        /// run from tick() only after the representative was lost.
+        void elect_representative();
+
+        /// Hierarchical tick step: take over or step down as representative,
+        /// refresh our group's summary and push the directory to another group
+        void run_group_sync();
+
+        /// Merge received summaries; a representative defends its own term
+        void merge_groups(const std::vector<group_summary> &groups, time_point recv_time);
+
+        /// Remember a member of another group as its contact, and send it our directory
+        void introduce_group(const node_view &node);
+
+        /// Send our directory to a member of another group
+        void send_group_sync(message_type type, const node_view &target);
+
+        /// Re-arm the timers of a node after its status or timestamps changed:
+        /// failure detection while online or suspect, expiry while not online.
+        /// Also refreshes the node's Merkle tree entry.
+        void track_node(node_handle handle);
+
+        /// Before escalating a node (online -> suspect, suspect -> failed), ask
+        /// indirect_probes members to ping it for us.
+        /// @return true if the escalation must wait for a probe round in flight
+        bool defer_escalation(node_handle handle, const node_view &node, time_point now);
+
+        /// Helper side of an indirect probe: ping the target, remember who asked
+        void handle_ping_req(const gossip_message &msg, const node_view &requester, time_point recv_time);
+
+        /// Requester side: a helper reached the target, cancel its escalation
+        void handle_indirect_ack(const gossip_message &msg, time_point recv_time);
+
+        /// Relay an ack to everyone who asked us to probe target
+        void complete_probe_relays(const node_id_t &target);
+
+        /// Start the next outgoing message in out_. Its entries are left for the
+        /// caller to overwrite (append_gossip_entries) or clear.
+        gossip_message &begin_message(message_type type);
+
+        /// Build a ping to target carrying self plus sync_nodes_ extras (in out_)
+        const gossip_message &make_ping(const node_id_t &target);
+
+        /// Start a Merkle anti-entropy session: send our root to peer
+        void start_anti_entropy(const node_view &peer);
+
+        /// Compare the peer's tree hashes with ours: reply with the children of
+        /// differing interior nodes (sync_tree) and the digests of differing leaves (sync_bucket)
+        void handle_sync_tree(const gossip_message &msg, const node_view &peer);
+
+        /// Reconcile the digests of differing leaves and send the peer what it
+        /// is missing, plus requests for what we are missing (update)
+        void handle_sync_bucket(const gossip_message &msg, const node_view &peer, time_point recv_time);
+
+        /// Append our digests of a leaf bucket
+        void append_bucket_digests(uint32_t leaf, std::vector<node_digest> &out) const;
+
+        /// Detector deadline of an online node, stretched by the local health multiplier
+        time_point suspect_deadline(node_handle handle, const node_view &node) const noexcept;
+
+        /// Failure detection: check the online/suspect nodes whose deadline passed
+        void run_failure_timers(time_point now);
+
+        /// Timer wheel tick of a time point
+        static int64_t wheel_tick(time_point t) noexcept {
+            return std::chrono::duration_cast<duration_ms>(t.time_since_epoch()).count() /
+                   config::DEFAULT_TIMER_WHEEL_RESOLUTION_MS;
+        }
+
+        /// Update local perception of a node; nullptr if it is new and was not admitted
+        node_view *update_node(const node_view &remote, time_point seen_time);
+
+        /// Take an untracked view's metadata map if it differs and fits the size limit
+        bool replace_metadata(node_view &current, const node_view &remote);
+
+        /// Merge a tracked view's metadata (full or delta); a delta we cannot
+        /// apply makes us ask the sender for the full view
+        bool merge_metadata(node_view &current, const node_view &remote);
+
+        /// Ask the sender of the message being handled for a node's full view
+        void request_full_view(const node_id_t &id);
+
+        /// Append the full view requests of the message being handled (digests with heartbeat 0)
+        void append_view_requests(gossip_message &reply) const;
+
+        /// Queue an event for delivery (and the change for dissemination)
         void notify(const node_view &node, node_status old_status);
 
+        /// Broadcasts are sent retransmit_mult * ceil(log10(N + 1)) times
+        uint32_t retransmit_limit() const noexcept;
+
         node_status old_status_of(node_view &current, const gossip_message &msg);
 
     private:
+        gossip_core_options options_;
         node_view self_;
-        std::list<node_view> nodes_;// All known nodes
+        membership_table nodes_;   // Live (not failed) nodes, indexed by ID
+        tombstone_store tombstones_;// Failed and left nodes, by time of death
+        std::vector<const node_view *> obituaries_;// Scratch: tombstones piggybacked on one message
+
+        // Capacity: eviction order of the members and the region ranks behind it.
+        // pinned_ is the sender of the message being handled, never evicted.
+        eviction_index eviction_;
+        std::vector<interned_string> region_priorities_;
+        node_handle pinned_;
+        region_index regions_;// region_aware only: members in our region and in the others
+
+        // Hierarchical mode: the table holds our group only, the directory one
+        // summary per group. representative_ is the lowest-ID online eligible
+        // member (maybe self); a lost one is re-elected on the next tick.
+        group_directory groups_;
+        node_id_t representative_{};
+        bool has_representative_ = false;
+        bool representative_lost_ = false;
+        bool representing_ = false;// We are the representative and own our group's summary
+        uint64_t group_term_ = 0;   // Term of our group's summary while representing_
+        uint64_t group_version_ = 0;
         send_callback send_fn_;
         event_callback event_fn_;
 
+        // Effective protocol parameters, initialized from options_ (and
+        // kept up to date by adapt_fanout() with adaptive_fanout)
         duration_ms heartbeat_interval_ = std::chrono::milliseconds(config::DEFAULT_HEARTBEAT_INTERVAL_MS);
         duration_ms failure_timeout_ = std::chrono::milliseconds(config::DEFAULT_FAILURE_TIMEOUT_MS);
         int gossip_nodes_ = config::DEFAULT_GOSSIP_NODES;
         int sync_nodes_ = config::DEFAULT_SYNC_NODES;
-
-        // Statistics
-        size_t sent_messages_ = 0;
-        size_t received_messages_ = 0;
-        duration_ms last_tick_duration_ = duration_ms(0);
+        std::unique_ptr<failure_detector> detector_;// Decides when an online node becomes suspect
+        local_health health_;                       // Scales the timeouts while we are the slow one
+
+        // Peer selection
+        xoshiro256ss rng_;                   // Seeded once per core
+        std::vector<node_handle> targets_;   // Scratch buffers reused across calls
+        std::vector<node_handle> extras_;
+        gossip_message out_;                 // Pings, pongs and updates are built here, so
+                                             // a steady-state tick does not allocate
+        std::vector<node_id_t> view_requests_;// Metadata deltas of the message being handled
+                                             // that need the full view
+
+        // Round-robin probe order (probe_scheduler::round_robin only).
+        // Erased members leave stale handles behind, dropped at the next reshuffle.
+        std::vector<node_handle> probe_order_;
+        size_t probe_cursor_ = 0;
+
+        // Deadlines, keyed by table slot. Timers may fire early; the node's
+        // actual state is re-checked and the timer re-armed if needed.
+        timer_wheel failure_timers_{config::DEFAULT_TIMER_WHEEL_BUCKETS};// Online: detector deadline, suspect: last_suspected + timeout
+        timer_wheel expiry_timers_{config::DEFAULT_TIMER_WHEEL_BUCKETS}; // Joining or suspect: seen_time, for cleanup_expired
+
+        // Changes waiting to be piggybacked (dissemination_mode::broadcast_queue only)
+        broadcast_queue broadcasts_;
+        std::vector<node_handle> piggyback_;// Scratch for the entries of one message
+
+        // Indirect probing (SWIM ping-req); both lists are short-lived and small
+        struct pending_probe {
+            node_handle target;
+            time_point deadline;// Escalate if no ack arrived by then
+        };
+        struct probe_relay {
+            node_id_t target;
+            node_id_t requester;
+            time_point deadline;
+        };
+        std::vector<pending_probe> pending_probes_;// Probes we requested
+        std::vector<probe_relay> probe_relays_;    // Probes we perform for others
+        std::vector<node_handle> helpers_;          // Scratch for picking ping_req helpers
+
+        // Merkle anti-entropy, only allocated if anti_entropy_interval_ms > 0.
+        // Tree keys are table slot + 1; key 0 is self.
+        std::unique_ptr<merkle_tree> tree_;
+        time_point last_anti_entropy_{};
+        bool heal_sync_started_ = false;// A heal-triggered session was started this tick
+
+        // Statistics, written under mutex_ and read without it
+        std::atomic<int> gossip_nodes_stat_{0};
+        std::atomic<int> sync_nodes_stat_{0};
+        std::atomic<size_t> sent_messages_{0};
+        std::atomic<size_t> received_messages_{0};
+        std::atomic<duration_ms> last_tick_duration_{duration_ms(0)};
+        std::atomic<size_t> indirect_probes_sent_{0};
+        std::atomic<size_t> indirect_probe_rescues_{0};
+        std::atomic<size_t> indirect_probe_timeouts_{0};
+        std::atomic<size_t> anti_entropy_sessions_{0};
+        std::atomic<size_t> anti_entropy_buckets_{0};
+        std::atomic<size_t> metadata_requests_{0};
+        std::atomic<size_t> metadata_rejected_{0};
+        std::atomic<size_t> nodes_evicted_{0};
+        std::atomic<size_t> nodes_rejected_{0};
+        std::atomic<size_t> tombstone_count_{0};
+        std::atomic<uint32_t> local_health_score_{0};
+        std::atomic<size_t> groups_stat_{0};
+        std::atomic<bool> representative_stat_{false};
+
+        // Events, queued under mutex_ and delivered without it. events_mutex_
+        // only guards events_; dispatching_ admits one dispatcher at a time.
+        event_queue events_;
+        batch_event_callback batch_fn_;// Guarded by events_mutex_
+        std::mutex events_mutex_;
+        std::atomic<bool> dispatching_{false};
+        queued_event dispatch_slot_;// Reused by the dispatcher
+        change_batch batch_;        // Reused by the dispatcher
+        std::atomic<size_t> event_queue_depth_{0};
+        std::atomic<size_t> event_queue_peak_{0};
+        std::atomic<size_t> events_dropped_{0};
+        std::atomic<size_t> events_delivered_{0};
+        std::atomic<size_t> event_batches_{0};
+        std::atomic<int64_t> event_latency_total_us_{0};
+        std::atomic<int64_t> event_latency_max_us_{0};
+
+        // Lock-free readers: snapshot_ is only accessed with std::atomic_load/atomic_store
+        membership_publisher publisher_;
+        std::shared_ptr<const membership_snapshot> snapshot_;
 
         // Thread safety
         mutable std::mutex mutex_;
@@ -76,6 +76,14 @@ enum class cluster_event : uint8_t {
  */
 using cluster_event_callback = std::function<void(const node_view&, node_status, node_status)>;
 
+/**
+ * @brief Batch event callback type
+ *
+ * Receives the net membership changes of one batch, at most one per node
+ * (see gossip_core::set_batch_event_callback).
+ */
+using cluster_batch_event_callback = std::function<void(const std::vector<membership_change>&)>;
+
 /**
  * @brief High-level wrapper for libgossip
  *
@@ -190,8 +198,10 @@ public:
      * Thread-safe: can be called from any thread.
      *
      * @param metadata Key-value pairs to update
+     * @return false if not initialized, or if the update would exceed
+     *         gossip_config::metadata_size_limit (nothing is changed then)
      */
-    void update_metadata(const std::map<std::string, std::string>& metadata) noexcept;
+    bool update_metadata(const std::map<std::string, std::string>& metadata) noexcept;
 
     // ========== Events ==========
 
@@ -202,6 +212,17 @@ public:
      */
     void set_event_callback(cluster_event_callback callback) noexcept;
 
+    /**
+     * @brief Set a batch event callback, replacing per-event delivery
+     *
+     * Each batch holds the net changes since the previous one: per received
+     * message by default, per tick() with gossip_config::batch_events_per_tick.
+     * Pass nullptr to go back to the per-event callback.
+     *
+     * @param callback Function to call with each batch of changes
+     */
+    void set_batch_event_callback(cluster_batch_event_callback callback) noexcept;
+
     // ========== Statistics ==========
 
     /**
@@ -212,6 +233,8 @@ public:
         size_t sent_messages = 0;
         size_t received_messages = 0;
         int64_t last_tick_duration_ms = 0;
+        uint64_t frames_sent = 0;    ///< Messages handed to the transport
+        uint64_t datagrams_sent = 0; ///< Datagrams they went out in (UDP only)
     };
 
     /**
@@ -233,6 +256,7 @@ private:
     // Internal callbacks
     void on_send_message(const gossip_message& msg, const node_view& target) noexcept;
     void on_node_event(const node_view& node, node_status old_status) noexcept;
+    void install_batch_event_callback() noexcept;
 
     // Configuration
     gossip_config config_;
@@ -250,6 +274,7 @@ private:
     cluster_event_callback event_callback_;
     std::atomic<bool> event_callback_set_{false};
     mutable std::mutex event_callback_mutex_;
+    cluster_batch_event_callback batch_event_callback_; // Guarded by event_callback_mutex_
 };
 
 } // namespace libgossip
@@ -0,0 +1,102 @@
+/**
+ * @file group_directory.hpp
+ * @brief Summaries of the groups of a hierarchical cluster
+ *
+ * In hierarchical mode a member holds the full state of its own group
+ * (region) only. Every other group is known by one group_summary: its
+ * representative, how many live members it has, and a (term, version) pair
+ * that orders summaries. A newly elected representative starts a new term;
+ * within a term the representative bumps the version when its summary
+ * changes. Representatives exchange their directories with each other, and
+ * every member piggybacks recently changed summaries on its pings within
+ * the group, the way broadcast_queue retransmits member changes. As a
+ * change is only retransmitted a few times, the representative's pings
+ * also cycle through the whole directory, repairing members that missed one.
+ *
+ * Clusters have tens of groups, not thousands, so the directory is a flat
+ * vector searched linearly.
+ *
+ * @note Not thread-safe; the owning gossip_core serializes access.
+ */
+
+#pragma once
+
+#include "config.hpp"
+#include "interned_string.hpp"
+#include "node_view.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace libgossip {
+
+    // ---------------------------------------------------------
+    // Group summary: what other groups know about a group
+    // ---------------------------------------------------------
+
+    struct group_summary {
+        interned_string group;     // node_view::region of its members
+        node_view representative;  // Contact for cross-group gossip (without metadata)
+        uint64_t term = 0;         // Bumped by every newly elected representative; 0: a seed, not yet heard from
+        uint64_t version = 0;      // Bumped by the representative when the summary changes
+        uint32_t members = 0;      // Live members, the representative included
+
+        /// Whether this summary supersedes other (same group): higher term, then higher version
+        bool newer_than(const group_summary &other) const noexcept {
+            return term != other.term ? term > other.term : version > other.version;
+        }
+
+        bool operator==(const group_summary &other) const noexcept {
+            return group == other.group &&
+                   representative == other.representative &&
+                   term == other.term &&
+                   version == other.version &&
+                   members == other.members;
+        }
+
+        bool operator!=(const group_summary &other) const noexcept {
+            return !(*this == other);
+        }
+    };
+
+    class LIBGOSSIP_API group_directory {
+    public:
+        /// Take summary if its group is unknown or it is newer than ours
+        /// @return true if it was taken (it will be piggybacked again)
+        bool merge(const group_summary &summary);
+
+        /// Summary of group, or nullptr
+        const group_summary *find(const interned_string &group) const noexcept;
+
+        /// Append up to max summaries sent fewer than limit times since they
+        /// last changed, counting this as one more transmission each
+        void take(size_t max, uint32_t limit, std::vector<group_summary> &out);
+
+        /// Append up to max summaries not already in out, continuing where the
+        /// previous call stopped, so repeated calls cycle through the directory
+        void rotate(size_t max, std::vector<group_summary> &out);
+
+        /// Append every summary
+        void append_all(std::vector<group_summary> &out) const;
+
+        /// Summary at position pos (0 <= pos < size())
+        const group_summary &at(size_t pos) const noexcept { return entries_[pos].summary; }
+
+        size_t size() const noexcept { return entries_.size(); }
+
+        void clear() noexcept {
+            entries_.clear();
+            cursor_ = 0;
+        }
+
+    private:
+        struct entry {
+            group_summary summary;
+            uint32_t transmits = 0;// Since the summary last changed
+        };
+
+        std::vector<entry> entries_;
+        size_t cursor_ = 0;// Next entry rotate() appends
+    };
+
+}// namespace libgossip
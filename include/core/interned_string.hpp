@@ -0,0 +1,118 @@
+/**
+ * @file interned_string.hpp
+ * @brief Pointer-sized handles to process-wide interned strings
+ *
+ * node_view's role and region take a handful of distinct values across a
+ * whole cluster, but used to be separate std::strings in every node and
+ * every copy of it. An interned_string is a pointer into an append-only,
+ * process-wide pool instead: copying one is a pointer copy, comparing two
+ * is a pointer compare, and each distinct value is stored once.
+ *
+ * The values come from peers, so the pool is capped (set_pool_limit(),
+ * config::DEFAULT_INTERN_POOL_LIMIT distinct strings by default). Past the
+ * cap a new value is not interned: the handle owns a private copy (tagged
+ * in the pointer's low bit), which is copied and compared like a
+ * std::string. Lookups share a reader lock; only adding a value is
+ * exclusive. Pool entries are never freed.
+ *
+ * interned_string converts to and from std::string and compares with
+ * strings and C strings, so code written against std::string fields
+ * (node.role = "master", node.role == "master", std::string r = node.role)
+ * keeps compiling.
+ */
+
+#pragma once
+
+#include "config.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <ostream>
+#include <string>
+#include <string_view>
+#include <utility>
+
+namespace libgossip {
+
+    class LIBGOSSIP_API interned_string {
+    public:
+        interned_string() noexcept = default;
+        interned_string(const std::string &text) : value_(intern(text)) {}
+        interned_string(std::string_view text) : value_(intern(text)) {}
+        interned_string(const char *text) : value_(intern(std::string_view(text ? text : ""))) {}
+
+        interned_string(const interned_string &other) : value_(other.owned() ? copy(other.value_) : other.value_) {}
+        interned_string(interned_string &&other) noexcept : value_(other.value_) { other.value_ = 0; }
+        interned_string &operator=(const interned_string &other) {
+            if (value_ != other.value_) {
+                interned_string copy(other);
+                std::swap(value_, copy.value_);
+            }
+            return *this;
+        }
+        interned_string &operator=(interned_string &&other) noexcept {
+            std::swap(value_, other.value_);
+            return *this;
+        }
+        ~interned_string() {
+            if (owned()) {
+                release(value_);
+            }
+        }
+
+        const std::string &str() const noexcept { return text(value_); }
+        operator const std::string &() const noexcept { return str(); }
+
+        const char *c_str() const noexcept { return str().c_str(); }
+        const char *data() const noexcept { return str().data(); }
+        size_t size() const noexcept { return str().size(); }
+        bool empty() const noexcept { return value_ == 0; }
+
+        /// Whether the value is a pool entry rather than a private copy
+        bool interned() const noexcept { return !owned(); }
+
+        /// Equal pooled strings are the same pool entry; private copies compare their text
+        friend bool operator==(const interned_string &a, const interned_string &b) noexcept {
+            return a.value_ == b.value_ || (((a.value_ | b.value_) & owned_bit) && a.str() == b.str());
+        }
+        friend bool operator!=(const interned_string &a, const interned_string &b) noexcept { return !(a == b); }
+        friend bool operator==(const interned_string &a, const std::string &b) noexcept { return a.str() == b; }
+        friend bool operator!=(const interned_string &a, const std::string &b) noexcept { return a.str() != b; }
+        friend bool operator==(const std::string &a, const interned_string &b) noexcept { return a == b.str(); }
+        friend bool operator!=(const std::string &a, const interned_string &b) noexcept { return a != b.str(); }
+        friend bool operator==(const interned_string &a, const char *b) noexcept { return a.str() == b; }
+        friend bool operator!=(const interned_string &a, const char *b) noexcept { return a.str() != b; }
+        friend bool operator==(const char *a, const interned_string &b) noexcept { return a == b.str(); }
+        friend bool operator!=(const char *a, const interned_string &b) noexcept { return a != b.str(); }
+
+        friend std::ostream &operator<<(std::ostream &os, const interned_string &s) { return os << s.str(); }
+
+        /// Number of distinct strings interned so far
+        static size_t pool_size();
+
+        /// Distinct strings the pool holds at most; values past it are not interned
+        static size_t pool_limit();
+        static void set_pool_limit(size_t limit);
+
+    private:
+        friend class ip_address;// Keeps a host name's handle in its address bytes
+
+        static constexpr uintptr_t owned_bit = 1;// std::string is at least 2-aligned
+
+        bool owned() const noexcept { return value_ & owned_bit; }
+
+        static const std::string &text(uintptr_t value) noexcept {
+            return value ? *reinterpret_cast<const std::string *>(value & ~owned_bit) : empty_string();
+        }
+
+        /// Pool entry of text, or a private copy tagged owned_bit past the pool limit; 0 for ""
+        static uintptr_t intern(const std::string &text);
+        static uintptr_t intern(std::string_view text);
+        static uintptr_t copy(uintptr_t value);
+        static void release(uintptr_t value) noexcept;
+
+        static const std::string &empty_string() noexcept;
+
+        uintptr_t value_ = 0;
+    };
+
+}// namespace libgossip
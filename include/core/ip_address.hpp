@@ -0,0 +1,122 @@
+/**
+ * @file ip_address.hpp
+ * @brief Binary node addresses
+ *
+ * node_view::ip used to be a std::string holding an address literal. An
+ * ip_address keeps IPv4 and IPv6 literals as 16 bytes (IPv4 as an
+ * IPv4-mapped IPv6 address) and anything else, such as a host name, as an
+ * interned_string, so a node's address is a 17-byte value that copies
+ * as bytes unless it is a host name past the intern pool's limit. Literals come back from str() in canonical form: dotted quad for
+ * IPv4, RFC 5952 for IPv6 ("0:0:0:0:0:0:0:1" reads back as "::1").
+ *
+ * Like interned_string it converts from and to std::string and compares
+ * with strings, so node.ip = "10.0.0.1" and node.ip == "10.0.0.1" keep
+ * compiling; str() returns the text.
+ */
+
+#pragma once
+
+#include "config.hpp"
+#include "interned_string.hpp"
+#include <array>
+#include <cstdint>
+#include <cstring>
+#include <ostream>
+#include <string>
+#include <string_view>
+#include <utility>
+
+namespace libgossip {
+
+    class LIBGOSSIP_API ip_address {
+    public:
+        enum class kind : uint8_t {
+            none,// Empty
+            v4,
+            v6,
+            host// Anything that is not an address literal, e.g. a host name
+        };
+
+        ip_address() noexcept = default;
+        ip_address(std::string_view text);
+        ip_address(const std::string &text) : ip_address(std::string_view(text)) {}
+        ip_address(const char *text) : ip_address(std::string_view(text ? text : "")) {}
+
+        // Bytes are copied as they are, except a host name past the intern pool's limit
+        ip_address(const ip_address &other) : bytes_(other.bytes_), kind_(other.kind_) {
+            if (owns_host()) {
+                set_host(interned_string::copy(host_value()));
+            }
+        }
+        ip_address(ip_address &&other) noexcept : bytes_(other.bytes_), kind_(other.kind_) {
+            other.kind_ = kind::none;
+            other.bytes_ = {};
+        }
+        ip_address &operator=(const ip_address &other) {
+            if (this != &other) {
+                ip_address copy(other);
+                std::swap(bytes_, copy.bytes_);
+                std::swap(kind_, copy.kind_);
+            }
+            return *this;
+        }
+        ip_address &operator=(ip_address &&other) noexcept {
+            std::swap(bytes_, other.bytes_);
+            std::swap(kind_, other.kind_);
+            return *this;
+        }
+        ~ip_address() {
+            if (owns_host()) {
+                interned_string::release(host_value());
+            }
+        }
+
+        kind type() const noexcept { return kind_; }
+        bool empty() const noexcept { return kind_ == kind::none; }
+
+        /// IPv6 address, IPv4-mapped (::ffff:a.b.c.d) for v4. Only meaningful for v4 and v6.
+        const std::array<uint8_t, 16> &bytes() const noexcept { return bytes_; }
+
+        /// The host name of a kind::host address, else empty
+        const std::string &host() const noexcept { return interned_string::text(kind_ == kind::host ? host_value() : 0); }
+
+        /// The address as text
+        std::string str() const;
+        operator std::string() const { return str(); }
+
+        friend bool operator==(const ip_address &a, const ip_address &b) noexcept {
+            return a.kind_ == b.kind_ && (a.bytes_ == b.bytes_ || ((a.owns_host() || b.owns_host()) && a.host() == b.host()));
+        }
+        friend bool operator!=(const ip_address &a, const ip_address &b) noexcept { return !(a == b); }
+        friend bool operator==(const ip_address &a, const std::string &b) { return a.str() == b; }
+        friend bool operator!=(const ip_address &a, const std::string &b) { return a.str() != b; }
+        friend bool operator==(const std::string &a, const ip_address &b) { return a == b.str(); }
+        friend bool operator!=(const std::string &a, const ip_address &b) { return a != b.str(); }
+        friend bool operator==(const ip_address &a, const char *b) { return a.str() == b; }
+        friend bool operator!=(const ip_address &a, const char *b) { return a.str() != b; }
+        friend bool operator==(const char *a, const ip_address &b) { return a == b.str(); }
+        friend bool operator!=(const char *a, const ip_address &b) { return a != b.str(); }
+
+        friend std::ostream &operator<<(std::ostream &os, const ip_address &ip) { return os << ip.str(); }
+
+        /// Parse a dotted-quad IPv4 address into out[0..3]
+        static bool parse_ipv4(std::string_view text, uint8_t *out) noexcept;
+
+        /// Parse an IPv6 address (with optional "::" and trailing dotted quad) into out[0..15]
+        static bool parse_ipv6(std::string_view text, uint8_t *out) noexcept;
+
+    private:
+        // kind::host keeps its interned_string's handle in the first bytes
+        uintptr_t host_value() const noexcept {
+            uintptr_t value;
+            std::memcpy(&value, bytes_.data(), sizeof(value));
+            return value;
+        }
+        void set_host(uintptr_t value) noexcept { std::memcpy(bytes_.data(), &value, sizeof(value)); }
+        bool owns_host() const noexcept { return kind_ == kind::host && (host_value() & interned_string::owned_bit); }
+
+        std::array<uint8_t, 16> bytes_{};
+        kind kind_ = kind::none;
+    };
+
+}// namespace libgossip
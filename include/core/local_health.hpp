@@ -0,0 +1,87 @@
+/**
+ * @file local_health.hpp
+ * @brief Lifeguard-style local health score
+ *
+ * A node whose own process is starved (CPU contention, GC or scheduler
+ * pauses) ticks late and handles messages late, and then blames its peers
+ * for the silence. The local health score measures how unwell we are
+ * ourselves: it rises on ticks that came a whole interval or more late, on
+ * pings that got no ack (or a late one) and on received messages that
+ * waited longer than an interval before being handled, and falls by one on
+ * every ping acked on time. gossip_core multiplies its failure timeouts,
+ * the time it waits for a probe's ack and the indirect probe timeout by
+ * score + 1 (Lifeguard's local health multiplier), so a slow node waits
+ * longer before suspecting anyone. The probe rate is left alone: a node
+ * that probed less would only look quieter to its peers.
+ *
+ * A max_score of 0 disables the score: every call is a no-op and the
+ * multiplier stays 1.
+ *
+ * @note Not thread-safe; the owning gossip_core serializes access.
+ */
+
+#pragma once
+
+#include "config.hpp"
+#include "membership_table.hpp"
+#include "node_view.hpp"
+#include <cstdint>
+#include <vector>
+
+namespace libgossip {
+
+    class LIBGOSSIP_API local_health {
+    public:
+        /// @param max_score Highest score, 0 disables local health
+        explicit local_health(uint32_t max_score = 0) noexcept : max_score_(max_score) {}
+
+        bool enabled() const noexcept { return max_score_ > 0; }
+
+        /// Current score, 0 (healthy) to max_score
+        uint32_t score() const noexcept { return score_; }
+
+        /// Factor applied to the timeouts: score + 1
+        uint32_t multiplier() const noexcept { return score_ + 1; }
+
+        /// A timeout scaled by the multiplier
+        duration_ms scale(duration_ms timeout) const noexcept { return timeout * multiplier(); }
+
+        /// A tick started at now; every whole interval missed since the
+        /// previous tick raises the score by one
+        void tick(time_point now, duration_ms interval);
+
+        /// A ping went out to target at sent
+        void probe_sent(node_handle target, time_point sent);
+
+        /// A reply from the node arrived. If we pinged it, an ack within
+        /// timeout lowers the score and a later one raises it.
+        void ack_received(node_handle from, time_point arrival, duration_ms timeout);
+
+        /// Pings sent before now - timeout and still unanswered raise the score once each
+        void expire_probes(time_point now, duration_ms timeout);
+
+        /// A received message was handled lag after it arrived: more than
+        /// limit means a receive backlog and raises the score, at most once per tick
+        void receive_lag(std::chrono::steady_clock::duration lag, duration_ms limit);
+
+        /// Back to healthy, nothing in flight
+        void clear() noexcept;
+
+    private:
+        void raise(uint32_t by) noexcept;
+        void lower() noexcept;
+
+        struct probe {
+            node_handle target;
+            time_point sent;
+        };
+
+        std::vector<probe> probes_;// Pings awaiting an ack, a few per tick
+        time_point last_tick_{};
+        bool ticked_ = false;
+        bool lag_counted_ = false;// A backlog was counted since the last tick
+        uint32_t score_ = 0;
+        uint32_t max_score_;
+    };
+
+}// namespace libgossip
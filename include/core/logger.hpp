@@ -16,6 +16,7 @@
 #undef ERROR
 #endif
 
+#include <atomic>
 #include <string>
 #include <fstream>
 #include <mutex>
@@ -67,21 +68,24 @@ public:
 
         log_file_path_ = log_file;
         log_file_.open(log_file, std::ios::app);
-        min_level_ = level;
+        min_level_.store(level, std::memory_order_relaxed);
     }
 
     void SetLevel(LogLevel level) {
-        std::lock_guard<std::mutex> lock(mutex_);
-        min_level_ = level;
+        min_level_.store(level, std::memory_order_relaxed);
     }
 
     LogLevel GetLevel() const {
-        std::lock_guard<std::mutex> lock(mutex_);
-        return min_level_;
+        return min_level_.load(std::memory_order_relaxed);
+    }
+
+    // Checked by the LIBGOSSIP_LOG macros before formatting the message
+    bool Enabled(LogLevel level) const {
+        return level >= min_level_.load(std::memory_order_relaxed);
     }
 
     void Log(LogLevel level, const std::string& message) {
-        if (level < min_level_) {
+        if (!Enabled(level)) {
             return;
         }
 
@@ -128,7 +132,7 @@ private:
 
     std::ofstream log_file_;
     std::string log_file_path_;
-    LogLevel min_level_;
+    std::atomic<LogLevel> min_level_;
     mutable std::mutex mutex_;
 };
 
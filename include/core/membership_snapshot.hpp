@@ -0,0 +1,117 @@
+/**
+ * @file membership_snapshot.hpp
+ * @brief Immutable, versioned copies of a gossip_core's membership for lock-free readers
+ *
+ * After every mutating call (tick, handle_message, meet, ...) the core
+ * publishes a membership_snapshot through an atomic shared_ptr. Readers load
+ * it once and then look nodes up or iterate without taking the core's mutex
+ * and without copying any node_view; a snapshot never changes once
+ * published, and stays alive for as long as a reader holds it.
+ *
+ * Publishing is incremental. Nodes are held by shared_ptr in chunks of 64
+ * table slots; a new snapshot shares every chunk and node it did not touch
+ * with the previous one, so the cost is one node copy per changed node plus
+ * one chunk copy per chunk containing a change. The ID index maps to table
+ * slots, which are stable, so it is only rebuilt when nodes are added,
+ * removed or re-keyed. A snapshot no reader holds any more is recycled for
+ * a later publish, so a publish that only changes the self view (as every
+ * tick does) allocates nothing.
+ */
+
+#pragma once
+
+#include "config.hpp"
+#include "membership_table.hpp"
+#include "node_view.hpp"
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace libgossip {
+
+    class LIBGOSSIP_API membership_snapshot {
+    public:
+        static constexpr uint32_t chunk_size = 64;
+
+        /// Incremented with every snapshot a core publishes
+        uint64_t version() const noexcept { return version_; }
+
+        /// The publishing node's own view
+        const node_view &self() const noexcept { return *self_; }
+
+        /// Number of known nodes (excluding self)
+        size_t size() const noexcept { return size_; }
+
+        /// Find a node (or self) by ID, nullptr if absent.
+        /// The pointer is valid for as long as the snapshot is held.
+        const node_view *find(const node_id_t &id) const noexcept;
+
+        /// Visit every known node (excluding self), in table slot order
+        template<typename Fn>
+        void for_each(Fn &&fn) const {
+            for (const auto &c: chunks_) {
+                if (!c) {
+                    continue;
+                }
+                for (const auto &node: *c) {
+                    if (node) {
+                        fn(static_cast<const node_view &>(*node));
+                    }
+                }
+            }
+        }
+
+    private:
+        friend class membership_publisher;
+
+        using chunk = std::array<std::shared_ptr<const node_view>, chunk_size>;
+
+        const node_view *at_slot(uint32_t index) const noexcept {
+            const uint32_t c = index / chunk_size;
+            return c < chunks_.size() && chunks_[c] ? (*chunks_[c])[index % chunk_size].get() : nullptr;
+        }
+
+        uint64_t version_ = 0;
+        size_t size_ = 0;
+        std::shared_ptr<node_view> self_;// Only written by the publisher, while nobody else holds it
+        std::vector<std::shared_ptr<const chunk>> chunks_;  // Indexed by table slot / chunk_size
+        std::shared_ptr<const std::vector<uint32_t>> index_;// Open addressing by hash_node_id(), slot + 1 (0 = empty)
+    };
+
+    /// Writer side: tracks what changed since the last snapshot and builds the next one.
+    /// @note Not thread-safe; the owning gossip_core serializes access.
+    class LIBGOSSIP_API membership_publisher {
+    public:
+        /// The node in table slot index was added, changed or removed
+        void mark(uint32_t index);
+
+        /// The self view changed
+        void mark_self() noexcept { self_dirty_ = true; }
+
+        /// Every node was removed (membership_table::clear)
+        void clear() noexcept;
+
+        /// Whether anything changed since the last publish()
+        bool pending() const noexcept { return self_dirty_ || cleared_ || !dirty_.empty(); }
+
+        /// Build the next snapshot from the table, sharing everything that did not change
+        std::shared_ptr<const membership_snapshot> publish(const membership_table &table, const node_view &self);
+
+    private:
+        void rebuild_index(const membership_table &table, membership_snapshot &next) const;
+
+        /// A previously published snapshot if no reader holds it any more, else a new one
+        std::shared_ptr<membership_snapshot> recycle();
+
+        std::shared_ptr<membership_snapshot> last_;
+        std::shared_ptr<membership_snapshot> spare_;        // Published before last_, recycled once unshared
+        std::vector<uint32_t> dirty_;                       // Slots changed since the last publish
+        std::vector<uint64_t> dirty_marks_;                 // Bitmap of dirty_, by slot
+        std::vector<membership_snapshot::chunk *> writable_;// Scratch: chunks copied in this publish
+        bool self_dirty_ = true;
+        bool cleared_ = false;
+    };
+
+}// namespace libgossip
@@ -0,0 +1,244 @@
+/**
+ * @file membership_table.hpp
+ * @brief Hash-indexed storage for the nodes known to a gossip_core
+ *
+ * Nodes are kept in fixed-size chunks of slots, so a node_view never moves
+ * once inserted and references stay valid until the node is erased. An
+ * open-addressing index (linear probing, backward-shift deletion) maps the
+ * 16-byte node_id_t to its slot, giving O(1) lookups without walking a list.
+ * A second index maps the binary ip:port endpoint to the slots bound to it,
+ * used to reconcile temporary IDs with real ones. A dense array of occupied
+ * slots supports compact iteration and O(1) access by position (used for
+ * random sampling).
+ *
+ * @note Not thread-safe; the owning gossip_core serializes access.
+ */
+
+#pragma once
+
+#include "config.hpp"
+#include "node_view.hpp"
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace libgossip {
+
+    /// Stable reference to a slot of a membership_table.
+    /// A handle is invalidated when its node is erased, even if the slot is reused.
+    struct node_handle {
+        static constexpr uint32_t invalid_index = 0xFFFFFFFFu;
+
+        uint32_t index = invalid_index;
+        uint32_t generation = 0;
+
+        bool valid() const noexcept { return index != invalid_index; }
+
+        bool operator==(const node_handle &other) const noexcept {
+            return index == other.index && generation == other.generation;
+        }
+
+        bool operator!=(const node_handle &other) const noexcept {
+            return !(*this == other);
+        }
+    };
+
+    /// Hash a node ID for table indexing (IDs are not assumed to be random)
+    LIBGOSSIP_API uint64_t hash_node_id(const node_id_t &id) noexcept;
+
+    /// Binary form of a node's ip:port, comparable without string compares
+    struct endpoint_key {
+        std::array<uint8_t, 16> address{};// IPv6, IPv4-mapped IPv6, or a digest of a host name
+        uint16_t port = 0;
+
+        bool operator==(const endpoint_key &other) const noexcept {
+            return port == other.port && address == other.address;
+        }
+
+        bool operator!=(const endpoint_key &other) const noexcept {
+            return !(*this == other);
+        }
+    };
+
+    /// Build the endpoint key of an address.
+    /// IPv4 and IPv6 addresses are used as is, so "10.0.0.1" and "::ffff:10.0.0.1"
+    /// map to the same key. Anything else (e.g. a host name) is digested.
+    LIBGOSSIP_API endpoint_key make_endpoint_key(const ip_address &ip, int port) noexcept;
+
+    /// Hash an endpoint key for table indexing
+    LIBGOSSIP_API uint64_t hash_endpoint(const endpoint_key &key) noexcept;
+
+    class LIBGOSSIP_API membership_table {
+    public:
+        membership_table() = default;
+        ~membership_table() = default;
+
+        membership_table(const membership_table &) = delete;
+        membership_table &operator=(const membership_table &) = delete;
+        membership_table(membership_table &&) noexcept = default;
+        membership_table &operator=(membership_table &&) noexcept = default;
+
+        /// Number of nodes stored
+        size_t size() const noexcept { return dense_.size(); }
+
+        bool empty() const noexcept { return dense_.empty(); }
+
+        /// Find a node by ID, returns an invalid handle if absent
+        node_handle find(const node_id_t &id) const noexcept;
+
+        /// Find a node bound to the endpoint for which pred(node) holds.
+        /// Several nodes may share an endpoint (e.g. a temporary and a real ID).
+        template<typename Pred>
+        node_handle find_by_endpoint(const endpoint_key &key, Pred &&pred) const {
+            if (endpoint_index_.buckets.empty()) {
+                return {};
+            }
+            const uint32_t hash = static_cast<uint32_t>(hash_endpoint(key));
+            const size_t mask = endpoint_index_.buckets.size() - 1;
+            for (size_t i = hash & mask;; i = (i + 1) & mask) {
+                const bucket &b = endpoint_index_.buckets[i];
+                if (b.slot == empty_bucket) {
+                    return {};
+                }
+                if (b.hash == hash) {
+                    const slot &s = slot_at(b.slot);
+                    if (s.endpoint == key && pred(static_cast<const node_view &>(s.node))) {
+                        return {b.slot, s.generation};
+                    }
+                }
+            }
+        }
+
+        /// Re-index the endpoint of a node after its ip or port was modified in place
+        void refresh_endpoint(node_handle h);
+
+        /// Resolve a handle, returns nullptr if the handle is stale
+        node_view *get(node_handle h) noexcept;
+        const node_view *get(node_handle h) const noexcept;
+
+        /// Insert a node whose ID is not yet present.
+        /// @return Handle of the new node, or an invalid handle if the ID already exists
+        node_handle insert(const node_view &node);
+
+        /// Remove a node, returns false if the handle is stale
+        bool erase(node_handle h) noexcept;
+
+        /// Change the ID of a stored node and re-index it.
+        /// @return false if the handle is stale or another node already owns new_id
+        /// @note Never assign node_view::id directly on a stored node, use this instead.
+        bool rekey(node_handle h, const node_id_t &new_id);
+
+        /// Remove all nodes (handles from before the call become stale)
+        void clear() noexcept;
+
+        /// Handle of the node at dense position pos (0 <= pos < size())
+        node_handle handle_at(size_t pos) const noexcept;
+
+        /// Handle of the node stored in slot index, or an invalid handle if the slot is free
+        node_handle handle_of(uint32_t index) const noexcept;
+
+        /// Slot indices handed out so far are below this bound (occupied or free)
+        uint32_t slot_count() const noexcept { return slot_count_; }
+
+        /// Dense position of a node, or size() if the handle is stale.
+        /// Positions change when other nodes are erased.
+        size_t position_of(node_handle h) const noexcept {
+            return get(h) ? slot_at(h.index).dense_pos : dense_.size();
+        }
+
+        /// Node at dense position pos (0 <= pos < size())
+        node_view &at(size_t pos) noexcept { return slot_at(dense_[pos]).node; }
+        const node_view &at(size_t pos) const noexcept { return slot_at(dense_[pos]).node; }
+
+        /// Visit every stored node. The table must not be modified during the visit.
+        template<typename Fn>
+        void for_each(Fn &&fn) {
+            for (uint32_t index: dense_) {
+                fn(slot_at(index).node);
+            }
+        }
+
+        template<typename Fn>
+        void for_each(Fn &&fn) const {
+            for (uint32_t index: dense_) {
+                fn(static_cast<const node_view &>(slot_at(index).node));
+            }
+        }
+
+        /// Find the first node matching pred, returns an invalid handle if none does
+        template<typename Pred>
+        node_handle find_if(Pred &&pred) const {
+            for (size_t pos = 0; pos < dense_.size(); ++pos) {
+                if (pred(static_cast<const node_view &>(slot_at(dense_[pos]).node))) {
+                    return handle_at(pos);
+                }
+            }
+            return {};
+        }
+
+        /// Erase every node matching pred, returns the number of erased nodes
+        template<typename Pred>
+        size_t erase_if(Pred &&pred) {
+            size_t erased = 0;
+            for (size_t pos = 0; pos < dense_.size();) {
+                // erase() moves the last dense entry into pos, so only advance on keep
+                if (pred(static_cast<const node_view &>(slot_at(dense_[pos]).node))) {
+                    erase(handle_at(pos));
+                    ++erased;
+                } else {
+                    ++pos;
+                }
+            }
+            return erased;
+        }
+
+    private:
+        static constexpr uint32_t chunk_shift = 6;// 64 slots: a small table does not reserve hundreds
+        static constexpr uint32_t chunk_size = 1u << chunk_shift;
+        static constexpr uint32_t empty_bucket = 0xFFFFFFFFu;
+
+        struct slot {
+            node_view node;
+            endpoint_key endpoint;
+            uint32_t generation = 0;
+            uint32_t dense_pos = 0;
+            bool occupied = false;
+        };
+
+        struct bucket {
+            uint32_t slot = empty_bucket;
+            uint32_t hash = 0;// Home position and tag, checked before touching the slot
+        };
+
+        /// Linear-probing index from a 32-bit hash to slot indices (duplicates allowed)
+        struct hash_index {
+            std::vector<bucket> buckets;// Size is zero or a power of two
+
+            void insert(uint32_t slot_index, uint32_t hash);
+            void erase(uint32_t slot_index, uint32_t hash) noexcept;
+            void clear() noexcept;
+        };
+
+        slot &slot_at(uint32_t index) noexcept {
+            return chunks_[index >> chunk_shift][index & (chunk_size - 1)];
+        }
+
+        const slot &slot_at(uint32_t index) const noexcept {
+            return chunks_[index >> chunk_shift][index & (chunk_size - 1)];
+        }
+
+        uint32_t allocate_slot();
+        void grow_indexes();
+
+        std::vector<std::unique_ptr<slot[]>> chunks_;
+        uint32_t slot_count_ = 0;     // Slots handed out so far (occupied or free)
+        std::vector<uint32_t> free_;  // Recycled slot indices
+        std::vector<uint32_t> dense_; // Occupied slot indices
+        hash_index id_index_;         // node_id_t -> slot
+        hash_index endpoint_index_;   // endpoint_key -> slots
+    };
+
+}// namespace libgossip
@@ -0,0 +1,105 @@
+/**
+ * @file merkle_tree.hpp
+ * @brief Incrementally maintained Merkle tree over the membership, for anti-entropy
+ *
+ * A fixed 16-ary tree of depth 3 (4096 leaf buckets), stored as an array in
+ * heap order: node 0 is the root and the children of node i are
+ * 16 * i + 1 ... 16 * i + 16. Members are bucketed by the top bits of
+ * hash_node_id(), so structured IDs spread as well as random ones.
+ *
+ * Each member contributes one 64-bit entry hash; a tree node's hash is the
+ * XOR of the entry hashes below it. Setting, changing or removing an entry
+ * therefore XORs the same delta into its leaf and every ancestor, O(depth)
+ * with no rehashing of siblings. Entries are keyed by a small integer (the
+ * owner maps table slots to keys) and linked intrusively into their leaf,
+ * so a bucket can be listed without scanning the membership.
+ *
+ * @note Not thread-safe; the owning gossip_core serializes access.
+ */
+
+#pragma once
+
+#include "config.hpp"
+#include "membership_table.hpp"
+#include "node_view.hpp"
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace libgossip {
+
+    class LIBGOSSIP_API merkle_tree {
+    public:
+        static constexpr uint32_t fanout = 16;
+        static constexpr uint32_t depth = 3;
+        static constexpr uint32_t leaf_count = 4096;// fanout ^ depth
+        static constexpr uint32_t first_leaf = 273; // 1 + 16 + 256
+        static constexpr uint32_t node_count = first_leaf + leaf_count;
+
+        /// Leaf bucket (tree node index) of a member
+        static uint32_t leaf_of(const node_id_t &id) noexcept {
+            return first_leaf + static_cast<uint32_t>(hash_node_id(id) >> 52);
+        }
+
+        static bool is_leaf(uint32_t index) noexcept { return index >= first_leaf; }
+
+        static uint32_t first_child(uint32_t index) noexcept { return index * fanout + 1; }
+
+        /// Hash a member contributes: its ID, config_epoch and state_hash().
+        /// The heartbeat is left out on purpose; it advances every tick and is
+        /// kept in sync by regular gossip, the tree only tracks membership and state.
+        static uint64_t entry_hash(const node_view &node) noexcept;
+
+        merkle_tree();
+
+        /// Set the entry of key (generation identifies the owner of a reused key)
+        void set(uint32_t key, uint32_t generation, const node_id_t &id, uint64_t hash);
+
+        /// Remove the entry of key, if any
+        void remove(uint32_t key) noexcept;
+
+        /// Remove every entry
+        void clear() noexcept;
+
+        /// Hash of a tree node (0 for an empty subtree)
+        uint64_t hash(uint32_t index) const noexcept { return hashes_[index]; }
+
+        uint64_t root() const noexcept { return hashes_[0]; }
+
+        /// Number of entries
+        size_t size() const noexcept { return entry_count_; }
+
+        /// Visit fn(key, generation) for every entry of a leaf bucket
+        template<typename Fn>
+        void for_each_in_leaf(uint32_t leaf, Fn &&fn) const {
+            for (uint32_t key = heads_[leaf - first_leaf]; key != nil; key = entries_[key].next) {
+                fn(key, entries_[key].generation);
+            }
+        }
+
+    private:
+        static constexpr uint32_t nil = 0xFFFFFFFFu;
+
+        struct entry {
+            uint64_t hash = 0;
+            uint32_t leaf = 0;
+            uint32_t generation = 0;
+            uint32_t prev = nil;
+            uint32_t next = nil;
+            bool present = false;
+        };
+
+        /// XOR delta into a leaf and all of its ancestors
+        void apply(uint32_t leaf, uint64_t delta) noexcept;
+
+        void link(uint32_t key) noexcept;
+        void unlink(uint32_t key) noexcept;
+
+        std::vector<uint64_t> hashes_;// Indexed by tree node
+        std::vector<uint32_t> heads_; // First entry of each leaf
+        std::vector<entry> entries_;  // Indexed by key
+        size_t entry_count_ = 0;
+    };
+
+}// namespace libgossip
@@ -0,0 +1,167 @@
+/**
+ * @file node_view.hpp
+ * @brief Node identity, status and view types shared by the gossip core
+ *
+ * These types used to live in gossip_core.hpp. They are split out so that
+ * supporting containers (e.g. membership_table) can depend on node_view
+ * without pulling in the full gossip_core class. gossip_core.hpp still
+ * includes this header, so existing code keeps compiling unchanged.
+ */
+
+#pragma once
+
+#include "config.hpp"
+#include "interned_string.hpp"
+#include "ip_address.hpp"
+#include "magic_enum/magic_enum.hpp"
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <map>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+namespace libgossip {
+
+    // ---------------------------------------------------------
+    // Basic type definitions
+    // ---------------------------------------------------------
+
+    /// Node unique ID, 16 bytes (e.g. UUID or MD5)
+    using node_id_t = std::array<uint8_t, 16>;
+
+    /// Time point type (using steady_clock)
+    using time_point = std::chrono::steady_clock::time_point;
+
+    /// Millisecond duration
+    using duration_ms = std::chrono::milliseconds;
+
+    // ---------------------------------------------------------
+    // Node status flags
+    // ---------------------------------------------------------
+
+    enum class node_status {
+        unknown = 0,
+        joining,// Joining
+        online, // Online
+        suspect,// Suspected offline (timeout)
+        failed  // Confirmed offline
+    };
+    template<typename E>
+    auto to_string(E value) -> std::enable_if_t<std::is_enum_v<E>, std::string> {
+        return std::string{magic_enum::enum_name(value)};
+    }
+
+    /// Outcome of node_view::merge_metadata()
+    enum class metadata_merge {
+        unchanged,// Nothing newer than what we have
+        changed,  // Applied, the metadata differs from before
+        gap,      // A delta starting after our version: the full view is needed
+        rejected  // Would exceed the size limit, not applied
+    };
+
+    // ---------------------------------------------------------
+    // Node view: summary information of each node in the cluster
+    // ---------------------------------------------------------
+
+    struct node_view {
+        node_id_t id{};
+        ip_address ip;// Binary; assign and compare it like a string, str() for the text
+        int port = 0;
+        uint64_t config_epoch = 0;// Configuration version (for master-slave election)
+        uint64_t heartbeat = 0;   // Logical heartbeat (incremental sequence number)
+        uint64_t version = 0;     // Version number (version++ on each local update)
+        time_point seen_time{};   // The last time this node's message was received
+        node_status status = node_status::unknown;
+
+        // Business extension fields
+        interned_string role;  // "master", "replica"
+        interned_string region;// "us-east-1"
+        std::map<std::string, std::string> metadata;
+        uint64_t metadata_version = 0;          // Bumped by the owner on every metadata change (0: not tracked)
+        uint64_t metadata_hash = 0;             // hash_metadata() of the full map as of metadata_version
+        std::vector<uint64_t> metadata_versions;// Per key in map order, the metadata_version that last
+                                                // wrote it; empty if all keys are at metadata_version
+        uint64_t metadata_since = 0;            // Gossiped deltas: metadata only holds the keys written
+                                                // after this version (0: the full map)
+
+        // Suspicion mechanism fields
+        int suspicion_count = 0;
+        time_point last_suspected{};
+
+        // Comparison operators
+        bool operator==(const node_view &other) const noexcept {
+            return id == other.id &&
+                   ip == other.ip &&
+                   port == other.port &&
+                   config_epoch == other.config_epoch &&
+                   heartbeat == other.heartbeat &&
+                   version == other.version &&
+                   seen_time == other.seen_time &&
+                   status == other.status &&
+                   role == other.role &&
+                   region == other.region &&
+                   metadata == other.metadata &&
+                   metadata_version == other.metadata_version &&
+                   metadata_hash == other.metadata_hash &&
+                   metadata_versions == other.metadata_versions &&
+                   metadata_since == other.metadata_since &&
+                   suspicion_count == other.suspicion_count &&
+                   last_suspected == other.last_suspected;
+        }
+
+        bool operator!=(const node_view &other) const noexcept {
+            return !(*this == other);
+        }
+
+        // Same as *this = other, but skips the metadata copy when
+        // same_metadata(other), and otherwise reuses this view's metadata
+        // nodes when both have the same keys
+        void assign(const node_view &other);
+
+        // Same as assign(), but leaves the metadata and its versions alone
+        void assign_without_metadata(const node_view &other);
+
+        // Same as assign(), but with only the keys other wrote after since.
+        // A delta that would hold every key is a full copy (metadata_since 0).
+        void assign_delta(const node_view &other, uint64_t since);
+
+        // Whether both views carry the same metadata: an integer compare when
+        // both are tracked (metadata_version != 0), else a map compare
+        bool same_metadata(const node_view &other) const;
+
+        // Record a change of metadata: bump metadata_version, recompute
+        // metadata_hash. Every key counts as written by the new version.
+        void stamp_metadata();
+
+        // Owner side: set the given keys and stamp only those whose value
+        // changed. Returns false, leaving the version alone, if none did.
+        bool set_metadata(const std::map<std::string, std::string> &values);
+
+        // metadata_version that last wrote the index-th key in map order
+        uint64_t metadata_key_version(size_t index) const noexcept;
+
+        // Receiver side: merge the metadata of a tracked view (full or
+        // delta, metadata_version != 0) key by key, newest version wins
+        metadata_merge merge_metadata(const node_view &remote, size_t size_limit);
+
+        // Comparison: used to determine if an update is needed
+        bool newer_than(const node_view &other) const noexcept;
+
+        // For master-slave failover
+        bool can_replace(const node_view &other) const noexcept;
+    };
+
+    /// 64-bit content hash of a metadata map
+    LIBGOSSIP_API uint64_t hash_metadata(const std::map<std::string, std::string> &metadata) noexcept;
+
+    /// Bytes of keys and values in a metadata map, as held against the size limit
+    LIBGOSSIP_API size_t metadata_bytes(const std::map<std::string, std::string> &metadata) noexcept;
+
+    /// Hash of what a digest does not carry: status, address, role, region
+    /// and metadata. Two views with the same heartbeat, config_epoch and
+    /// state_hash are treated as identical by digest reconciliation.
+    LIBGOSSIP_API uint32_t state_hash(const node_view &node) noexcept;
+
+}// namespace libgossip
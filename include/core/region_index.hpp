@@ -0,0 +1,62 @@
+/**
+ * @file region_index.hpp
+ * @brief Members split by whether they share our region
+ *
+ * Region-aware peer selection draws most peers from our own region and a
+ * fraction from the others. Scanning the table for either kind would be
+ * O(N) per draw, so the index keeps one dense handle array per group
+ * (local, remote) with each slot's position in it: a member moves between
+ * groups or leaves in O(1) by swapping with the last entry, and k distinct
+ * members of a group are sampled in O(k) like the table's own positions.
+ *
+ * @note Not thread-safe; the owning gossip_core serializes access.
+ */
+
+#pragma once
+
+#include "config.hpp"
+#include "membership_table.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace libgossip {
+
+    class LIBGOSSIP_API region_index {
+    public:
+        enum group : uint32_t {
+            local = 0,///< Same region as self
+            remote = 1///< Any other region
+        };
+
+        /// Put the node in group g, moving it if it was in the other one
+        void place(node_handle handle, group g);
+
+        /// Drop slot index, if present
+        void remove(uint32_t index) noexcept;
+
+        /// Drop everything
+        void clear() noexcept;
+
+        /// Number of members in group g
+        size_t size(group g) const noexcept { return members_[g].size(); }
+
+        /// Handle at position pos (0 <= pos < size(g)) of group g
+        node_handle at(group g, size_t pos) const noexcept { return members_[g][pos]; }
+
+        /// Position of the node in group g, or size(g) if it is not there
+        size_t position_of(node_handle handle, group g) const noexcept;
+
+    private:
+        static constexpr uint32_t nil = 0xFFFFFFFFu;
+
+        struct entry {
+            uint32_t group = nil;// nil: not present
+            uint32_t pos = 0;
+        };
+
+        std::vector<node_handle> members_[2];
+        std::vector<entry> entries_;// Indexed by table slot
+    };
+
+}// namespace libgossip
@@ -0,0 +1,102 @@
+/**
+ * @file timer_wheel.hpp
+ * @brief Hashed timer wheel for per-node deadlines
+ *
+ * Each timer is identified by a small integer id (a membership_table slot
+ * index) and carries the generation of the handle it was armed for. Timers
+ * are linked intrusively into the bucket of their deadline tick, so arming,
+ * moving and cancelling are O(1) and allocation-free once the per-id entry
+ * array has grown to the table size. Deadlines further away than one
+ * revolution simply stay in their bucket until the wheel comes round to
+ * their tick.
+ *
+ * Timers are lazy: the owner may leave a timer armed at a deadline earlier
+ * than the real one and re-check the actual state when it fires.
+ *
+ * @note Not thread-safe; the owning gossip_core serializes access.
+ */
+
+#pragma once
+
+#include "config.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <utility>
+#include <vector>
+
+namespace libgossip {
+
+    class LIBGOSSIP_API timer_wheel {
+    public:
+        /// @param bucket_count Rounded up to a power of two
+        explicit timer_wheel(size_t bucket_count = 512);
+
+        /// Arm the timer of id at tick, or move it earlier if it is already
+        /// armed later for the same generation. A timer armed for another
+        /// generation is replaced. Ticks before the cursor are clamped to it.
+        void schedule(uint32_t id, uint32_t generation, int64_t tick);
+
+        /// Disarm the timer of id, if armed
+        void cancel(uint32_t id) noexcept;
+
+        /// Whether the timer of id is armed
+        bool armed(uint32_t id) const noexcept {
+            return id < entries_.size() && entries_[id].armed;
+        }
+
+        /// Number of armed timers
+        size_t size() const noexcept { return armed_count_; }
+
+        /// Last tick passed to advance(), or min() if the wheel never advanced
+        int64_t cursor() const noexcept { return cursor_; }
+
+        /// Disarm all timers and rewind the cursor
+        void clear() noexcept;
+
+        /// Fire every timer whose tick is <= now, in no particular order.
+        /// Timers are disarmed before fn(id, generation) is called, so fn may
+        /// schedule them again. The bucket of the cursor tick is scanned again
+        /// on the next call, so a timer re-armed at or before now is not lost.
+        template<typename Fn>
+        void advance(int64_t now, Fn &&fn) {
+            if (now < cursor_) {
+                return;
+            }
+            collect_expired(now);
+            cursor_ = now;
+            for (const auto &[id, generation]: expired_) {
+                fn(id, generation);
+            }
+            expired_.clear();
+        }
+
+    private:
+        static constexpr uint32_t nil = 0xFFFFFFFFu;
+
+        struct entry {
+            int64_t tick = 0;
+            uint32_t generation = 0;
+            uint32_t prev = nil;
+            uint32_t next = nil;
+            bool armed = false;
+        };
+
+        size_t bucket_of(int64_t tick) const noexcept {
+            return static_cast<size_t>(static_cast<uint64_t>(tick) & (heads_.size() - 1));
+        }
+
+        void link(uint32_t id) noexcept;
+        void unlink(uint32_t id) noexcept;
+
+        /// Unlink every timer due at or before now into expired_
+        void collect_expired(int64_t now);
+
+        std::vector<uint32_t> heads_;// First entry of each bucket
+        std::vector<entry> entries_; // Indexed by id
+        std::vector<std::pair<uint32_t, uint32_t>> expired_;// Scratch for advance()
+        size_t armed_count_ = 0;
+        int64_t cursor_ = std::numeric_limits<int64_t>::min();
+    };
+
+}// namespace libgossip
@@ -0,0 +1,134 @@
+/**
+ * @file tombstone_store.hpp
+ * @brief Failed and left members, kept apart from the live membership
+ *
+ * A member declared failed (or that left) is moved out of the
+ * membership_table into this store, so lookups, peer selection, probing and
+ * gossip only ever walk live members. Tombstones are queued in the order
+ * they were buried, which with one retention period for all of them is also
+ * their expiry order: expire() only ever pops from the front. A hash index
+ * by ID answers whether a node is dead, and with which heartbeat, so stale
+ * gossip about it cannot bring it back while the tombstone is retained.
+ *
+ * A node that comes back (newer heartbeat) is erased from the index in
+ * O(1); its queue entry becomes a hole, popped when it reaches the front.
+ * The queue, holes included, never exceeds the capacity: past it the
+ * oldest tombstone is dropped early.
+ *
+ * Deaths are news to the rest of the cluster: take() hands out tombstones
+ * to piggyback, each at most retransmit_limit times, so a failure or leave
+ * spreads by gossip and not only by every member detecting it itself.
+ *
+ * @note Not thread-safe; the owning gossip_core serializes access.
+ */
+
+#pragma once
+
+#include "config.hpp"
+#include "membership_table.hpp"
+#include "node_view.hpp"
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <unordered_map>
+#include <vector>
+
+namespace libgossip {
+
+    class LIBGOSSIP_API tombstone_store {
+    public:
+        /// @param capacity Most queue entries held, 0 for no limit
+        explicit tombstone_store(size_t capacity = 0) : capacity_(capacity) {}
+
+        /// Record a dead node (its view is kept without metadata). died is
+        /// clamped to the newest tombstone's time so the queue stays ordered;
+        /// an existing tombstone of the node is replaced.
+        void bury(const node_view &node, time_point died);
+
+        /// Tombstone of a node, nullptr if it is not dead (or no longer retained)
+        const node_view *find(const node_id_t &id) const noexcept;
+
+        /// Forget a node's tombstone (it came back); false if there was none
+        bool erase(const node_id_t &id);
+
+        /// Drop the tombstones buried at or before cutoff, oldest first
+        /// @return Number of tombstones dropped
+        size_t expire(time_point cutoff);
+
+        /// Pick up to max tombstones to piggyback, least transmitted and most
+        /// recent first, skipping those for which accept(node) is false.
+        /// Picked tombstones count as transmitted once; each is picked at
+        /// most retransmit_limit times.
+        /// @param out Receives the picked views; cleared first, valid until the store changes
+        template<typename Accept>
+        void take(size_t max, uint32_t retransmit_limit, Accept &&accept, std::vector<const node_view *> &out) {
+            out.clear();
+            picks_.clear();
+            if (pending_seq_ < front_seq_) {
+                pending_seq_ = front_seq_;
+            }
+            for (size_t i = queue_.size(); i > pending_seq_ - front_seq_; --i) {
+                const entry &e = queue_[i - 1];
+                if (e.buried && e.transmits < retransmit_limit && accept(static_cast<const node_view &>(e.node))) {
+                    picks_.push_back(i - 1);
+                }
+            }
+            std::sort(picks_.begin(), picks_.end(), [this](size_t a, size_t b) {
+                return queue_[a].transmits != queue_[b].transmits ? queue_[a].transmits < queue_[b].transmits : a > b;
+            });
+            if (picks_.size() > max) {
+                picks_.resize(max);
+            }
+            for (size_t i: picks_) {
+                queue_[i].transmits++;
+                out.push_back(&queue_[i].node);
+            }
+            skip_sent(retransmit_limit);
+        }
+
+        /// Drop everything
+        void clear() noexcept;
+
+        /// Number of tombstones retained
+        size_t size() const noexcept { return index_.size(); }
+
+        bool empty() const noexcept { return index_.empty(); }
+
+        /// Visit every tombstone, oldest first
+        template<typename Fn>
+        void for_each(Fn &&fn) const {
+            for (const auto &e: queue_) {
+                if (e.buried) {
+                    fn(static_cast<const node_view &>(e.node));
+                }
+            }
+        }
+
+    private:
+        struct entry {
+            node_view node;
+            time_point died;
+            uint32_t transmits = 0;// Times picked by take()
+            bool buried = true;    // false: a hole left by erase()
+        };
+
+        struct id_hash {
+            size_t operator()(const node_id_t &id) const noexcept { return static_cast<size_t>(hash_node_id(id)); }
+        };
+
+        /// Pop the front entry, unindexing it if it is not a hole
+        void pop_front();
+
+        /// Move pending_seq_ past the entries take() will not pick any more
+        void skip_sent(uint32_t retransmit_limit) noexcept;
+
+        std::deque<entry> queue_;// By died, oldest first
+        uint64_t front_seq_ = 0; // Sequence number of queue_.front()
+        uint64_t pending_seq_ = 0;// Entries before it are holes or fully transmitted
+        std::unordered_map<node_id_t, uint64_t, id_hash> index_;// ID -> sequence number
+        std::vector<size_t> picks_;// Scratch for take()
+        size_t capacity_;
+    };
+
+}// namespace libgossip
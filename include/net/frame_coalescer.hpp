@@ -0,0 +1,89 @@
+/**
+ * @file frame_coalescer.hpp
+ * @brief Merges the frames sent to the same target into one datagram
+ *
+ * Every gossip message goes on the wire as a frame: a 4-byte big-endian
+ * length followed by the serialized message. A receiver parses as many
+ * frames as a datagram holds, so the frames bound for one target within a
+ * short window (a tick's ping and the pong to that target's own ping, the
+ * pings of tick_full_broadcast and the replies crossing them) can share a
+ * datagram. The coalescer keeps one pending datagram per target; the
+ * transport flushes them when the window closes, and a datagram that
+ * would grow past the size limit is emitted early.
+ *
+ * @note Not thread-safe; the owning transport serializes access.
+ */
+
+#pragma once
+
+#include "core/config.hpp"
+#include "core/membership_table.hpp"
+#include "core/node_view.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <unordered_map>
+#include <vector>
+
+namespace libgossip {
+    namespace net {
+
+        /**
+         * @brief Per-target datagram assembly for the UDP transport
+         */
+        class LIBGOSSIP_API frame_coalescer {
+        public:
+            /// Receives a finished datagram and its address
+            using emit_fn = std::function<void(const ip_address &ip, int port, const std::vector<uint8_t> &datagram)>;
+
+            /**
+             * @param max_datagram Largest datagram built from several frames; a
+             *        single larger frame is still sent, alone
+             */
+            explicit frame_coalescer(size_t max_datagram = config::DEFAULT_UDP_MAX_DATAGRAM_SIZE)
+                : max_datagram_(max_datagram) {}
+
+            /**
+             * @brief Append the frame of a serialized message for target
+             * @return true if nothing was pending before (the window starts now)
+             */
+            bool append(const ip_address &ip, int port, const std::vector<uint8_t> &payload, const emit_fn &emit);
+
+            /// Emit every pending datagram, in order of their first frame
+            void flush(const emit_fn &emit);
+
+            /// Whether any frame waits for flush()
+            bool pending() const noexcept { return !order_.empty(); }
+
+            /// Frames appended so far
+            uint64_t frames() const noexcept { return frames_; }
+
+            /// Datagrams emitted so far; frames() - datagrams() sends were saved
+            uint64_t datagrams() const noexcept { return datagrams_; }
+
+            /// Prepend the 4-byte big-endian length of payload to it, into out
+            static void frame(const std::vector<uint8_t> &payload, std::vector<uint8_t> &out);
+
+        private:
+            struct endpoint_hash {
+                size_t operator()(const endpoint_key &key) const noexcept { return static_cast<size_t>(hash_endpoint(key)); }
+            };
+
+            struct datagram {
+                ip_address ip;
+                int port = 0;
+                std::vector<uint8_t> bytes;
+            };
+
+            void emit_one(datagram &d, const emit_fn &emit);
+
+            size_t max_datagram_;
+            std::vector<datagram> order_;                                   // Pending, by first frame
+            std::unordered_map<endpoint_key, size_t, endpoint_hash> index_;// Endpoint -> position in order_
+            std::vector<std::vector<uint8_t>> spare_;                       // Buffers of flushed datagrams
+            uint64_t frames_ = 0;
+            uint64_t datagrams_ = 0;
+        };
+
+    } // namespace net
+} // namespace libgossip
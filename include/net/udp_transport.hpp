@@ -14,6 +14,7 @@
 
 #include "core/gossip_core.hpp"
 #include "core/message_serializer.hpp"
+#include <chrono>
 #include <cstdint>
 #include <functional>
 #include <memory>
@@ -86,6 +87,36 @@ namespace libgossip {
              * @param serializer Unique pointer to serializer
              */
             virtual void set_serializer(std::unique_ptr<message_serializer> serializer) = 0;
+
+            /**
+             * @brief Merge the messages sent to the same target within a window
+             *
+             * Messages passed to send_message() within window of the first one
+             * waiting for a target go out together, as one datagram of
+             * length-prefixed frames. Transports without datagrams ignore it.
+             * @param window Zero (the default) sends every message at once
+             */
+            virtual void set_coalesce_window(std::chrono::microseconds window) { (void)window; }
+
+            /**
+             * @brief Send the messages still waiting for their window now
+             */
+            virtual void flush() {}
+
+            /**
+             * @brief Messages given to send_message() so far
+             *
+             * Transports that do not count them report 0.
+             */
+            virtual uint64_t frames_sent() const { return 0; }
+
+            /**
+             * @brief Datagrams sent for those messages so far
+             *
+             * Fewer than frames_sent() when coalescing merges them; 0 for
+             * transports without datagrams.
+             */
+            virtual uint64_t datagrams_sent() const { return 0; }
         };
 
         /**
@@ -107,6 +138,10 @@ namespace libgossip {
                                     std::function<void(error_code)> callback) override;
             void set_gossip_core(std::shared_ptr<gossip_core> core) override;
             void set_serializer(std::unique_ptr<message_serializer> serializer) override;
+            void set_coalesce_window(std::chrono::microseconds window) override;
+            void flush() override;
+            uint64_t frames_sent() const override;
+            uint64_t datagrams_sent() const override;
 
         private:
             class impl;
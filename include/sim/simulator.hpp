@@ -0,0 +1,210 @@
+/**
+ * @file simulator.hpp
+ * @brief Deterministic discrete-event simulation of many gossip_cores
+ *
+ * The simulator drives gossip_core instances on one thread and a virtual
+ * clock: it installs itself as clock's time source, and time jumps from one
+ * queued event to the next, so a simulated minute costs only the work done
+ * in it. Events are ticks (every heartbeat_interval_ms, each node at its own
+ * phase) and message deliveries.
+ *
+ * The simulated network delays each message by a latency drawn uniformly
+ * from [latency_min, latency_max] (plus cross_region_latency between
+ * regions), drops it with probability loss, and drops it between
+ * partitions. Messages are copied, not serialized, into a pool whose
+ * buffers are reused.
+ *
+ * Everything random derives from simulation_options::seed: tick phases,
+ * latency and loss, and each core's peer selection (gossip_core_options::seed).
+ * Events due at the same time run in the order they were queued, so a seed
+ * replays a run exactly.
+ *
+ * Metrics: message counts, status changes reported about nodes that are up
+ * (false suspicions), how long a crashed node took to be suspected, failed by
+ * one member and dropped by every member that held it (detections()), and
+ * whether membership has converged (converged()). Members drop a node by
+ * failing it, reported through the event callback, or by evicting it at
+ * max_nodes, which the simulator notices by checking their snapshots once
+ * per heartbeat interval.
+ *
+ * Memory: a core preallocates event_queue_capacity events (about 200 bytes
+ * each). For 100k cores, pass a small capacity with event_overflow_policy::grow.
+ *
+ * @note One simulator per process at a time, as the clock source is global.
+ */
+
+#pragma once
+
+#include "core/gossip_core.hpp"
+#include <chrono>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <optional>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace libgossip {
+    namespace sim {
+
+        using sim_duration = std::chrono::microseconds;
+
+        struct network_options {
+            sim_duration latency_min{500};       // One-way delay, uniform in [latency_min, latency_max]
+            sim_duration latency_max{1500};
+            sim_duration cross_region_latency{0};// Added when sender and receiver regions differ
+            double loss = 0.0;                   // Probability a message is dropped
+        };
+
+        struct simulation_options {
+            uint64_t seed = 1;          // Seeds the network and every core
+            gossip_core_options core;   // Options of every node (seed is derived per node)
+            network_options network;
+        };
+
+        struct simulation_stats {
+            uint64_t ticks = 0;
+            uint64_t messages_sent = 0;        // Handed to the network by cores
+            uint64_t messages_delivered = 0;
+            uint64_t messages_lost = 0;        // Dropped by network_options::loss
+            uint64_t messages_partitioned = 0; // Sender and receiver in different partitions
+            uint64_t messages_undelivered = 0; // Receiver down, or no node with the target ID
+            uint64_t entries_sent = 0;         // Node views carried, a proxy for bytes
+            uint64_t false_suspicions = 0;     // A node that is up was marked suspect
+            uint64_t false_failures = 0;       // A node that is up was marked failed
+        };
+
+        /// How a crash was detected; times are measured from the crash
+        struct detection {
+            uint32_t node = 0;
+            time_point crashed;
+            uint32_t observers = 0;                // Members up that held the node when it crashed
+            uint32_t pending = 0;                  // Of them, still up and holding it
+            std::optional<sim_duration> first_suspect;
+            std::optional<sim_duration> first_failed;
+            std::optional<sim_duration> all_failed;// Once pending reached 0: each failed it, or
+                                                   // evicted it to make room (max_nodes)
+        };
+
+        class LIBGOSSIP_API simulator {
+        public:
+            /// Called for every status change a core reports: (observer, node, old status)
+            using event_observer = std::function<void(uint32_t, const node_view &, node_status)>;
+
+            explicit simulator(simulation_options options = {});
+            ~simulator();
+
+            simulator(const simulator &) = delete;
+            simulator &operator=(const simulator &) = delete;
+
+            /// Add a node (its ID must be unique); it first ticks within one heartbeat interval
+            /// @return Its index
+            uint32_t add_node(const node_view &self);
+
+            /// Add n nodes with IDs and addresses derived from their index, in
+            /// regions assigned by region_of(index) (or none)
+            void add_nodes(uint32_t n, const std::function<std::string(uint32_t)> &region_of = nullptr);
+
+            /// Node from meets node to (gossip_core::meet)
+            void meet(uint32_t from, uint32_t to);
+
+            /// Stop a node: it neither ticks nor receives until recover()
+            void crash(uint32_t node);
+
+            /// Resume a crashed node with the state it had (a long pause)
+            void recover(uint32_t node);
+
+            /// Cut nodes off from everyone else: they form a new partition
+            /// @return The partition's number (0 is the initial one)
+            uint32_t partition(const std::vector<uint32_t> &nodes);
+
+            /// Put every node back in partition 0
+            void heal();
+
+            /// Run every event due in the next d, then advance the clock by d
+            void run_for(sim_duration d);
+
+            /// Run until pred() holds, checking every heartbeat interval
+            /// @return Time it took, or nullopt if it did not hold within limit
+            std::optional<sim_duration> run_until(const std::function<bool()> &pred, sim_duration limit);
+
+            /// Whether every node that is up holds exactly the nodes it should:
+            /// the nodes up (in its region with hierarchical), and with
+            /// hierarchical a summary of every region with a node up.
+            /// Meaningless when max_nodes is below the cluster size.
+            bool converged() const;
+
+            time_point now() const noexcept;
+            sim_duration elapsed() const noexcept;
+
+            uint32_t size() const noexcept { return static_cast<uint32_t>(nodes_.size()); }
+            bool up(uint32_t node) const noexcept { return nodes_[node].up; }
+            gossip_core &core(uint32_t node) { return *nodes_[node].core; }
+            const gossip_core &core(uint32_t node) const { return *nodes_[node].core; }
+
+            network_options &network() noexcept { return options_.network; }
+            const simulation_stats &stats() const noexcept { return stats_; }
+            const std::vector<detection> &detections() const noexcept { return detections_; }
+
+            void set_event_observer(event_observer observer) { observer_ = std::move(observer); }
+
+        private:
+            struct node {
+                std::unique_ptr<gossip_core> core;
+                uint32_t region = 0;   // Index into region_up_
+                uint32_t partition = 0;
+                bool up = true;
+            };
+
+            struct event {
+                int64_t at;     // Nanoseconds since the start
+                uint64_t seq;   // Ties run in queue order
+                uint32_t node;   // none: check the open detections
+                uint32_t message;// Pool index, or none for a tick
+
+                bool operator>(const event &other) const noexcept {
+                    return at != other.at ? at > other.at : seq > other.seq;
+                }
+            };
+
+            struct id_hash {
+                size_t operator()(const node_id_t &id) const noexcept { return static_cast<size_t>(hash_node_id(id)); }
+            };
+
+            static constexpr uint32_t none = 0xFFFFFFFFu;
+
+            void schedule(int64_t at, uint32_t node, uint32_t message);
+            void run_event(const event &e);
+            void send(uint32_t from, const gossip_message &msg, const node_view &target);
+            void on_event(uint32_t observer, const node_view &node, node_status old_status);
+            uint32_t region_index_of(const std::string &region);
+            int64_t interval_ns() const noexcept;
+            void check_detections();
+            void settle(uint32_t d, size_t pos);// watchers_[d][pos] no longer holds the node
+
+            simulation_options options_;
+            xoshiro256ss rng_;
+            int64_t now_ = 0;
+            uint64_t seq_ = 0;
+            std::vector<event> queue_;// Min-heap on (at, seq)
+            std::vector<node> nodes_;
+            std::unordered_map<node_id_t, uint32_t, id_hash> index_;
+            std::vector<std::string> regions_;
+            std::vector<uint32_t> region_up_;// Nodes up per region
+            uint32_t partitions_ = 0;
+
+            std::deque<gossip_message> pool_;// Messages in flight (a deque: delivering one may queue more)
+            std::vector<uint32_t> free_;     // Unused pool entries
+
+            std::vector<detection> detections_;
+            std::vector<std::vector<uint32_t>> watchers_;// Per detection: observers still pending
+            std::vector<uint32_t> crash_of_;             // Per node: its open detection, or none
+            bool checking_ = false;                      // A detection check is queued
+            simulation_stats stats_;
+            event_observer observer_;
+        };
+
+    }// namespace sim
+}// namespace libgossip
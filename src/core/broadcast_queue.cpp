@@ -0,0 +1,79 @@
+/**
+ * @file broadcast_queue.cpp
+ * @brief Implementation of the piggyback dissemination queue
+ */
+
+#include "core/broadcast_queue.hpp"
+
+namespace libgossip {
+
+    void broadcast_queue::push(node_handle handle) {
+        if (handle.index >= entries_.size()) {
+            entries_.resize(static_cast<size_t>(handle.index) + 1);
+        }
+        if (entries_[handle.index].queued) {
+            unlink(handle.index);
+        }
+
+        entry &e = entries_[handle.index];
+        e.generation = handle.generation;
+        e.transmits = 0;
+        link_front(handle.index);
+    }
+
+    void broadcast_queue::remove(uint32_t index) noexcept {
+        if (index < entries_.size() && entries_[index].queued) {
+            unlink(index);
+        }
+    }
+
+    void broadcast_queue::clear() noexcept {
+        for (auto &head: heads_) {
+            head = nil;
+        }
+        for (auto &e: entries_) {
+            e.queued = false;
+        }
+        queued_count_ = 0;
+    }
+
+    void broadcast_queue::link_front(uint32_t index) {
+        entry &e = entries_[index];
+        if (e.transmits >= heads_.size()) {
+            heads_.resize(static_cast<size_t>(e.transmits) + 1, nil);
+        }
+        uint32_t &head = heads_[e.transmits];
+        e.prev = nil;
+        e.next = head;
+        if (head != nil) {
+            entries_[head].prev = index;
+        }
+        head = index;
+        e.queued = true;
+        ++queued_count_;
+    }
+
+    void broadcast_queue::unlink(uint32_t index) noexcept {
+        entry &e = entries_[index];
+        if (e.prev != nil) {
+            entries_[e.prev].next = e.next;
+        } else {
+            heads_[e.transmits] = e.next;
+        }
+        if (e.next != nil) {
+            entries_[e.next].prev = e.prev;
+        }
+        e.prev = e.next = nil;
+        e.queued = false;
+        --queued_count_;
+    }
+
+    void broadcast_queue::transmitted(uint32_t index, uint32_t retransmit_limit) {
+        unlink(index);
+        entry &e = entries_[index];
+        if (++e.transmits < retransmit_limit) {
+            link_front(index);
+        }
+    }
+
+}// namespace libgossip
@@ -0,0 +1,106 @@
+/**
+ * @file event_queue.cpp
+ * @brief Implementation of the membership event ring
+ */
+
+#include "core/event_queue.hpp"
+#include <utility>
+
+namespace libgossip {
+
+    event_queue::event_queue(size_t capacity, event_overflow_policy policy)
+        : ring_(capacity > 0 ? capacity : 1), policy_(policy) {}
+
+    bool event_queue::push(const node_view &node, node_status old_status, time_point now) {
+        bool lost = false;
+        if (count_ == ring_.size()) {
+            switch (policy_) {
+                case event_overflow_policy::drop_newest:
+                    dropped_++;
+                    return false;
+                case event_overflow_policy::grow:
+                    grow();
+                    break;
+                default:// drop_oldest: the slot of the oldest event is reused below
+                    head_ = (head_ + 1) % ring_.size();
+                    count_--;
+                    dropped_++;
+                    lost = true;
+                    break;
+            }
+        }
+
+        queued_event &slot = ring_[(head_ + count_) % ring_.size()];
+        slot.node = node;// Assignment reuses the slot's string and map storage
+        slot.old_status = old_status;
+        slot.queued_at = now;
+        count_++;
+        if (count_ > peak_) {
+            peak_ = count_;
+        }
+        return !lost;
+    }
+
+    bool event_queue::pop(queued_event &out) {
+        if (count_ == 0) {
+            return false;
+        }
+        queued_event &slot = ring_[head_];
+        std::swap(out.node, slot.node);
+        out.old_status = slot.old_status;
+        out.queued_at = slot.queued_at;
+        head_ = (head_ + 1) % ring_.size();
+        count_--;
+        return true;
+    }
+
+    void event_queue::clear() noexcept {
+        head_ = 0;
+        count_ = 0;
+    }
+
+    void event_queue::grow() {
+        std::vector<queued_event> bigger(ring_.size() * 2);
+        for (size_t i = 0; i < count_; ++i) {
+            bigger[i] = std::move(ring_[(head_ + i) % ring_.size()]);
+        }
+        ring_ = std::move(bigger);
+        head_ = 0;
+    }
+
+    void change_batch::add(queued_event &event) {
+        // An event without a status change is a metadata (or other state) change
+        const bool state_change = event.old_status == event.node.status || event.old_status == node_status::unknown;
+        auto [it, inserted] = index_.try_emplace(event.node.id, changes_.size());
+        if (inserted) {
+            changes_.push_back({std::move(event.node), event.old_status});
+            state_changed_.push_back(state_change);
+        } else {
+            changes_[it->second].node = std::move(event.node);
+            if (state_change) {
+                state_changed_[it->second] = true;
+            }
+        }
+    }
+
+    void change_batch::finish() {
+        size_t kept = 0;
+        for (size_t i = 0; i < changes_.size(); ++i) {
+            if (!state_changed_[i] && changes_[i].old_status == changes_[i].node.status) {
+                continue;// e.g. online -> suspect -> online
+            }
+            if (kept != i) {
+                changes_[kept] = std::move(changes_[i]);
+            }
+            kept++;
+        }
+        changes_.resize(kept);
+    }
+
+    void change_batch::clear() noexcept {
+        changes_.clear();
+        state_changed_.clear();
+        index_.clear();
+    }
+
+}// namespace libgossip
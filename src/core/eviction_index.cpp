@@ -0,0 +1,94 @@
+/**
+ * @file eviction_index.cpp
+ * @brief Implementation of the membership eviction order
+ */
+
+#include "core/eviction_index.hpp"
+
+namespace libgossip {
+
+    eviction_index::eviction_index(uint32_t classes)
+        : heads_(classes, nil), tails_(classes, nil), counts_(classes, 0) {
+    }
+
+    void eviction_index::touch(node_handle handle, uint32_t cls) {
+        if (cls >= heads_.size()) {
+            cls = static_cast<uint32_t>(heads_.size()) - 1;
+        }
+        if (handle.index >= entries_.size()) {
+            entries_.resize(static_cast<size_t>(handle.index) + 1);
+        }
+        entry &e = entries_[handle.index];
+        if (e.cls != nil) {
+            if (e.cls == cls && e.next == nil && e.generation == handle.generation) {
+                return;// Already the most recent of its class
+            }
+            unlink(handle.index);
+        }
+
+        e.generation = handle.generation;
+        e.cls = cls;
+        e.prev = tails_[cls];
+        e.next = nil;
+        if (tails_[cls] != nil) {
+            entries_[tails_[cls]].next = handle.index;
+        } else {
+            heads_[cls] = handle.index;
+        }
+        tails_[cls] = handle.index;
+        ++counts_[cls];
+    }
+
+    void eviction_index::remove(uint32_t index) noexcept {
+        if (index < entries_.size() && entries_[index].cls != nil) {
+            unlink(index);
+        }
+    }
+
+    void eviction_index::clear() noexcept {
+        for (uint32_t cls = 0; cls < heads_.size(); ++cls) {
+            heads_[cls] = tails_[cls] = nil;
+            counts_[cls] = 0;
+        }
+        for (auto &e: entries_) {
+            e.cls = e.prev = e.next = nil;
+        }
+    }
+
+    node_handle eviction_index::victim(uint32_t limit, node_handle pinned) const noexcept {
+        for (uint32_t cls = 0; cls < limit && cls < heads_.size(); ++cls) {
+            uint32_t index = heads_[cls];
+            if (index != nil && pinned.valid() && index == pinned.index) {
+                index = entries_[index].next;
+            }
+            if (index != nil) {
+                return {index, entries_[index].generation};
+            }
+        }
+        return {};
+    }
+
+    uint32_t eviction_index::class_of(uint32_t index) const noexcept {
+        if (index >= entries_.size() || entries_[index].cls == nil) {
+            return classes();
+        }
+        return entries_[index].cls;
+    }
+
+    void eviction_index::unlink(uint32_t index) noexcept {
+        entry &e = entries_[index];
+        if (e.prev != nil) {
+            entries_[e.prev].next = e.next;
+        } else {
+            heads_[e.cls] = e.next;
+        }
+        if (e.next != nil) {
+            entries_[e.next].prev = e.prev;
+        } else {
+            tails_[e.cls] = e.prev;
+        }
+        --counts_[e.cls];
+        e.cls = e.prev = e.next = nil;
+    }
+
+}// namespace libgossip
@@ -0,0 +1,168 @@
+/**
+ * @file failure_detector.cpp
+ * @brief Implementation of the timeout and phi-accrual failure detectors
+ */
+
+#include "core/failure_detector.hpp"
+#include <algorithm>
+#include <cmath>
+
+namespace libgossip {
+
+    namespace {
+
+        // Coefficients of the logistic approximation of the normal CDF
+        constexpr double logistic_a = 1.5976;
+        constexpr double logistic_b = 0.070566;
+
+        double to_ms(duration_ms d) noexcept {
+            return static_cast<double>(d.count());
+        }
+
+    }// namespace
+
+    // ---------------------------------------------------------
+    // timeout_detector
+    // ---------------------------------------------------------
+
+    double timeout_detector::suspicion(node_handle, const node_view &node, time_point now) const noexcept {
+        if (timeout_.count() <= 0) {
+            return 0.0;
+        }
+        return to_ms(std::chrono::duration_cast<duration_ms>(now - node.seen_time)) / to_ms(timeout_);
+    }
+
+    // ---------------------------------------------------------
+    // phi_accrual_detector
+    // ---------------------------------------------------------
+
+    phi_accrual_detector::phi_accrual_detector(double threshold, duration_ms min_std_deviation,
+                                               duration_ms fallback_timeout)
+        : threshold_(threshold), min_std_deviation_ms_(std::max(1.0, to_ms(min_std_deviation))),
+          fallback_timeout_(fallback_timeout) {
+        // phi(y) = -log10(e / (1 + e)) with e = exp(-y * (a + b * y^2)), so
+        // phi(y) == threshold solves b * y^3 + a * y = ln((1 - P) / P) with
+        // P = 10^-threshold: a depressed cubic with a single real root
+        const double p_later = std::pow(10.0, -threshold_);
+        const double s = std::log((1.0 - p_later) / p_later);
+        const double p = logistic_a / logistic_b;
+        const double q = s / logistic_b;
+        const double d = std::sqrt(q * q / 4.0 + p * p * p / 27.0);
+        threshold_deviations_ = std::cbrt(q / 2.0 + d) + std::cbrt(q / 2.0 - d);
+    }
+
+    double phi_accrual_detector::phi(double elapsed_ms, double mean_ms, double std_deviation_ms) noexcept {
+        const double y = (elapsed_ms - mean_ms) / std_deviation_ms;
+        const double e = std::exp(-y * (logistic_a + logistic_b * y * y));
+        if (elapsed_ms > mean_ms) {
+            return -std::log10(e / (1.0 + e));
+        }
+        return -std::log10(1.0 - 1.0 / (1.0 + e));
+    }
+
+    void phi_accrual_detector::heartbeat(node_handle handle, time_point arrival) {
+        if (handle.index >= histories_.size()) {
+            histories_.resize(static_cast<size_t>(handle.index) + 1);
+        }
+
+        history &h = histories_[handle.index];
+        if (!h.used || h.generation != handle.generation) {
+            h = history{};
+            h.generation = handle.generation;
+            h.last_arrival = arrival;
+            h.used = true;
+            return;
+        }
+        if (arrival <= h.last_arrival) {
+            return;// Same or reordered arrival carries no interval
+        }
+
+        const auto interval = static_cast<uint32_t>(
+                std::min<int64_t>(std::chrono::duration_cast<duration_ms>(arrival - h.last_arrival).count(),
+                                  INT32_MAX));
+        h.last_arrival = arrival;
+
+        // Replace the oldest interval once the ring is full
+        if (h.count == window_size) {
+            const uint64_t oldest = h.intervals_ms[h.head];
+            h.sum -= oldest;
+            h.sum_squares -= oldest * oldest;
+        } else {
+            h.count++;
+        }
+        h.intervals_ms[h.head] = interval;
+        h.sum += interval;
+        h.sum_squares += static_cast<uint64_t>(interval) * interval;
+        h.head = static_cast<uint16_t>((h.head + 1) % window_size);
+    }
+
+    void phi_accrual_detector::forget(node_handle handle) noexcept {
+        if (handle.index < histories_.size() && histories_[handle.index].generation == handle.generation) {
+            histories_[handle.index].used = false;
+        }
+    }
+
+    void phi_accrual_detector::clear() noexcept {
+        for (auto &h: histories_) {
+            h.used = false;
+        }
+    }
+
+    const phi_accrual_detector::history *phi_accrual_detector::find(node_handle handle) const noexcept {
+        if (handle.index >= histories_.size()) {
+            return nullptr;
+        }
+        const history &h = histories_[handle.index];
+        return h.used && h.generation == handle.generation ? &h : nullptr;
+    }
+
+    void phi_accrual_detector::moments(const history &h, double &mean_ms, double &std_deviation_ms) const noexcept {
+        const double n = static_cast<double>(h.count);
+        mean_ms = static_cast<double>(h.sum) / n;
+        const double variance = std::max(0.0, static_cast<double>(h.sum_squares) / n - mean_ms * mean_ms);
+        std_deviation_ms = std::max(min_std_deviation_ms_, std::sqrt(variance));
+    }
+
+    time_point phi_accrual_detector::suspect_deadline(node_handle handle, const node_view &node) const noexcept {
+        const history *h = find(handle);
+        if (!h || h->count < min_samples) {
+            return node.seen_time + fallback_timeout_;
+        }
+
+        double mean_ms = 0.0;
+        double std_deviation_ms = 0.0;
+        moments(*h, mean_ms, std_deviation_ms);
+        const auto silence = std::chrono::duration<double, std::milli>(mean_ms + threshold_deviations_ * std_deviation_ms);
+        // Round up, so phi has reached the threshold when the deadline fires
+        return h->last_arrival + std::chrono::ceil<duration_ms>(silence);
+    }
+
+    double phi_accrual_detector::suspicion(node_handle handle, const node_view &node, time_point now) const noexcept {
+        const history *h = find(handle);
+        if (!h || h->count < min_samples) {
+            // Not enough samples: express the fallback timeout on the phi scale
+            const double elapsed = to_ms(std::chrono::duration_cast<duration_ms>(now - node.seen_time));
+            return fallback_timeout_.count() > 0 ? threshold_ * elapsed / to_ms(fallback_timeout_) : 0.0;
+        }
+
+        double mean_ms = 0.0;
+        double std_deviation_ms = 0.0;
+        moments(*h, mean_ms, std_deviation_ms);
+        const double elapsed = to_ms(std::chrono::duration_cast<duration_ms>(now - h->last_arrival));
+        return phi(elapsed, mean_ms, std_deviation_ms);
+    }
+
+    // ---------------------------------------------------------
+    // Factory
+    // ---------------------------------------------------------
+
+    std::unique_ptr<failure_detector> make_failure_detector(const gossip_core_options &options) {
+        const duration_ms timeout(options.failure_timeout_ms);
+        if (options.detector == failure_detector_type::phi_accrual) {
+            return std::make_unique<phi_accrual_detector>(
+                    options.phi_threshold, duration_ms(options.phi_min_std_deviation_ms), timeout);
+        }
+        return std::make_unique<timeout_detector>(timeout);
+    }
+
+}// namespace libgossip
@@ -47,7 +47,7 @@ LIBGOSSIP_API libgossip::node_view to_cpp_node_view(const gossip_node_view_t *c_
 LIBGOSSIP_API gossip_node_view_t to_c_node_view(const libgossip::node_view &cpp_node_view) {
     gossip_node_view_t c_node_view = {0};
     c_node_view.id = to_c_node_id(cpp_node_view.id);
-    std::snprintf(c_node_view.ip, sizeof(c_node_view.ip), "%s", cpp_node_view.ip.c_str());
+    std::snprintf(c_node_view.ip, sizeof(c_node_view.ip), "%s", cpp_node_view.ip.str().c_str());
     c_node_view.port = cpp_node_view.port;
     c_node_view.config_epoch = cpp_node_view.config_epoch;
     c_node_view.heartbeat = cpp_node_view.heartbeat;
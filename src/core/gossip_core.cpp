@@ -2,12 +2,30 @@
 #include "core/gossip_core.hpp"
 #include "core/logger.hpp"
 #include <algorithm>
+#include <cmath>
+#include <cstdint>
 #include <random>
 #include <stdexcept>
-#include <thread>
 
 namespace libgossip {
 
+    // ---------------------------------------------------------
+    // Clock
+    // ---------------------------------------------------------
+
+    namespace {
+        std::atomic<clock::source> clock_source{nullptr};
+    }// namespace
+
+    time_point clock::now() noexcept {
+        source fn = clock_source.load(std::memory_order_relaxed);
+        return fn ? fn() : std::chrono::steady_clock::now();
+    }
+
+    void clock::set_source(source fn) noexcept {
+        clock_source.store(fn, std::memory_order_relaxed);
+    }
+
     // ---------------------------------------------------------
     // node_view member functions
     // ---------------------------------------------------------
@@ -32,78 +50,407 @@ namespace libgossip {
         return heartbeat > other.heartbeat;// epoch is the same, higher heartbeat wins
     }
 
+    namespace {
+
+        // Copy the keys of from written after since (all of them if since is
+        // 0) into to. std::map assignment rebuilds every node; when to already
+        // holds exactly those keys, the values are assigned in place instead.
+        void copy_metadata(node_view &to, const node_view &from, uint64_t since) {
+            auto selected = [&from, since](size_t index) {
+                return since == 0 || from.metadata_key_version(index) > since;
+            };
+            bool same_keys = true;
+            auto it = to.metadata.begin();
+            size_t index = 0;
+            for (auto from_it = from.metadata.begin(); same_keys && from_it != from.metadata.end(); ++from_it, ++index) {
+                if (!selected(index)) {
+                    continue;
+                }
+                if (it == to.metadata.end() || it->first != from_it->first) {
+                    same_keys = false;
+                } else {
+                    ++it;
+                }
+            }
+            if (!same_keys || it != to.metadata.end()) {
+                same_keys = false;
+                to.metadata.clear();
+            }
+
+            to.metadata_versions.clear();
+            it = to.metadata.begin();
+            index = 0;
+            for (const auto &[key, value]: from.metadata) {
+                if (!selected(index++)) {
+                    continue;
+                }
+                if (same_keys) {
+                    (it++)->second = value;
+                } else {
+                    to.metadata.emplace_hint(to.metadata.end(), key, value);
+                }
+                if (!from.metadata_versions.empty()) {
+                    to.metadata_versions.push_back(from.metadata_versions[index - 1]);
+                }
+            }
+        }
+
+        // A node's view without its metadata, as group summaries carry it
+        node_view contact_view(const node_view &node) {
+            node_view contact;
+            contact.assign_without_metadata(node);
+            return contact;
+        }
+
+        // Append count distinct handles drawn uniformly from positions
+        // [0, m) of a dense array, skipping those already in out. Floyd's
+        // algorithm: count draws in O(count), no copy of the array.
+        template<typename ToHandle>
+        void sample_positions(xoshiro256ss &rng, size_t m, size_t count, ToHandle to_handle,
+                              std::vector<node_handle> &out) {
+            const size_t first = out.size();
+            for (size_t j = m - count; j < m; ++j) {
+                size_t t = rng.uniform(static_cast<uint32_t>(j + 1));
+                node_handle h = to_handle(t);
+                if (std::find(out.begin() + static_cast<std::ptrdiff_t>(first), out.end(), h) != out.end()) {
+                    h = to_handle(j);
+                }
+                out.push_back(h);
+            }
+        }
+
+    }// namespace
+
+    void node_view::assign(const node_view &other) {
+        if (this == &other) {
+            return;
+        }
+        assign_without_metadata(other);
+        const bool unchanged = same_metadata(other);
+        metadata_version = other.metadata_version;
+        metadata_hash = other.metadata_hash;
+        metadata_since = other.metadata_since;
+        if (unchanged) {
+            metadata_versions = other.metadata_versions;
+            return;
+        }
+        copy_metadata(*this, other, 0);
+    }
+
+    void node_view::assign_without_metadata(const node_view &other) {
+        id = other.id;
+        ip = other.ip;
+        port = other.port;
+        config_epoch = other.config_epoch;
+        heartbeat = other.heartbeat;
+        version = other.version;
+        seen_time = other.seen_time;
+        status = other.status;
+        role = other.role;
+        region = other.region;
+        suspicion_count = other.suspicion_count;
+        last_suspected = other.last_suspected;
+    }
+
+    void node_view::assign_delta(const node_view &other, uint64_t since) {
+        if (since == 0 || other.metadata_version == 0 || other.metadata_since != 0) {
+            assign(other);
+            return;
+        }
+        size_t count = 0;
+        for (size_t i = 0; i < other.metadata.size(); ++i) {
+            count += other.metadata_key_version(i) > since ? 1 : 0;
+        }
+        if (count == other.metadata.size()) {
+            assign(other);
+            return;
+        }
+        assign_without_metadata(other);
+        metadata_version = other.metadata_version;
+        metadata_hash = other.metadata_hash;
+        metadata_since = since;
+        copy_metadata(*this, other, since);
+    }
+
+    bool node_view::same_metadata(const node_view &other) const {
+        if (metadata_since != other.metadata_since) {
+            return false;// A delta and a full map (or two different deltas)
+        }
+        if (metadata_version != 0 && other.metadata_version != 0) {
+            return metadata_hash == other.metadata_hash;
+        }
+        return metadata == other.metadata;
+    }
+
+    void node_view::stamp_metadata() {
+        metadata_version++;
+        metadata_hash = hash_metadata(metadata);
+        metadata_versions.clear();
+    }
+
+    bool node_view::set_metadata(const std::map<std::string, std::string> &values) {
+        const uint64_t next = metadata_version + 1;
+        bool changed = false;
+        for (const auto &[key, value]: values) {
+            auto it = metadata.lower_bound(key);
+            if (it != metadata.end() && it->first == key && it->second == value) {
+                continue;
+            }
+            if (!changed && metadata_versions.size() != metadata.size()) {
+                metadata_versions.assign(metadata.size(), metadata_version);
+            }
+            changed = true;
+            const auto index = static_cast<size_t>(std::distance(metadata.begin(), it));
+            if (it != metadata.end() && it->first == key) {
+                it->second = value;
+                metadata_versions[index] = next;
+            } else {
+                metadata.emplace_hint(it, key, value);
+                metadata_versions.insert(metadata_versions.begin() + static_cast<std::ptrdiff_t>(index), next);
+            }
+        }
+        if (changed) {
+            metadata_version = next;
+            metadata_hash = hash_metadata(metadata);
+        }
+        return changed;
+    }
+
+    uint64_t node_view::metadata_key_version(size_t index) const noexcept {
+        return index < metadata_versions.size() ? metadata_versions[index] : metadata_version;
+    }
+
+    metadata_merge node_view::merge_metadata(const node_view &remote, size_t size_limit) {
+        if (remote.metadata_version < metadata_version ||
+            (remote.metadata_version == metadata_version && remote.metadata_hash == metadata_hash)) {
+            return metadata_merge::unchanged;
+        }
+        const uint64_t old_hash = metadata_version != 0 ? metadata_hash : hash_metadata(metadata);
+
+        if (remote.metadata_since == 0) {
+            if (metadata_bytes(remote.metadata) > size_limit) {
+                // Remember the version so that it is not asked for again
+                metadata_version = remote.metadata_version;
+                metadata_hash = remote.metadata_hash;
+                return metadata_merge::rejected;
+            }
+            copy_metadata(*this, remote, 0);
+            metadata_version = remote.metadata_version;
+            metadata_hash = remote.metadata_hash;
+            return old_hash != metadata_hash ? metadata_merge::changed : metadata_merge::unchanged;
+        }
+
+        // A delta only covers the versions after metadata_since
+        if (metadata_version < remote.metadata_since) {
+            return metadata_merge::gap;
+        }
+        size_t bytes = metadata_bytes(metadata);
+        for (const auto &[key, value]: remote.metadata) {
+            auto it = metadata.find(key);
+            bytes += value.size();
+            bytes -= it != metadata.end() ? it->second.size() : 0;
+            bytes += it != metadata.end() ? 0 : key.size();
+        }
+        if (bytes > size_limit) {
+            metadata_version = remote.metadata_version;
+            metadata_hash = remote.metadata_hash;
+            return metadata_merge::rejected;
+        }
+
+        if (metadata_versions.size() != metadata.size()) {
+            metadata_versions.assign(metadata.size(), metadata_version);
+        }
+        size_t index = 0;
+        for (const auto &[key, value]: remote.metadata) {
+            const uint64_t version = remote.metadata_key_version(index++);
+            auto it = metadata.lower_bound(key);
+            const auto at = static_cast<size_t>(std::distance(metadata.begin(), it));
+            if (it != metadata.end() && it->first == key) {
+                if (version > metadata_versions[at]) {
+                    it->second = value;
+                    metadata_versions[at] = version;
+                }
+            } else {
+                metadata.emplace_hint(it, key, value);
+                metadata_versions.insert(metadata_versions.begin() + static_cast<std::ptrdiff_t>(at), version);
+            }
+        }
+        metadata_version = remote.metadata_version;
+        metadata_hash = hash_metadata(metadata);
+        if (metadata_hash != remote.metadata_hash) {
+            return metadata_merge::gap;// Our map had drifted; the full view will replace it
+        }
+        return old_hash != metadata_hash ? metadata_merge::changed : metadata_merge::unchanged;
+    }
+
+    size_t metadata_bytes(const std::map<std::string, std::string> &metadata) noexcept {
+        size_t bytes = 0;
+        for (const auto &[key, value]: metadata) {
+            bytes += key.size() + value.size();
+        }
+        return bytes;
+    }
+
+    uint64_t hash_metadata(const std::map<std::string, std::string> &metadata) noexcept {
+        // FNV-1a 64; keys and values are terminated so that ("ab", "c") != ("a", "bc")
+        uint64_t h = 0xCBF29CE484222325ULL;
+        auto mix_string = [&h](const std::string &str) {
+            for (char c: str) {
+                h = (h ^ static_cast<uint8_t>(c)) * 0x100000001B3ULL;
+            }
+            h = h * 0x100000001B3ULL;
+        };
+        for (const auto &[key, value]: metadata) {
+            mix_string(key);
+            mix_string(value);
+        }
+        return h == 0 ? 1 : h;
+    }
+
+    uint32_t state_hash(const node_view &node) noexcept {
+        // FNV-1a; fields are terminated so that ("ab", "c") != ("a", "bc")
+        uint32_t h = 2166136261u;
+        auto mix = [&h](const void *data, size_t size) {
+            const auto *bytes = static_cast<const uint8_t *>(data);
+            for (size_t i = 0; i < size; ++i) {
+                h = (h ^ bytes[i]) * 16777619u;
+            }
+        };
+        auto mix_string = [&mix](const std::string &str) {
+            mix(str.data(), str.size());
+            mix("", 1);
+        };
+
+        const auto status = static_cast<uint8_t>(node.status);
+        mix(&status, sizeof(status));
+        mix(&node.port, sizeof(node.port));
+        const auto ip_kind = node.ip.type();
+        mix(&ip_kind, sizeof(ip_kind));
+        if (ip_kind == ip_address::kind::host) {
+            mix_string(node.ip.host());
+        } else {
+            mix(node.ip.bytes().data(), node.ip.bytes().size());
+        }
+        mix_string(node.role);
+        mix_string(node.region);
+        // Stamped and unstamped views of the same metadata hash alike
+        const uint64_t metadata_hash = node.metadata_version != 0 ? node.metadata_hash : hash_metadata(node.metadata);
+        mix(&metadata_hash, sizeof(metadata_hash));
+        return h;
+    }
+
     // ---------------------------------------------------------
     // gossip_core member function implementations
     // ---------------------------------------------------------
 
     gossip_core::gossip_core(node_view self, send_callback sender, event_callback event_handler)
-        : self_(std::move(self)), send_fn_(std::move(sender)), event_fn_(std::move(event_handler)) {
+        : gossip_core(std::move(self), std::move(sender), std::move(event_handler), gossip_core_options{}) {
+    }
+
+    gossip_core::gossip_core(node_view self, send_callback sender, event_callback event_handler,
+                             const gossip_core_options &options)
+        : options_(options), self_(std::move(self)), send_fn_(std::move(sender)), event_fn_(std::move(event_handler)),
+          heartbeat_interval_(options.heartbeat_interval_ms), failure_timeout_(options.failure_timeout_ms),
+          gossip_nodes_(options.gossip_nodes), sync_nodes_(options.sync_nodes),
+          detector_(make_failure_detector(options)), health_(options.local_health_max),
+          events_(options.event_queue_capacity, options.event_overflow) {
         if (!send_fn_) {
             throw std::invalid_argument("send_callback cannot be null");
         }
         self_.status = node_status::online;
         self_.seen_time = clock::now();// Initialize
+        self_.stamp_metadata();
+
+        // Classes: suspect, unlisted regions, then region_priorities last to
+        // first. Failed members are not in the table, their tombstones make
+        // room for each other.
+        region_priorities_.assign(options_.region_priorities.begin(), options_.region_priorities.end());
+        adapt_fanout();
+        eviction_ = eviction_index(static_cast<uint32_t>(2 + region_priorities_.size()));
+        tombstones_ = tombstone_store(options_.max_nodes);
+
+        // Seed the peer-selection generator once; mixing in the instance
+        // address keeps cores created in the same instant apart. A fixed
+        // seed (simulations) makes the core's choices reproducible.
+        uint64_t seed = options_.seed;
+        if (seed == 0) {
+            std::random_device rd;
+            seed = (static_cast<uint64_t>(rd()) << 32) ^ rd();
+            seed ^= static_cast<uint64_t>(self_.seen_time.time_since_epoch().count());
+            seed ^= static_cast<uint64_t>(reinterpret_cast<std::uintptr_t>(this));
+        }
+        rng_.seed(seed);
+
+        if (options_.anti_entropy_interval_ms > 0) {
+            tree_ = std::make_unique<merkle_tree>();
+            tree_->set(0, 0, self_.id, merkle_tree::entry_hash(self_));
+            last_anti_entropy_ = self_.seen_time;
+        }
+        consider_representative(self_);
+        publish_snapshot();
     }
 
     void gossip_core::tick() {
-        std::lock_guard<std::mutex> lock(mutex_);
+        std::unique_lock<std::mutex> lock(mutex_);
         
         auto start_time = clock::now();
         self_.seen_time = start_time;
 
-        // Step 1: Randomly select target nodes and send PING
-        auto targets = select_random_peers(gossip_nodes_, &self_.id);
-        for (const auto &target: targets) {
-            gossip_message msg;
-            msg.sender = self_.id;
-            msg.type = message_type::ping;
-            msg.timestamp = self_.heartbeat;
-
-            // Carry self + additional nodes (anti-entropy)
-            msg.entries.clear();
-            msg.entries.push_back(self_);
-            auto extras = select_random_peers(sync_nodes_, &target.id);
-            msg.entries.insert(msg.entries.end(), extras.begin(), extras.end());
+        // Step 0: Local health: a late tick or pings left unanswered may mean
+        // we are the slow one, which stretches the timeouts used below
+        if (health_.enabled()) {
+            health_.tick(start_time, heartbeat_interval_);
+            health_.expire_probes(start_time, health_.scale(heartbeat_interval_));
+        }
 
-            send_fn_(msg, target);
+        // Step 1: Select probe targets (random or round-robin) and send PING
+        select_probe_targets(gossip_nodes_, targets_);
+        for (const auto &handle: targets_) {
+            const node_view &target = *nodes_.get(handle);
+            send_fn_(make_ping(target.id), target);
             sent_messages_++;
+            health_.probe_sent(handle, start_time);
         }
 
         // Step 2: Increment heartbeat
         self_.heartbeat++;
         self_.version++;
-
-        // Step 3: Failure detection
-        for (auto &node: nodes_) {
-            if (node.status == node_status::online) {
-                auto elapsed = std::chrono::duration_cast<duration_ms>(clock::now() - node.seen_time);
-                if (elapsed >= failure_timeout_) {
-                    auto old = node.status;
-                    node.status = node_status::suspect;
-                    node.suspicion_count++;
-                    node.last_suspected = clock::now();
-                    notify(node, old);
-                }
-            } else if (node.status == node_status::suspect) {
-                // Add suspicion count logic
-                auto elapsed = std::chrono::duration_cast<duration_ms>(clock::now() - node.last_suspected);
-                if (elapsed >= failure_timeout_) {
-                    node.suspicion_count++;
-                    node.last_suspected = clock::now();
-
-                    // If suspicion count exceeds threshold, mark as failed
-                    if (node.suspicion_count > 3) {
-                        auto old = node.status;
-                        node.status = node_status::failed;
-                        notify(node, old);
-                    }
-                }
+        publisher_.mark_self();
+
+        // Step 3: Failure detection (only nodes whose deadline passed)
+        run_failure_timers(start_time);
+
+        // Step 4: Forget indirect probes we could not complete in time
+        probe_relays_.erase(std::remove_if(probe_relays_.begin(), probe_relays_.end(),
+                                           [start_time](const probe_relay &r) { return r.deadline <= start_time; }),
+                            probe_relays_.end());
+
+        // Step 5: Merkle anti-entropy with a random peer, once per interval
+        heal_sync_started_ = false;
+        if (tree_ && start_time - last_anti_entropy_ >= duration_ms(options_.anti_entropy_interval_ms)) {
+            last_anti_entropy_ = start_time;
+            select_peers_by_region(1, nullptr, extras_);
+            if (!extras_.empty()) {
+                start_anti_entropy(*nodes_.get(extras_[0]));
             }
         }
 
+        // Step 6: Hierarchical: settle our group's representative, which
+        // shares the group directory with another group
+        if (options_.hierarchical) {
+            run_group_sync();
+        }
+
+        publish_snapshot();
+
+        local_health_score_ = health_.score();
+
         // Record tick duration
         auto end_time = clock::now();
         last_tick_duration_ = std::chrono::duration_cast<duration_ms>(end_time - start_time);
+
+        lock.unlock();
+        deliver_events();
     }
 
     void gossip_core::tick_full_broadcast() {
@@ -112,49 +459,69 @@ namespace libgossip {
         self_.seen_time = clock::now();
 
         // Send ping message to all online nodes
-        for (const auto &node: nodes_) {
+        nodes_.for_each([this](const node_view &node) {
             if (node.status == node_status::online) {
-                gossip_message msg;
-                msg.sender = self_.id;
-                msg.type = message_type::ping;
-                msg.timestamp = self_.heartbeat;
-
-                // Carry self + additional nodes (anti-entropy)
-                msg.entries.clear();
-                msg.entries.push_back(self_);
-                auto extras = select_random_peers(sync_nodes_, &node.id);
-                msg.entries.insert(msg.entries.end(), extras.begin(), extras.end());
-
-                send_fn_(msg, node);
+                send_fn_(make_ping(node.id), node);
                 sent_messages_++;
             }
-        }
+        });
 
         // Increment heartbeat
         self_.heartbeat++;
         self_.version++;
+        publisher_.mark_self();
+        publish_snapshot();
     }
 
     void gossip_core::handle_message(const gossip_message &msg, time_point recv_time) {
-        std::lock_guard<std::mutex> lock(mutex_);
-        
+        std::unique_lock<std::mutex> lock(mutex_);
+        process_message(msg, recv_time);
+        pinned_ = {};
+        local_health_score_ = health_.score();
+        publish_snapshot();
+
+        lock.unlock();
+        deliver_events();
+    }
+
+    void gossip_core::process_message(const gossip_message &msg, time_point recv_time) {
         LIBGOSSIP_LOG_DEBUG("handle_message: type=" << static_cast<int>(msg.type) << ", sender entries=" << msg.entries.size());
         received_messages_++;
-        node_view *sender = nullptr;
+        view_requests_.clear();
 
-        // First find sender in locally known nodes
-        for (auto &node: nodes_) {
-            if (node.id == msg.sender) {
-                sender = &node;
-                break;
+        // A message that waited an interval to be handled means a receive backlog
+        if (health_.enabled()) {
+            health_.receive_lag(clock::now() - recv_time, heartbeat_interval_);
+        }
+
+        // Any message from a node we are probing for someone else is its ack
+        if (!probe_relays_.empty()) {
+            complete_probe_relays(msg.sender);
+        }
+
+        if (options_.hierarchical && !msg.groups.empty()) {
+            merge_groups(msg.groups, recv_time);
+        }
+        // Directories come from other groups, whose members we do not hold
+        if (msg.type == message_type::group_sync || msg.type == message_type::group_sync_ack) {
+            if (msg.type == message_type::group_sync && options_.hierarchical && !msg.entries.empty()) {
+                send_group_sync(message_type::group_sync_ack, msg.entries[0]);
             }
+            return;
         }
 
-        // If sender is unknown, try to find from entries (used for MEET/JOIN)
-        if (!sender && (msg.type == message_type::meet || msg.type == message_type::join) && !msg.entries.empty()) {
+        // First find sender in locally known nodes
+        node_view *sender = nodes_.get(nodes_.find(msg.sender));
+
+        // If sender is unknown, try to find from entries (used for MEET/JOIN,
+        // and by a buried member that is back: its own view is newer)
+        bool newcomer = false;
+        if (!sender && (msg.type == message_type::meet || msg.type == message_type::join || tombstones_.find(msg.sender)) &&
+            !msg.entries.empty()) {
             for (const auto &entry: msg.entries) {
                 if (entry.id == msg.sender) {
-                    sender = &update_node(entry, recv_time);
+                    sender = update_node(entry, recv_time);
+                    newcomer = sender != nullptr;
                     break;
                 }
             }
@@ -165,21 +532,24 @@ namespace libgossip {
             // But still process entries to learn about new nodes and update temporary IDs
             for (const auto &remote: msg.entries) {
                 // Check if we need to update node ID based on IP:port match
-                auto it_by_addr = std::find_if(nodes_.begin(), nodes_.end(),
-                    [&remote](const node_view &n) {
-                        return n.ip == remote.ip && n.port == remote.port && n.id != remote.id;
-                    });
+                auto by_addr = nodes_.find_by_endpoint(
+                    make_endpoint_key(remote.ip, remote.port),
+                    [&remote](const node_view &n) { return n.id != remote.id; });
                 
-                if (it_by_addr != nodes_.end()) {
+                if (by_addr.valid()) {
                     // Found a node with matching IP:port but different ID
                     // Update the ID to the real ID
                     LIBGOSSIP_LOG_DEBUG("handle_message: updating node ID for " 
                         << remote.ip << ":" << remote.port);
-                    it_by_addr->id = remote.id;
+                    if (!nodes_.rekey(by_addr, remote.id) && nodes_.get(by_addr) != sender) {
+                        // The real ID is already known, so the address match is a stale duplicate
+                        erase_node(by_addr);
+                    }
                     
                     // If this entry is the sender, update sender pointer
                     if (remote.id == msg.sender) {
-                        sender = &(*it_by_addr);
+                        pinned_ = nodes_.find(remote.id);
+                        sender = nodes_.get(pinned_);
                     }
                 }
                 
@@ -194,12 +564,18 @@ namespace libgossip {
 
         // Update sender's status
         if (sender) {
+            const node_handle sender_handle = nodes_.find(sender->id);
+            pinned_ = sender_handle;// Entries below must not evict it
             auto old_status = sender->status;
             if (msg.timestamp > sender->heartbeat) {
                 sender->heartbeat = msg.timestamp;
             }
             sender->seen_time = recv_time;
+            detector_->heartbeat(sender_handle, recv_time);
             sender->version++;
+            if (msg.type == message_type::pong) {
+                health_.ack_received(sender_handle, recv_time, health_.scale(heartbeat_interval_));
+            }
 
             // Reset suspicion count, because we received a message from the node
             if (sender->status == node_status::suspect) {
@@ -214,11 +590,47 @@ namespace libgossip {
 
             // Handle leave message
             if (msg.type == message_type::leave) {
-                if (sender->status != node_status::failed) {
-                    sender->status = node_status::failed;
-                    notify(*sender, old_status);
+                sender->status = node_status::failed;
+                notify(*sender, old_status);
+                bury(sender_handle, recv_time);
+                sender = nullptr;
+            } else {
+                track_node(sender_handle);
+            }
+
+            // A member we held as suspect or failed (newcomer, as it was
+            // buried), or had never heard of, is talking to us: likely a
+            // healed partition, repair the full state
+            if (sender && tree_ && !heal_sync_started_ && (newcomer || old_status == node_status::suspect)) {
+                heal_sync_started_ = true;
+                start_anti_entropy(*sender);
+            }
+        }
+
+        // Anti-entropy messages carry tree hashes and digests, not gossip
+        if (msg.type == message_type::sync_tree || msg.type == message_type::sync_bucket) {
+            if (sender && tree_) {
+                if (msg.type == message_type::sync_tree) {
+                    handle_sync_tree(msg, *sender);
+                } else {
+                    handle_sync_bucket(msg, *sender, recv_time);
                 }
             }
+            return;
+        }
+
+        // Indirect probing messages carry their target, not gossip
+        if (msg.type == message_type::ping_req) {
+            if (sender) {
+                handle_ping_req(msg, *sender, recv_time);
+            }
+            return;
+        }
+        if (msg.type == message_type::indirect_ack) {
+            if (sender) {
+                handle_indirect_ack(msg, recv_time);
+            }
+            return;
         }
 
         // Handle entries (containing node information carried by the other party)
@@ -228,21 +640,19 @@ namespace libgossip {
             // Check if we need to update node ID based on IP:port match
             // This handles the case where we met a node with a temporary ID
             // and now receive its real ID
-            auto it_by_addr = std::find_if(nodes_.begin(), nodes_.end(),
-                [&remote](const node_view &n) {
-                    bool match = n.ip == remote.ip && n.port == remote.port && n.id != remote.id;
-                    if (match) {
-                        LIBGOSSIP_LOG_DEBUG("handle_message: found matching IP:port with different ID");
-                    }
-                    return match;
-                });
+            auto by_addr = nodes_.find_by_endpoint(
+                make_endpoint_key(remote.ip, remote.port),
+                [&remote](const node_view &n) { return n.id != remote.id; });
             
-            if (it_by_addr != nodes_.end()) {
+            if (by_addr.valid()) {
                 // Found a node with matching IP:port but different ID
                 // Update the ID to the real ID
                 LIBGOSSIP_LOG_DEBUG("handle_message: updating node ID for " 
                     << remote.ip << ":" << remote.port);
-                it_by_addr->id = remote.id;
+                if (!nodes_.rekey(by_addr, remote.id) && nodes_.get(by_addr) != sender) {
+                    // The real ID is already known, so the address match is a stale duplicate
+                    erase_node(by_addr);
+                }
             }
             
             update_node(remote, recv_time);
@@ -250,38 +660,52 @@ namespace libgossip {
 
         // Reply PONG
         if ((msg.type == message_type::ping || msg.type == message_type::meet || msg.type == message_type::join) && sender) {
-            gossip_message pong;
-            pong.sender = self_.id;
-            pong.type = message_type::pong;
-            pong.timestamp = self_.heartbeat;
-
-            pong.entries.clear();
-            pong.entries.push_back(self_);// Bring yourself
-            auto extras = select_random_peers(sync_nodes_, &msg.sender);
-            pong.entries.insert(pong.entries.end(), extras.begin(), extras.end());
+            gossip_message &pong = begin_message(message_type::pong);
+            // A newcomer has none of our metadata yet: no deltas for it
+            append_gossip_entries(pong, msg.sender, msg.type != message_type::ping);// Bring yourself + extras
+            reconcile_digests(msg, recv_time, true, pong);
+            append_view_requests(pong);
 
             send_fn_(pong, *sender);
             sent_messages_++;
+        } else if (sender && (!msg.digests.empty() || !view_requests_.empty())) {
+            // Digest exchange: ping -> pong (our digests, the views the pinger
+            // is behind on and requests for those we are behind on) -> update
+            // (requested and newer views, plus requests) -> update (views only).
+            // An update without digests ends the exchange.
+            gossip_message &reply = begin_message(message_type::update);
+            reply.entries.clear();
+            reconcile_digests(msg, recv_time, msg.type == message_type::pong, reply);
+            append_view_requests(reply);
+            if (!reply.entries.empty() || !reply.digests.empty()) {
+                send_fn_(reply, *sender);
+                sent_messages_++;
+            }
         }
     }
 
 
     void gossip_core::meet(const node_view &node) {
-        std::lock_guard<std::mutex> lock(mutex_);
+        std::unique_lock<std::mutex> lock(mutex_);
         
         if (node.id == self_.id) {
             return;
         }
+        if (!in_group(node)) {
+            introduce_group(node);
+            return;
+        }
 
-        // Record locally
-        auto it = std::find_if(nodes_.begin(), nodes_.end(),
-                               [&node](const node_view &n) { return n.id == node.id; });
-        if (it == nodes_.end()) {
+        // Record locally; being asked to means a buried node is back
+        if (!nodes_.find(node.id).valid()) {
+            const bool buried = tombstones_.erase(node.id);
+            tombstone_count_ = tombstones_.size();
             node_view nv = node;
             nv.status = node_status::joining;
             nv.seen_time = clock::now();
-            nodes_.push_back(nv);
-            notify(nv, node_status::unknown);
+            if (add_node(nv).valid()) {
+                notify(nv, buried ? node_status::failed : node_status::unknown);
+            }
         }
 
         // Proactively send MEET message to tell the other party about yourself
@@ -292,24 +716,33 @@ namespace libgossip {
         msg.entries.push_back(self_);// Bring yourself
         send_fn_(msg, node);
         sent_messages_++;
+
+        publish_snapshot();
+        lock.unlock();
+        deliver_events();
     }
 
     void gossip_core::join(const node_view &node) {
-        std::lock_guard<std::mutex> lock(mutex_);
+        std::unique_lock<std::mutex> lock(mutex_);
         
         if (node.id == self_.id) {
             return;
         }
+        if (!in_group(node)) {
+            introduce_group(node);
+            return;
+        }
 
-        // Record locally
-        auto it = std::find_if(nodes_.begin(), nodes_.end(),
-                               [&node](const node_view &n) { return n.id == node.id; });
-        if (it == nodes_.end()) {
+        // Record locally; being asked to means a buried node is back
+        if (!nodes_.find(node.id).valid()) {
+            const bool buried = tombstones_.erase(node.id);
+            tombstone_count_ = tombstones_.size();
             node_view nv = node;
             nv.status = node_status::joining;
             nv.seen_time = clock::now();
-            nodes_.push_back(nv);
-            notify(nv, node_status::unknown);
+            if (add_node(nv).valid()) {
+                notify(nv, buried ? node_status::failed : node_status::unknown);
+            }
         }
 
         // Proactively send JOIN message to tell the other party about yourself
@@ -320,199 +753,1331 @@ namespace libgossip {
         msg.entries.push_back(self_);// Bring yourself
         send_fn_(msg, node);
         sent_messages_++;
+
+        publish_snapshot();
+        lock.unlock();
+        deliver_events();
     }
 
     void gossip_core::leave(const node_id_t &node_id) {
-        std::lock_guard<std::mutex> lock(mutex_);
+        std::unique_lock<std::mutex> lock(mutex_);
         
-        auto it = std::find_if(nodes_.begin(), nodes_.end(),
-                               [&node_id](const node_view &n) { return n.id == node_id; });
-        if (it != nodes_.end()) {
+        node_view *leaving = nodes_.get(nodes_.find(node_id));
+        if (leaving) {
             // Notify other nodes that this node has left
             gossip_message msg;
             msg.sender = self_.id;
             msg.type = message_type::leave;
             msg.timestamp = self_.heartbeat;
-            msg.entries.push_back(*it);// Bring information of the leaving node
+            msg.entries.push_back(*leaving);// Bring information of the leaving node
 
             // Send to all online nodes
-            for (const auto &node: nodes_) {
+            nodes_.for_each([&](const node_view &node) {
                 if (node.status == node_status::online && node.id != node_id) {
                     send_fn_(msg, node);
                     sent_messages_++;
                 }
-            }
+            });
 
             // Update local status
-            auto old_status = it->status;
-            it->status = node_status::failed;
-            notify(*it, old_status);
+            auto old_status = leaving->status;
+            leaving->status = node_status::failed;
+            notify(*leaving, old_status);
+            bury(nodes_.find(node_id), clock::now());
+            publish_snapshot();
         }
+
+        lock.unlock();
+        deliver_events();
     }
 
 
     std::vector<node_view> gossip_core::get_nodes() const {
-        std::lock_guard<std::mutex> lock(mutex_);
-        
+        auto current = snapshot();
+
         std::vector<node_view> result;
-        result.reserve(nodes_.size());
-        for (const auto &node: nodes_) {
+        result.reserve(current->size());
+        current->for_each([&result](const node_view &node) {
             result.push_back(node);
-        }
+        });
         return result;
     }
 
     std::optional<node_view> gossip_core::find_node(const node_id_t &id) const {
+        auto current = snapshot();
+        if (const node_view *node = current->find(id)) {
+            return *node;
+        }
+        return std::nullopt;
+    }
+
+    std::optional<node_view> gossip_core::find_tombstone(const node_id_t &id) const {
         std::lock_guard<std::mutex> lock(mutex_);
-        
-        if (id == self_.id) {
-            return self_;
+
+        if (const node_view *node = tombstones_.find(id)) {
+            return *node;
         }
-        for (const auto &node: nodes_) {
-            if (node.id == id) {
-                return node;
-            }
+        return std::nullopt;
+    }
+
+    std::optional<double> gossip_core::suspicion_level(const node_id_t &id) const {
+        std::lock_guard<std::mutex> lock(mutex_);
+
+        node_handle handle = nodes_.find(id);
+        if (const node_view *node = nodes_.get(handle)) {
+            return detector_->suspicion(handle, *node, clock::now());
         }
         return std::nullopt;
     }
 
-    std::vector<node_view> gossip_core::select_random_peers(int k, const node_id_t *exclude) const {
-        std::vector<node_view> candidates;
-        std::copy_if(nodes_.begin(), nodes_.end(), std::back_inserter(candidates),
-                     [exclude](const node_view &n) {
-                         return exclude ? (n.id != *exclude) : true;
-                     });
+    void gossip_core::select_random_peers(int k, const node_id_t *exclude, std::vector<node_handle> &out) {
+        out.clear();
 
-        if (candidates.empty()) {
-            return {};
+        const size_t n = nodes_.size();
+        size_t excluded_pos = exclude ? nodes_.position_of(nodes_.find(*exclude)) : n;
+        // Candidates are positions [0, m); the excluded node, if stored, is
+        // swapped (virtually) to position n - 1 so it falls outside the range
+        const size_t m = excluded_pos < n ? n - 1 : n;
+        if (k <= 0 || m == 0) {
+            return;
+        }
+
+        const size_t count = std::min(static_cast<size_t>(k), m);
+        auto to_handle = [&](size_t pos) {
+            return nodes_.handle_at(pos == excluded_pos ? n - 1 : pos);
+        };
+
+        if (count == m) {
+            for (size_t pos = 0; pos < m; ++pos) {
+                out.push_back(to_handle(pos));
+            }
+        } else {
+            sample_positions(rng_, m, count, to_handle, out);
+        }
+
+        // Floyd's output is a uniform subset but not in uniform order
+        for (size_t i = out.size(); i > 1; --i) {
+            std::swap(out[i - 1], out[rng_.uniform(static_cast<uint32_t>(i))]);
+        }
+    }
+
+    void gossip_core::select_peers_by_region(int k, const node_id_t *exclude, std::vector<node_handle> &out) {
+        if (!options_.region_aware) {
+            select_random_peers(k, exclude, out);
+            return;
+        }
+        out.clear();
+        if (k <= 0) {
+            return;
         }
 
-        // High entropy random source
-        std::random_device rd;
-        auto seed_data = std::array<int, std::mt19937::state_size>{};
-        std::generate(seed_data.begin(), seed_data.end(), [&rd]() { return rd(); });
-        std::seed_seq seq(seed_data.begin(), seed_data.end());
-        std::mt19937 gen(seq);
+        // Each group's candidates are its positions [0, m); the excluded
+        // node is swapped (virtually) past the end, as in select_random_peers()
+        const node_handle excluded = exclude ? nodes_.find(*exclude) : node_handle{};
+        size_t available[2];
+        size_t excluded_pos[2];
+        for (auto g: {region_index::local, region_index::remote}) {
+            const size_t n = regions_.size(g);
+            excluded_pos[g] = excluded.valid() ? regions_.position_of(excluded, g) : n;
+            available[g] = excluded_pos[g] < n ? n - 1 : n;
+        }
 
-        // Perturbation
-        std::hash<std::thread::id> hash_thread;
-        gen.discard(1 + (hash_thread(std::this_thread::get_id()) ^
-                         static_cast<size_t>(clock::now().time_since_epoch().count())) %
-                                100);
+        size_t wanted[2] = {0, 0};
+        const auto threshold = static_cast<uint64_t>(std::clamp(options_.cross_region_fraction, 0.0, 1.0) * 4294967296.0);
+        for (int i = 0; i < k; ++i) {
+            ++wanted[(rng_() >> 32) < threshold ? region_index::remote : region_index::local];
+        }
+        // A group that runs short hands its picks to the other one
+        for (auto g: {region_index::local, region_index::remote}) {
+            const auto other = g == region_index::local ? region_index::remote : region_index::local;
+            if (wanted[g] > available[g]) {
+                wanted[other] += wanted[g] - available[g];
+                wanted[g] = available[g];
+            }
+        }
 
-        std::shuffle(candidates.begin(), candidates.end(), gen);
+        for (auto g: {region_index::local, region_index::remote}) {
+            const size_t count = std::min(wanted[g], available[g]);
+            if (count == 0) {
+                continue;
+            }
+            const size_t last = regions_.size(g) - 1;
+            sample_positions(
+                    rng_, available[g], count,
+                    [this, g, &excluded_pos, last](size_t pos) {
+                        return regions_.at(g, pos == excluded_pos[g] ? last : pos);
+                    },
+                    out);
+        }
 
-        int n = std::min(k, static_cast<int>(candidates.size()));
-        return std::vector<node_view>(candidates.begin(), candidates.begin() + n);
+        for (size_t i = out.size(); i > 1; --i) {
+            std::swap(out[i - 1], out[rng_.uniform(static_cast<uint32_t>(i))]);
+        }
     }
 
-    node_view &gossip_core::update_node(const node_view &remote, time_point seen_time) {
-        auto it = std::find_if(nodes_.begin(), nodes_.end(),
-                               [&remote](const node_view &n) { return n.id == remote.id; });
+    gossip_message &gossip_core::begin_message(message_type type) {
+        out_.sender = self_.id;
+        out_.type = type;
+        out_.timestamp = self_.heartbeat;
+        out_.digests.clear();
+        out_.tree.clear();
+        out_.groups.clear();
+        return out_;
+    }
 
-        if (it == nodes_.end()) {
-            node_view nv = remote;
-            nv.seen_time = seen_time;
+    const gossip_message &gossip_core::make_ping(const node_id_t &target) {
+        gossip_message &msg = begin_message(message_type::ping);
 
-            // Avoid UNKNOWN → UNKNOWN
-            if (nv.status == node_status::unknown) {
-                nv.status = node_status::joining;
+        // Carry self + additional nodes (anti-entropy)
+        append_gossip_entries(msg, target);
+        return msg;
+    }
+
+    void gossip_core::append_gossip_entries(gossip_message &msg, const node_id_t &target, bool full_metadata) {
+        if (options_.hierarchical) {
+            // Spread the directory's recent changes through our group; the
+            // representative also cycles through the rest of it
+            groups_.take(options_.max_piggyback_entries, retransmit_limit(), msg.groups);
+            if (representing_) {
+                groups_.rotate(options_.max_piggyback_entries, msg.groups);
             }
+        }
 
-            nodes_.push_back(nv);
-            auto &ref = nodes_.back();
-            notify(ref, node_status::unknown);
-            return ref;
-        } else {
-            auto old_status = it->status;
-            auto old_heartbeat = it->heartbeat;
-            auto old_config_epoch = it->config_epoch;
-            auto old_metadata = it->metadata;
-            
-            bool status_changed = false;
-            bool metadata_changed = false;
-            
-            // Use can_replace for version comparison
-            if (remote.can_replace(*it)) {
-                *it = remote;
-                it->seen_time = seen_time;
-                if (it->status == node_status::unknown) {
-                    it->status = node_status::joining;
-                }
-                status_changed = (old_status != it->status);
-                metadata_changed = (old_metadata != it->metadata);
-            } else if (remote.heartbeat == old_heartbeat && remote.config_epoch == old_config_epoch) {
-                // Even if can_replace returns false (same version), always update metadata
-                // This ensures metadata changes are propagated even without version increment
-                it->metadata = remote.metadata;
-                status_changed = (old_status != it->status);
-                metadata_changed = (old_metadata != it->metadata);
-            } else {
-                status_changed = (old_status != it->status);
-                metadata_changed = (old_metadata != it->metadata);
+        // Deaths spread by gossip in every mode, with their own retransmit budget
+        tombstones_.take(
+                options_.max_piggyback_entries, retransmit_limit(),
+                [&target](const node_view &dead) { return dead.id != target; }, obituaries_);
+
+        if (options_.dissemination == dissemination_mode::digest_sync) {
+            // Same peers as random_entries, but only their digests; the
+            // receiver asks for (or is sent) the views it is behind on.
+            // A digest cannot say a member is gone: tombstones go as views.
+            msg.entries.clear();
+            for (const node_view *dead: obituaries_) {
+                msg.entries.push_back(*dead);
             }
+            msg.digests.push_back(make_digest(self_));
+            select_random_peers(sync_nodes_, &target, extras_);
+            for (const auto &handle: extras_) {
+                msg.digests.push_back(make_digest(*nodes_.get(handle)));
+            }
+            return;
+        }
 
-            // Debug logging - removed to avoid log pollution
-            if (metadata_changed) {
-                LIBGOSSIP_LOG_DEBUG("update_node: metadata changed for node, status_changed=" << status_changed << ", metadata_changed=" << metadata_changed);
+        // Overwrite the entries in place, reusing their strings and maps.
+        // Metadata goes out as the keys written in the last
+        // metadata_delta_window versions; the keys a node started with only
+        // travel in full views, fetched by whoever sees a gap. A peer whose
+        // own view is unversioned (an older release, or one we only met) would
+        // take a delta for the whole map: it gets full maps.
+        size_t count = 0;
+        const node_view *peer = nodes_.get(nodes_.find(target));
+        const bool versioned = peer && peer->metadata_version != 0;
+        const uint64_t window = full_metadata || !versioned ? 0 : options_.metadata_delta_window;
+        auto put = [&msg, &count, window](const node_view &node) {
+            if (count == msg.entries.size()) {
+                msg.entries.emplace_back();
             }
+            const uint64_t since = window == 0 ? 0 : node.metadata_version > window ? node.metadata_version - window : 1;
+            msg.entries[count++].assign_delta(node, since);
+        };
+        put(self_);
+        for (const node_view *dead: obituaries_) {
+            put(*dead);
+        }
 
-            // Trigger notify if status changed OR metadata changed
-            if (status_changed || metadata_changed) {
-                LIBGOSSIP_LOG_DEBUG("update_node: calling notify for node, status_changed=" << status_changed << ", metadata_changed=" << metadata_changed);
-                notify(*it, old_status);
+        if (options_.dissemination == dissemination_mode::broadcast_queue) {
+            broadcasts_.take(
+                    options_.max_piggyback_entries, retransmit_limit(),
+                    [this, &target](node_handle h) { return nodes_.get(h)->id != target; }, piggyback_);
+            for (const auto &handle: piggyback_) {
+                put(*nodes_.get(handle));
+            }
+        } else {
+            select_random_peers(sync_nodes_, &target, extras_);
+            for (const auto &handle: extras_) {
+                put(*nodes_.get(handle));
             }
-            return *it;
         }
+        msg.entries.resize(count);
     }
 
+    node_digest gossip_core::make_digest(const node_view &node) noexcept {
+        return {node.id, node.heartbeat, node.config_epoch, state_hash(node)};
+    }
 
-    void gossip_core::notify(const node_view &node, node_status old_status) {
-        if (event_fn_) {
-            event_fn_(node, old_status);
+    void gossip_core::reconcile_digests(const gossip_message &msg, time_point recv_time, bool request_views,
+                                        gossip_message &reply) {
+        for (const auto &digest: msg.digests) {
+            const bool is_self = digest.id == self_.id;
+            const node_handle handle = is_self ? node_handle{} : nodes_.find(digest.id);
+            node_view *local = is_self ? &self_ : nodes_.get(handle);
+
+            // Order the digest against our view the same way update_node() does
+            node_view remote;
+            remote.heartbeat = digest.heartbeat;
+            remote.config_epoch = digest.config_epoch;
+
+            if (!local) {
+                // A node we buried is only worth asking for if it is back
+                const node_view *dead = tombstones_.find(digest.id);
+                if (request_views && (!dead || remote.can_replace(*dead))) {
+                    reply.digests.push_back({digest.id, 0, 0, 0});
+                }
+                continue;
+            }
+            if (digest.heartbeat == 0) {
+                reply.entries.push_back(*local);// Requested
+                continue;
+            }
+
+            const bool same_state = digest.state_hash == state_hash(*local);
+
+            if (local->can_replace(remote)) {
+                if (!same_state) {
+                    reply.entries.push_back(*local);
+                }
+            } else if (remote.can_replace(*local)) {
+                if (is_self) {
+                    continue;// Nobody knows us better than we do
+                }
+                if (same_state) {
+                    // Only the heartbeat moved: all a full view would have told us
+                    local->heartbeat = digest.heartbeat;
+                    local->config_epoch = digest.config_epoch;
+                    local->seen_time = recv_time;
+                    detector_->heartbeat(handle, recv_time);
+                    track_node(handle);
+                } else if (request_views) {
+                    reply.digests.push_back({digest.id, 0, 0, 0});
+                }
+            } else if (!same_state && digest.id == msg.sender && request_views) {
+                // The sender's heartbeat was already taken from the timestamp,
+                // but its own view changed as well
+                reply.digests.push_back({digest.id, 0, 0, 0});
+            }
         }
     }
 
-    void gossip_core::cleanup_expired(duration_ms timeout) {
-        std::lock_guard<std::mutex> lock(mutex_);
-        
-        auto now = clock::now();
-        auto expired = [timeout, now](const node_view &n) {
-            return (n.status != node_status::online) &&
-                   (std::chrono::duration_cast<duration_ms>(now - n.seen_time) > timeout);
-        };
-        nodes_.remove_if(expired);
+    void gossip_core::append_view_requests(gossip_message &reply) const {
+        for (const auto &id: view_requests_) {
+            if (std::none_of(reply.digests.begin(), reply.digests.end(),
+                             [&id](const node_digest &d) { return d.id == id && d.heartbeat == 0; })) {
+                reply.digests.push_back({id, 0, 0, 0});
+            }
+        }
+    }
+
+    uint32_t gossip_core::retransmit_limit() const noexcept {
+        // memberlist's formula; the cluster includes self
+        const auto cluster = static_cast<double>(nodes_.size() + 1);
+        const auto scale = static_cast<uint32_t>(std::ceil(std::log10(cluster + 1.0)));
+        return std::max<uint32_t>(1, options_.retransmit_mult * scale);
+    }
+
+    void gossip_core::select_probe_targets(int k, std::vector<node_handle> &out) {
+        if (options_.scheduler == probe_scheduler::round_robin) {
+            next_round_robin_targets(k, out);
+        } else {
+            select_peers_by_region(k, &self_.id, out);
+        }
+    }
+
+    void gossip_core::next_round_robin_targets(int k, std::vector<node_handle> &out) {
+        out.clear();
+        if (k <= 0 || nodes_.empty()) {
+            return;
+        }
+
+        bool reshuffled = false;
+        while (out.size() < static_cast<size_t>(k)) {
+            if (probe_cursor_ >= probe_order_.size()) {
+                // Never start more than one round per call, so a cluster
+                // smaller than k does not get the same member twice
+                if (reshuffled) {
+                    break;
+                }
+                reshuffled = true;
+
+                // New round: rebuild from the table (dropping stale handles) and shuffle
+                probe_order_.clear();
+                for (size_t pos = 0; pos < nodes_.size(); ++pos) {
+                    probe_order_.push_back(nodes_.handle_at(pos));
+                }
+                for (size_t i = probe_order_.size(); i > 1; --i) {
+                    std::swap(probe_order_[i - 1], probe_order_[rng_.uniform(static_cast<uint32_t>(i))]);
+                }
+                probe_cursor_ = 0;
+            }
+
+            node_handle handle = probe_order_[probe_cursor_++];
+            const node_view *node = nodes_.get(handle);
+            if (node && std::find(out.begin(), out.end(), handle) == out.end()) {
+                out.push_back(handle);
+            }
+        }
+    }
+
+    void gossip_core::schedule_new_member(node_handle handle) {
+        // Any position from the cursor to the end (inclusive) is still to be
+        // probed this round; swap the newcomer there in O(1)
+        const size_t pending = probe_order_.size() - probe_cursor_;
+        const size_t pos = probe_cursor_ + rng_.uniform(static_cast<uint32_t>(pending + 1));
+        probe_order_.push_back(handle);
+        std::swap(probe_order_[pos], probe_order_.back());
+    }
+
+    node_handle gossip_core::add_node(const node_view &node) {
+        if (!in_group(node)) {
+            return {};
+        }
+        if (!make_room(node)) {
+            nodes_rejected_++;
+            return {};
+        }
+        node_handle handle = nodes_.insert(node);
+        if (handle.valid()) {
+            adapt_fanout();
+            detector_->heartbeat(handle, node.seen_time);
+            track_node(handle);
+            if (options_.scheduler == probe_scheduler::round_robin) {
+                schedule_new_member(handle);
+            }
+        }
+        return handle;
+    }
+
+    bool gossip_core::make_room(const node_view &node) {
+        if (options_.max_nodes == 0 || nodes_.size() < options_.max_nodes) {
+            return true;
+        }
+        uint32_t below = eviction_class(node);
+        if (options_.eviction == eviction_policy::none) {
+            return false;
+        }
+        if (options_.eviction == eviction_policy::dead_only) {
+            below = std::min<uint32_t>(below, 1);
+        }
+        // Only ever a member of a lower class: a flood of made-up live
+        // members cannot push out live ones, and one in, one out keeps the
+        // table at max_nodes
+        const node_handle victim = eviction_.victim(below, pinned_);
+        if (!victim.valid()) {
+            return false;
+        }
+        erase_node(victim);
+        nodes_evicted_++;
+        return true;
+    }
+
+    void gossip_core::adapt_fanout() {
+        if (!options_.adaptive_fanout) {
+            gossip_nodes_stat_ = gossip_nodes_;
+            sync_nodes_stat_ = sync_nodes_;
+            return;
+        }
+
+        // A change spreads to N members in O(log N) rounds; a fanout and an
+        // entry count that grow as ln(N) keep the rounds (and the chance a
+        // member is missed) flat as the cluster grows
+        const auto cluster = static_cast<double>(nodes_.size() + 1);
+        const int level = static_cast<int>(std::ceil(std::log(cluster)));
+        int fanout = std::max(options_.gossip_nodes, level);
+        int entries = std::max(options_.sync_nodes, level);
+
+        if (options_.tick_budget_bytes > 0) {
+            // Give up entries first, then pings, but keep one of each
+            const size_t entry = options_.dissemination == dissemination_mode::digest_sync
+                                         ? config::ESTIMATED_DIGEST_BYTES
+                                         : config::ESTIMATED_VIEW_BYTES + metadata_bytes(self_.metadata);
+            const size_t budget = options_.tick_budget_bytes;
+            auto cost = [entry](int f, int e) {
+                return static_cast<size_t>(f) * (config::ESTIMATED_MESSAGE_BYTES + static_cast<size_t>(1 + e) * entry);
+            };
+            if (cost(fanout, entries) > budget) {
+                const size_t per_message = budget / static_cast<size_t>(fanout);
+                const size_t fits = per_message > config::ESTIMATED_MESSAGE_BYTES + entry
+                                            ? (per_message - config::ESTIMATED_MESSAGE_BYTES) / entry - 1
+                                            : 0;
+                entries = std::max(1, static_cast<int>(std::min<size_t>(fits, static_cast<size_t>(entries))));
+            }
+            if (cost(fanout, entries) > budget) {
+                fanout = std::max(1, static_cast<int>(budget / cost(1, entries)));
+            }
+        }
+
+        gossip_nodes_ = fanout;
+        sync_nodes_ = entries;
+        gossip_nodes_stat_ = fanout;
+        sync_nodes_stat_ = entries;
+    }
+
+    uint32_t gossip_core::eviction_class(const node_view &node) const noexcept {
+        if (node.status == node_status::suspect || node.status == node_status::failed) {
+            return 0;// A failed newcomer is buried, never admitted
+        }
+        const auto ranks = static_cast<uint32_t>(region_priorities_.size());
+        for (uint32_t i = 0; i < ranks; ++i) {
+            if (node.region == region_priorities_[i]) {
+                return 1 + ranks - i;
+            }
+        }
+        return 1;// Unlisted region
+    }
+
+    bool gossip_core::eligible_representative(const node_view &node) const noexcept {
+        return options_.representative_role.empty() || node.role == options_.representative_role;
+    }
+
+    void gossip_core::consider_representative(const node_view &node) {
+        if (!options_.hierarchical) {
+            return;
+        }
+        const bool candidate = node.status == node_status::online && eligible_representative(node);
+        if (has_representative_ && node.id == representative_) {
+            representative_lost_ |= !candidate;
+            return;
+        }
+        // Lower than the lowest candidate (lost or not) is the lowest now
+        if (candidate && (!has_representative_ || node.id < representative_)) {
+            representative_ = node.id;
+            has_representative_ = true;
+            representative_lost_ = false;
+        }
+    }
+
+    void gossip_core::elect_representative() {
+        has_representative_ = false;
+        consider_representative(self_);
+        nodes_.for_each([this](const node_view &node) { consider_representative(node); });
+        representative_lost_ = false;
+    }
+
+    void gossip_core::run_group_sync() {
+        if (representative_lost_) {
+            elect_representative();
+        }
+
+        const bool representing = has_representative_ && representative_ == self_.id;
+        const group_summary *ours = groups_.find(self_.region);
+        if (representing && !representing_) {
+            // A new term supersedes whatever our previous representative published
+            group_term_ = std::max(group_term_, ours ? ours->term : 0) + 1;
+            group_version_ = 0;
+        }
+        representing_ = representing;
+        representative_stat_ = representing;
+        if (!representing_) {
+            groups_stat_ = groups_.size();
+            return;
+        }
+
+        const auto members = static_cast<uint32_t>(nodes_.size() + 1);
+        if (!ours || ours->term != group_term_ || ours->representative.id != self_.id || ours->members != members) {
+            group_summary summary;
+            summary.group = self_.region;
+            summary.representative = contact_view(self_);
+            summary.term = group_term_;
+            summary.version = ++group_version_;
+            summary.members = members;
+            groups_.merge(summary);
+        }
+        groups_stat_ = groups_.size();
+
+        // Push the directory to one other group per tick; its answer brings theirs
+        if (groups_.size() > 1) {
+            auto pick = rng_.uniform(static_cast<uint32_t>(groups_.size() - 1));
+            for (size_t pos = 0; pos < groups_.size(); ++pos) {
+                if (groups_.at(pos).group == self_.region) {
+                    continue;
+                }
+                if (pick-- == 0) {
+                    send_group_sync(message_type::group_sync, groups_.at(pos).representative);
+                    break;
+                }
+            }
+        }
+    }
+
+    void gossip_core::merge_groups(const std::vector<group_summary> &groups, time_point recv_time) {
+        for (const auto &summary: groups) {
+            if (summary.group != self_.region) {
+                groups_.merge(summary);
+                continue;
+            }
+            if (representing_) {
+                // Someone else spoke for our group in our term (before it saw
+                // us, or across a partition): outbid it on the next tick
+                if (summary.representative.id != self_.id && summary.term >= group_term_) {
+                    group_term_ = summary.term + 1;
+                    group_version_ = 0;
+                }
+                continue;
+            }
+            // A representative we never heard of is how a lone member finds its group
+            const node_view &representative = summary.representative;
+            if (groups_.merge(summary) && representative.id != self_.id && in_group(representative) &&
+                !nodes_.find(representative.id).valid()) {
+                update_node(representative, recv_time);
+            }
+        }
+        groups_stat_ = groups_.size();
+    }
+
+    void gossip_core::introduce_group(const node_view &node) {
+        if (!groups_.find(node.region)) {
+            group_summary contact;
+            contact.group = node.region;
+            contact.representative = contact_view(node);
+            groups_.merge(contact);// Term 0: replaced by the first summary from that group
+            groups_stat_ = groups_.size();
+        }
+        send_group_sync(message_type::group_sync, node);
+    }
+
+    void gossip_core::send_group_sync(message_type type, const node_view &target) {
+        gossip_message &msg = begin_message(type);
+        msg.entries.resize(1);
+        msg.entries[0].assign(self_);
+        groups_.append_all(msg.groups);
+        send_fn_(msg, target);
+        sent_messages_++;
+    }
+
+    std::vector<group_summary> gossip_core::get_groups() const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        std::vector<group_summary> out;
+        groups_.append_all(out);
+        return out;
+    }
+
+    void gossip_core::erase_node(node_handle handle) {
+        if (has_representative_) {
+            const node_view *node = nodes_.get(handle);
+            representative_lost_ |= node && node->id == representative_;
+        }
+        detector_->forget(handle);
+        eviction_.remove(handle.index);
+        regions_.remove(handle.index);
+        if (nodes_.erase(handle)) {
+            adapt_fanout();
+            publisher_.mark(handle.index);
+            failure_timers_.cancel(handle.index);
+            expiry_timers_.cancel(handle.index);
+            broadcasts_.remove(handle.index);
+            if (tree_) {
+                tree_->remove(handle.index + 1);
+            }
+            pending_probes_.erase(std::remove_if(pending_probes_.begin(), pending_probes_.end(),
+                                                 [handle](const pending_probe &p) { return p.target == handle; }),
+                                  pending_probes_.end());
+        }
+    }
+
+    void gossip_core::bury(node_handle handle, time_point died) {
+        if (const node_view *node = nodes_.get(handle)) {
+            tombstones_.bury(*node, died);
+            tombstone_count_ = tombstones_.size();
+            erase_node(handle);
+        }
+    }
+
+    bool gossip_core::defer_escalation(node_handle handle, const node_view &node, time_point now) {
+        auto pending = std::find_if(pending_probes_.begin(), pending_probes_.end(),
+                                    [handle](const pending_probe &p) { return p.target == handle; });
+        if (pending != pending_probes_.end()) {
+            if (now < pending->deadline) {
+                failure_timers_.schedule(handle.index, handle.generation, wheel_tick(pending->deadline));
+                return true;
+            }
+            // Nobody reached the node either: escalate
+            pending_probes_.erase(pending);
+            indirect_probe_timeouts_++;
+            return false;
+        }
+
+        if (options_.indirect_probes <= 0) {
+            return false;
+        }
+
+        // Ask online members other than the node itself; sample a few extra
+        // since some of the picks may not be online
+        select_peers_by_region(2 * options_.indirect_probes, &node.id, helpers_);
+        gossip_message req;
+        req.sender = self_.id;
+        req.type = message_type::ping_req;
+        req.timestamp = self_.heartbeat;
+        req.entries.push_back(node);
+        int asked = 0;
+        for (const auto &helper: helpers_) {
+            const node_view &peer = *nodes_.get(helper);
+            if (peer.status != node_status::online) {
+                continue;
+            }
+            send_fn_(req, peer);
+            sent_messages_++;
+            indirect_probes_sent_++;
+            if (++asked == options_.indirect_probes) {
+                break;
+            }
+        }
+        if (asked == 0) {
+            return false;
+        }
+
+        const time_point deadline = now + health_.scale(duration_ms(options_.indirect_probe_timeout_ms));
+        pending_probes_.push_back({handle, deadline});
+        failure_timers_.schedule(handle.index, handle.generation, wheel_tick(deadline));
+        return true;
+    }
+
+    void gossip_core::handle_ping_req(const gossip_message &msg, const node_view &requester, time_point recv_time) {
+        if (msg.entries.empty() || msg.entries[0].id == self_.id || msg.entries[0].id == requester.id) {
+            return;
+        }
+        const node_view &target = msg.entries[0];
+
+        // Probe with the address we know, falling back to the requester's
+        const node_view *known = nodes_.get(nodes_.find(target.id));
+        send_fn_(make_ping(target.id), known ? *known : target);
+        sent_messages_++;
+
+        probe_relays_.push_back({target.id, requester.id, recv_time + duration_ms(options_.indirect_probe_timeout_ms)});
+    }
+
+    void gossip_core::complete_probe_relays(const node_id_t &target) {
+        for (size_t i = 0; i < probe_relays_.size();) {
+            if (probe_relays_[i].target != target) {
+                ++i;
+                continue;
+            }
+
+            const node_view *requester = nodes_.get(nodes_.find(probe_relays_[i].requester));
+            const node_view *reached = nodes_.get(nodes_.find(target));
+            if (requester && reached) {
+                gossip_message ack;
+                ack.sender = self_.id;
+                ack.type = message_type::indirect_ack;
+                ack.timestamp = self_.heartbeat;
+                ack.entries.push_back(*reached);
+                send_fn_(ack, *requester);
+                sent_messages_++;
+            }
+            probe_relays_[i] = probe_relays_.back();
+            probe_relays_.pop_back();
+        }
+    }
+
+    void gossip_core::handle_indirect_ack(const gossip_message &msg, time_point recv_time) {
+        if (msg.entries.empty()) {
+            return;
+        }
+        const node_handle handle = nodes_.find(msg.entries[0].id);
+        auto pending = std::find_if(pending_probes_.begin(), pending_probes_.end(),
+                                    [handle](const pending_probe &p) { return p.target == handle; });
+        if (pending == pending_probes_.end()) {
+            return;// Late or duplicate ack
+        }
+        pending_probes_.erase(pending);
+        indirect_probe_rescues_++;
+
+        // The node is alive, only our link to it is not
+        node_view &node = *nodes_.get(handle);
+        node.seen_time = recv_time;
+        detector_->heartbeat(handle, recv_time);
+        if (node.status == node_status::suspect) {
+            node.status = node_status::online;
+            node.suspicion_count = 0;
+            notify(node, node_status::suspect);
+        }
+        track_node(handle);
+    }
+
+    void gossip_core::start_anti_entropy(const node_view &peer) {
+        gossip_message msg;
+        msg.sender = self_.id;
+        msg.type = message_type::sync_tree;
+        msg.timestamp = self_.heartbeat;
+        msg.tree.push_back({0, tree_->root()});
+        send_fn_(msg, peer);
+        sent_messages_++;
+        anti_entropy_sessions_++;
+    }
+
+    void gossip_core::handle_sync_tree(const gossip_message &msg, const node_view &peer) {
+        gossip_message descend;
+        descend.sender = self_.id;
+        descend.type = message_type::sync_tree;
+        descend.timestamp = self_.heartbeat;
+        gossip_message buckets = descend;
+        buckets.type = message_type::sync_bucket;
+
+        for (const auto &node: msg.tree) {
+            if (node.index >= merkle_tree::node_count || tree_->hash(node.index) == node.hash) {
+                continue;
+            }
+            if (!merkle_tree::is_leaf(node.index)) {
+                const uint32_t first = merkle_tree::first_child(node.index);
+                for (uint32_t child = first; child < first + merkle_tree::fanout; ++child) {
+                    descend.tree.push_back({child, tree_->hash(child)});
+                }
+            } else if (buckets.digests.size() < options_.anti_entropy_max_digests) {
+                // Leaves over the budget are left for a later session
+                buckets.tree.push_back({node.index, tree_->hash(node.index)});
+                append_bucket_digests(node.index, buckets.digests);
+            }
+        }
+
+        for (auto *reply: {&descend, &buckets}) {
+            if (!reply->tree.empty()) {
+                send_fn_(*reply, peer);
+                sent_messages_++;
+            }
+        }
+    }
+
+    void gossip_core::handle_sync_bucket(const gossip_message &msg, const node_view &peer, time_point recv_time) {
+        gossip_message reply;
+        reply.sender = self_.id;
+        reply.type = message_type::update;
+        reply.timestamp = self_.heartbeat;
+
+        // What the peer listed: views it is behind on, requests for ours
+        reconcile_digests(msg, recv_time, true, reply);
+
+        // What the peer did not list at all
+        for (const auto &leaf: msg.tree) {
+            if (!merkle_tree::is_leaf(leaf.index) || leaf.index >= merkle_tree::node_count) {
+                continue;
+            }
+            anti_entropy_buckets_++;
+            tree_->for_each_in_leaf(leaf.index, [&](uint32_t key, uint32_t generation) {
+                const node_view *node = key == 0 ? &self_ : nodes_.get({key - 1, generation});
+                if (node && std::none_of(msg.digests.begin(), msg.digests.end(),
+                                         [node](const node_digest &d) { return d.id == node->id; })) {
+                    reply.entries.push_back(*node);
+                }
+            });
+        }
+
+        if (!reply.entries.empty() || !reply.digests.empty()) {
+            send_fn_(reply, peer);
+            sent_messages_++;
+        }
+    }
+
+    void gossip_core::append_bucket_digests(uint32_t leaf, std::vector<node_digest> &out) const {
+        tree_->for_each_in_leaf(leaf, [&](uint32_t key, uint32_t generation) {
+            const node_view *node = key == 0 ? &self_ : nodes_.get({key - 1, generation});
+            if (node) {
+                out.push_back(make_digest(*node));
+            }
+        });
+    }
+
+    void gossip_core::track_node(node_handle handle) {
+        const node_view *node = nodes_.get(handle);
+        if (!node) {
+            return;
+        }
+        publisher_.mark(handle.index);
+        eviction_.touch(handle, eviction_class(*node));
+        if (options_.region_aware) {
+            regions_.place(handle, node->region == self_.region ? region_index::local : region_index::remote);
+        }
+        consider_representative(*node);
+        if (tree_) {
+            tree_->set(handle.index + 1, handle.generation, node->id, merkle_tree::entry_hash(*node));
+        }
+        if (node->status == node_status::online) {
+            failure_timers_.schedule(handle.index, handle.generation, wheel_tick(suspect_deadline(handle, *node)));
+        } else if (node->status == node_status::suspect) {
+            failure_timers_.schedule(handle.index, handle.generation,
+                                     wheel_tick(node->last_suspected + health_.scale(failure_timeout_)));
+        }
+        if (node->status != node_status::online) {
+            expiry_timers_.schedule(handle.index, handle.generation, wheel_tick(node->seen_time));
+        }
+    }
+
+    time_point gossip_core::suspect_deadline(node_handle handle, const node_view &node) const noexcept {
+        const time_point deadline = detector_->suspect_deadline(handle, node);
+        if (health_.multiplier() == 1 || deadline <= node.seen_time) {
+            return deadline;
+        }
+        return node.seen_time + (deadline - node.seen_time) * health_.multiplier();
+    }
+
+    void gossip_core::run_failure_timers(time_point now) {
+        failure_timers_.advance(wheel_tick(now), [&](uint32_t index, uint32_t generation) {
+            node_handle handle{index, generation};
+            node_view *node = nodes_.get(handle);
+            if (!node) {
+                return;// Erased since the timer was armed
+            }
+
+            if (node->status == node_status::online) {
+                if (now >= suspect_deadline(handle, *node)) {
+                    if (defer_escalation(handle, *node, now)) {
+                        return;
+                    }
+                    auto old = node->status;
+                    node->status = node_status::suspect;
+                    node->suspicion_count++;
+                    node->last_suspected = now;
+                    notify(*node, old);
+                }
+            } else if (node->status == node_status::suspect) {
+                // Add suspicion count logic
+                auto elapsed = std::chrono::duration_cast<duration_ms>(now - node->last_suspected);
+                if (elapsed >= health_.scale(failure_timeout_)) {
+                    if (node->suspicion_count + 1 > 3 && defer_escalation(handle, *node, now)) {
+                        return;
+                    }
+                    node->suspicion_count++;
+                    node->last_suspected = now;
+
+                    // If suspicion count exceeds threshold, mark as failed
+                    if (node->suspicion_count > 3) {
+                        auto old = node->status;
+                        node->status = node_status::failed;
+                        notify(*node, old);
+                        bury(handle, now);
+                        return;
+                    }
+                }
+            }
+
+            // Not due yet (seen again since arming) or still suspect: re-arm
+            track_node(handle);
+        });
+    }
+
+    node_view *gossip_core::update_node(const node_view &remote, time_point seen_time) {
+        if (remote.id == self_.id) {
+            return nullptr;// Nobody knows us better than we do; our next heartbeat refutes a tombstone
+        }
+        node_handle handle = nodes_.find(remote.id);
+        node_view *current = nodes_.get(handle);
+
+        if (!current) {
+            if (!in_group(remote)) {
+                return nullptr;// Another group's member: only its group summary is kept
+            }
+            // A buried node only comes back with a newer view: stale gossip
+            // about it is ignored for as long as its tombstone is retained
+            node_status old_status = node_status::unknown;
+            const node_view *dead = tombstones_.find(remote.id);
+            if (dead && !remote.can_replace(*dead)) {
+                return nullptr;
+            }
+            if (remote.status == node_status::failed) {
+                tombstones_.bury(remote, seen_time);// Dead on arrival, never admitted
+                tombstone_count_ = tombstones_.size();
+                return nullptr;
+            }
+            if (dead) {
+                tombstones_.erase(remote.id);
+                tombstone_count_ = tombstones_.size();
+                old_status = node_status::failed;
+            }
+
+            node_view nv = remote;
+            nv.seen_time = seen_time;
+            const bool delta = nv.metadata_since != 0;
+            const bool oversized = !delta && metadata_bytes(nv.metadata) > options_.metadata_size_limit;
+            if (delta || oversized) {
+                // A delta is nothing to build on, an oversized map is not taken
+                nv.metadata.clear();
+                nv.metadata_versions.clear();
+                nv.metadata_version = 0;
+                nv.metadata_hash = 0;
+                nv.metadata_since = 0;
+            }
+
+            // Avoid UNKNOWN → UNKNOWN
+            if (nv.status == node_status::unknown) {
+                nv.status = node_status::joining;
+            }
+
+            node_view *added = nodes_.get(add_node(nv));
+            if (!added) {
+                return nullptr;
+            }
+            if (delta) {
+                request_full_view(added->id);
+            } else if (oversized) {
+                metadata_rejected_++;
+            }
+            notify(*added, old_status);
+            return added;
+        } else {
+            auto old_status = current->status;
+            auto old_heartbeat = current->heartbeat;
+            auto old_config_epoch = current->config_epoch;
+            
+            bool status_changed = false;
+            bool metadata_changed = false;
+
+            // Tracked metadata is merged key by key whatever the heartbeats
+            // say, its versions order it; untracked maps replace ours whole
+            const bool tracked = remote.metadata_version != 0;
+
+            // Use can_replace for version comparison. A death wins at the
+            // same version: the member refutes it with its next heartbeat.
+            const bool dies = remote.status == node_status::failed && !current->can_replace(remote);
+            if (remote.can_replace(*current) || dies) {
+                current->assign_without_metadata(remote);
+                if (!tracked) {
+                    metadata_changed = replace_metadata(*current, remote);
+                }
+                nodes_.refresh_endpoint(handle);
+                current->seen_time = seen_time;
+                detector_->heartbeat(handle, seen_time);
+                if (current->status == node_status::unknown) {
+                    current->status = node_status::joining;
+                }
+                status_changed = (old_status != current->status);
+            } else if (remote.heartbeat == old_heartbeat && remote.config_epoch == old_config_epoch) {
+                // Even if can_replace returns false (same version), always update metadata
+                // This ensures metadata changes are propagated even without version increment
+                if (!tracked) {
+                    metadata_changed = replace_metadata(*current, remote);
+                }
+                status_changed = (old_status != current->status);
+            } else {
+                status_changed = (old_status != current->status);
+            }
+            if (tracked) {
+                metadata_changed = merge_metadata(*current, remote);
+            }
+
+            // Debug logging - removed to avoid log pollution
+            if (metadata_changed) {
+                LIBGOSSIP_LOG_DEBUG("update_node: metadata changed for node, status_changed=" << status_changed << ", metadata_changed=" << metadata_changed);
+            }
+
+            // Trigger notify if status changed OR metadata changed
+            if (status_changed || metadata_changed) {
+                LIBGOSSIP_LOG_DEBUG("update_node: calling notify for node, status_changed=" << status_changed << ", metadata_changed=" << metadata_changed);
+                notify(*current, old_status);
+            }
+
+            if (current->status == node_status::failed) {
+                bury(handle, seen_time);// A newer view says it left
+                return nullptr;
+            }
+            track_node(handle);
+            return current;
+        }
+    }
+
+
+    bool gossip_core::replace_metadata(node_view &current, const node_view &remote) {
+        if (current.same_metadata(remote)) {
+            return false;
+        }
+        if (metadata_bytes(remote.metadata) > options_.metadata_size_limit) {
+            metadata_rejected_++;
+            return false;
+        }
+        current.metadata = remote.metadata;
+        current.metadata_versions.clear();
+        current.metadata_version = 0;
+        current.metadata_hash = 0;
+        return true;
+    }
+
+    bool gossip_core::merge_metadata(node_view &current, const node_view &remote) {
+        switch (current.merge_metadata(remote, options_.metadata_size_limit)) {
+            case metadata_merge::changed:
+                return true;
+            case metadata_merge::gap:
+                request_full_view(remote.id);
+                return false;
+            case metadata_merge::rejected:
+                metadata_rejected_++;
+                return false;
+            default:
+                return false;
+        }
+    }
+
+    void gossip_core::request_full_view(const node_id_t &id) {
+        if (std::find(view_requests_.begin(), view_requests_.end(), id) == view_requests_.end()) {
+            view_requests_.push_back(id);
+            metadata_requests_++;
+        }
+    }
+
+    void gossip_core::notify(const node_view &node, node_status old_status) {
+        if (options_.dissemination == dissemination_mode::broadcast_queue) {
+            node_handle handle = nodes_.find(node.id);
+            if (handle.valid()) {
+                broadcasts_.push(handle);
+            }
+        }
+        std::lock_guard<std::mutex> lock(events_mutex_);
+        if (!event_fn_ && !batch_fn_) {
+            return;
+        }
+        if (!events_.push(node, old_status, clock::now())) {
+            events_dropped_ = events_.dropped();
+        }
+        event_queue_depth_ = events_.size();
+        event_queue_peak_ = events_.peak();
+    }
+
+    size_t gossip_core::dispatch_events() {
+        // One dispatcher at a time keeps delivery in queue order. Whoever finds
+        // another one active (including a callback calling back into the core)
+        // leaves its events to it; the active one drains until the queue is empty.
+        size_t delivered = 0;
+        while (!dispatching_.exchange(true, std::memory_order_acquire)) {
+            try {
+                batch_event_callback batch_callback;
+                {
+                    std::lock_guard<std::mutex> lock(events_mutex_);
+                    batch_callback = batch_fn_;
+                }
+                delivered += batch_callback ? deliver_batch(batch_callback) : deliver_each();
+            } catch (...) {
+                dispatching_.store(false, std::memory_order_release);
+                throw;
+            }
+            dispatching_.store(false, std::memory_order_release);
+
+            // An event queued after our last pop but before the store above
+            // found us still dispatching: pick it up
+            std::lock_guard<std::mutex> lock(events_mutex_);
+            if (events_.empty()) {
+                break;
+            }
+        }
+        return delivered;
+    }
+
+    size_t gossip_core::deliver_each() {
+        size_t delivered = 0;
+        while (true) {
+            {
+                std::lock_guard<std::mutex> lock(events_mutex_);
+                if (!events_.pop(dispatch_slot_)) {
+                    break;
+                }
+                event_queue_depth_ = events_.size();
+            }
+            record_event_latency(dispatch_slot_.queued_at);
+            delivered++;
+            if (event_fn_) {
+                event_fn_(dispatch_slot_.node, dispatch_slot_.old_status);
+            }
+        }
+        return delivered;
+    }
+
+    size_t gossip_core::deliver_batch(const batch_event_callback &callback) {
+        size_t delivered = 0;
+        batch_.clear();
+        while (true) {
+            {
+                std::lock_guard<std::mutex> lock(events_mutex_);
+                if (!events_.pop(dispatch_slot_)) {
+                    break;
+                }
+                event_queue_depth_ = events_.size();
+            }
+            record_event_latency(dispatch_slot_.queued_at);
+            delivered++;
+            batch_.add(dispatch_slot_);
+        }
+        batch_.finish();
+        if (!batch_.empty()) {
+            event_batches_++;
+            callback(batch_.changes());
+        }
+        return delivered;
+    }
+
+    void gossip_core::record_event_latency(time_point queued_at) {
+        const int64_t latency =
+                std::chrono::duration_cast<std::chrono::microseconds>(clock::now() - queued_at).count();
+        event_latency_total_us_ += latency;
+        if (latency > event_latency_max_us_) {
+            event_latency_max_us_ = latency;// Only the dispatcher writes it
+        }
+        events_delivered_++;
+    }
+
+    void gossip_core::set_batch_event_callback(batch_event_callback callback) {
+        std::lock_guard<std::mutex> lock(events_mutex_);
+        batch_fn_ = std::move(callback);
+    }
+
+    void gossip_core::deliver_events() {
+        if (options_.delivery == event_delivery::after_unlock && event_queue_depth_.load() != 0) {
+            dispatch_events();
+        }
+    }
+
+    void gossip_core::cleanup_expired(duration_ms timeout) {
+        std::unique_lock<std::mutex> lock(mutex_);
+        
+        auto now = clock::now();
+        auto expired = [timeout, now](const node_view &n) {
+            return (n.status != node_status::online) &&
+                   (std::chrono::duration_cast<duration_ms>(now - n.seen_time) > timeout);
+        };
+
+        // Tombstones are kept for timeout after the node was buried; they are
+        // queued in that order, so this only pops from the front
+        tombstones_.expire(now - timeout);
+        tombstone_count_ = tombstones_.size();
+
+        // Every live node that is not online (joining or suspect) has an
+        // expiry timer at (or before) its seen_time, so advancing the wheel to
+        // now - timeout visits all the candidates. The wheel cannot go back:
+        // if the timeout grew since the last call, rebuild it from the table
+        // instead.
+        const int64_t cutoff = wheel_tick(now - timeout);
+        if (cutoff < expiry_timers_.cursor()) {
+            expiry_timers_.clear();
+            for (size_t pos = 0; pos < nodes_.size(); ++pos) {
+                track_node(nodes_.handle_at(pos));
+            }
+        }
+
+        expiry_timers_.advance(cutoff, [&](uint32_t index, uint32_t generation) {
+            node_handle handle{index, generation};
+            const node_view *node = nodes_.get(handle);
+            if (!node || node->status == node_status::online) {
+                return;// Re-armed by track_node() when it stops being online
+            }
+            if (expired(*node)) {
+                erase_node(handle);
+            } else {
+                track_node(handle);
+            }
+        });
+
+        publish_snapshot();
+        lock.unlock();
+        deliver_events();
     }
 
     void gossip_core::reset() {
         std::lock_guard<std::mutex> lock(mutex_);
         
         nodes_.clear();
+        publisher_.clear();
+        probe_order_.clear();
+        probe_cursor_ = 0;
+        failure_timers_.clear();
+        expiry_timers_.clear();
+        detector_->clear();
+        health_.clear();
+        local_health_score_ = 0;
+        pending_probes_.clear();
+        probe_relays_.clear();
+        broadcasts_.clear();
+        eviction_.clear();
+        regions_.clear();
+        groups_.clear();
+        has_representative_ = false;
+        representative_lost_ = false;
+        representing_ = false;
+        group_term_ = 0;
+        group_version_ = 0;
+        groups_stat_ = 0;
+        representative_stat_ = false;
+        tombstones_.clear();
+        tombstone_count_ = 0;
         self_.heartbeat = 1;
         self_.version = 0;
         self_.seen_time = clock::now();
+        adapt_fanout();
+        consider_representative(self_);
+        if (tree_) {
+            tree_->clear();
+            tree_->set(0, 0, self_.id, merkle_tree::entry_hash(self_));
+            last_anti_entropy_ = self_.seen_time;
+        }
         sent_messages_ = 0;
         received_messages_ = 0;
+        indirect_probes_sent_ = 0;
+        indirect_probe_rescues_ = 0;
+        indirect_probe_timeouts_ = 0;
+        anti_entropy_sessions_ = 0;
+        anti_entropy_buckets_ = 0;
+        metadata_requests_ = 0;
+        metadata_rejected_ = 0;
+        nodes_evicted_ = 0;
+        nodes_rejected_ = 0;
+        {
+            std::lock_guard<std::mutex> events_lock(events_mutex_);
+            events_.clear();
+            event_queue_depth_ = 0;
+        }
+
+        publisher_.mark_self();
+        publish_snapshot();
     }
 
     gossip_stats gossip_core::get_stats() const {
-        std::lock_guard<std::mutex> lock(mutex_);
-
         gossip_stats stats;
-        stats.known_nodes = nodes_.size();
+        stats.known_nodes = size();
+        stats.gossip_nodes = gossip_nodes_stat_;
+        stats.sync_nodes = sync_nodes_stat_;
         stats.sent_messages = sent_messages_;
         stats.received_messages = received_messages_;
         stats.last_tick_duration = last_tick_duration_;
+        stats.indirect_probes_sent = indirect_probes_sent_;
+        stats.indirect_probe_rescues = indirect_probe_rescues_;
+        stats.indirect_probe_timeouts = indirect_probe_timeouts_;
+        stats.anti_entropy_sessions = anti_entropy_sessions_;
+        stats.anti_entropy_buckets = anti_entropy_buckets_;
+        stats.metadata_requests = metadata_requests_;
+        stats.metadata_rejected = metadata_rejected_;
+        stats.nodes_evicted = nodes_evicted_;
+        stats.nodes_rejected = nodes_rejected_;
+        stats.tombstones = tombstone_count_;
+        stats.groups = groups_stat_;
+        stats.representative = representative_stat_;
+        stats.local_health = local_health_score_;
+        stats.events_delivered = events_delivered_;
+        stats.events_dropped = events_dropped_;
+        stats.event_batches = event_batches_;
+        stats.event_queue_depth = event_queue_depth_;
+        stats.event_queue_peak = event_queue_peak_;
+        if (stats.events_delivered > 0) {
+            stats.event_latency_avg = std::chrono::microseconds(
+                    event_latency_total_us_ / static_cast<int64_t>(stats.events_delivered));
+        }
+        stats.event_latency_max = std::chrono::microseconds(event_latency_max_us_);
         return stats;
     }
 
-    void gossip_core::update_self_metadata(const std::map<std::string, std::string> &metadata) noexcept {
+    bool gossip_core::update_self_metadata(const std::map<std::string, std::string> &metadata) noexcept {
         std::lock_guard<std::mutex> lock(mutex_);
-        
-        // Update self metadata with provided key-value pairs
+
+        // All or nothing: reject updates that would take us past the size limit
+        size_t bytes = metadata_bytes(self_.metadata);
+        for (const auto &[key, value]: metadata) {
+            auto it = self_.metadata.find(key);
+            bytes += value.size();
+            bytes -= it != self_.metadata.end() ? it->second.size() : 0;
+            bytes += it != self_.metadata.end() ? 0 : key.size();
+        }
+        if (bytes > options_.metadata_size_limit) {
+            LIBGOSSIP_LOG_WARN("update_self_metadata: " << bytes << " bytes of metadata exceed the limit of "
+                                                        << options_.metadata_size_limit);
+            return false;
+        }
+
+        // Update self metadata with provided key-value pairs; only the
+        // changed keys get a new version and travel in the next deltas
+        self_.set_metadata(metadata);
         for (const auto& [key, value] : metadata) {
-            self_.metadata[key] = value;
-            
             // Update config_epoch if provided
             if (key == "config_epoch") {
                 try {
@@ -527,6 +2092,23 @@ namespace libgossip {
         // This ensures the updated metadata will be propagated to other nodes
         self_.heartbeat++;
         self_.version++;
+
+        if (tree_) {
+            tree_->set(0, 0, self_.id, merkle_tree::entry_hash(self_));
+        }
+        if (options_.tick_budget_bytes > 0) {
+            adapt_fanout();// The budget is spent at our own metadata size
+        }
+
+        publisher_.mark_self();
+        publish_snapshot();
+        return true;
+    }
+
+    void gossip_core::publish_snapshot() {
+        if (publisher_.pending()) {
+            std::atomic_store(&snapshot_, publisher_.publish(nodes_, self_));
+        }
     }
 
 }// namespace libgossip
\ No newline at end of file
@@ -45,6 +45,39 @@ bool gossip_manager::init(const gossip_config& config) noexcept {
     self_view.version = 1;
     self_view.status = node_status::joining;
 
+    gossip_core_options core_options;
+    core_options.heartbeat_interval_ms = config.heartbeat_interval_ms;
+    core_options.failure_timeout_ms = config.failure_timeout_ms;
+    core_options.gossip_nodes = config.gossip_nodes;
+    core_options.sync_nodes = config.sync_nodes;
+    core_options.adaptive_fanout = config.adaptive_fanout;
+    core_options.tick_budget_bytes = config.tick_budget_bytes;
+    core_options.region_aware = config.region_aware;
+    core_options.cross_region_fraction = config.cross_region_fraction;
+    core_options.hierarchical = config.hierarchical;
+    core_options.representative_role = config.representative_role;
+    core_options.scheduler = config.scheduler;
+    core_options.detector = config.detector;
+    core_options.phi_threshold = config.phi_threshold;
+    core_options.phi_min_std_deviation_ms = config.phi_min_std_deviation_ms;
+    core_options.indirect_probes = config.indirect_probes;
+    core_options.indirect_probe_timeout_ms = config.indirect_probe_timeout_ms;
+    core_options.local_health_max = config.local_health_max;
+    core_options.dissemination = config.dissemination;
+    core_options.retransmit_mult = config.retransmit_mult;
+    core_options.max_piggyback_entries = config.max_piggyback_entries;
+    core_options.anti_entropy_interval_ms = config.anti_entropy_interval_ms;
+    core_options.anti_entropy_max_digests = config.anti_entropy_max_digests;
+    core_options.event_queue_capacity = config.event_queue_capacity;
+    core_options.event_overflow = config.event_overflow;
+    core_options.metadata_size_limit = config.metadata_size_limit;
+    core_options.metadata_delta_window = config.metadata_delta_window;
+    core_options.max_nodes = config.max_nodes;
+    core_options.eviction = config.eviction;
+    core_options.region_priorities = config.region_priorities;
+    core_options.delivery = config.batch_events_per_tick ? event_delivery::manual
+                                                         : event_delivery::after_unlock;
+
     // Create gossip core with callbacks
     try {
         gossip_core_ = std::make_shared<gossip_core>(
@@ -54,10 +87,12 @@ bool gossip_manager::init(const gossip_config& config) noexcept {
             },
             [this](const node_view& node, node_status old_status) {
                 on_node_event(node, old_status);
-            });
+            },
+            core_options);
     } catch (const std::exception&) {
         return false;
     }
+    install_batch_event_callback();
 
     // Create transport
     auto transport_type = config.use_tcp ? net::transport_type::tcp
@@ -73,6 +108,7 @@ bool gossip_manager::init(const gossip_config& config) noexcept {
 
     // Connect transport to gossip core
     transport_->set_gossip_core(gossip_core_);
+    transport_->set_coalesce_window(std::chrono::microseconds(config.udp_coalesce_window_us));
 
     initialized_.store(true, std::memory_order_release);
     return true;
@@ -123,6 +159,9 @@ void gossip_manager::tick() noexcept {
 
     if (gossip_core_) {
         gossip_core_->tick();
+        if (config_.batch_events_per_tick) {
+            gossip_core_->dispatch_events();
+        }
     }
 }
 
@@ -142,7 +181,7 @@ bool gossip_manager::meet_node(std::string_view ip, uint16_t port) noexcept {
     }
 
     node_view node;
-    node.ip = std::string(ip);
+    node.ip = ip;
     node.port = port;
     node.status = node_status::unknown;
 
@@ -156,7 +195,7 @@ bool gossip_manager::join_cluster(std::string_view ip, uint16_t port) noexcept {
     }
 
     node_view node;
-    node.ip = std::string(ip);
+    node.ip = ip;
     node.port = port;
 
     gossip_core_->join(node);
@@ -194,10 +233,8 @@ node_view gossip_manager::get_self() const noexcept {
     return gossip_core_->self();
 }
 
-void gossip_manager::update_metadata(const std::map<std::string, std::string>& metadata) noexcept {
-    if (gossip_core_) {
-        gossip_core_->update_self_metadata(metadata);
-    }
+bool gossip_manager::update_metadata(const std::map<std::string, std::string>& metadata) noexcept {
+    return gossip_core_ && gossip_core_->update_self_metadata(metadata);
 }
 
 void gossip_manager::set_event_callback(cluster_event_callback callback) noexcept {
@@ -206,6 +243,26 @@ void gossip_manager::set_event_callback(cluster_event_callback callback) noexcep
     event_callback_set_.store(true, std::memory_order_release);
 }
 
+void gossip_manager::set_batch_event_callback(cluster_batch_event_callback callback) noexcept {
+    {
+        std::lock_guard<std::mutex> lock(event_callback_mutex_);
+        batch_event_callback_ = std::move(callback);
+    }
+    install_batch_event_callback();
+}
+
+void gossip_manager::install_batch_event_callback() noexcept {
+    if (!gossip_core_) {
+        return; // Installed by init()
+    }
+    cluster_batch_event_callback callback;
+    {
+        std::lock_guard<std::mutex> lock(event_callback_mutex_);
+        callback = batch_event_callback_;
+    }
+    gossip_core_->set_batch_event_callback(std::move(callback));
+}
+
 gossip_manager::stats gossip_manager::get_stats() const noexcept {
     stats result;
 
@@ -217,6 +274,11 @@ gossip_manager::stats gossip_manager::get_stats() const noexcept {
         result.last_tick_duration_ms = core_stats.last_tick_duration.count();
     }
 
+    if (transport_) {
+        result.frames_sent = transport_->frames_sent();
+        result.datagrams_sent = transport_->datagrams_sent();
+    }
+
     return result;
 }
 
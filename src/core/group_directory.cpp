@@ -0,0 +1,64 @@
+/**
+ * @file group_directory.cpp
+ * @brief Implementation of the group directory
+ */
+
+#include "core/group_directory.hpp"
+#include <algorithm>
+
+namespace libgossip {
+
+    bool group_directory::merge(const group_summary &summary) {
+        for (auto &e: entries_) {
+            if (e.summary.group != summary.group) {
+                continue;
+            }
+            if (!summary.newer_than(e.summary)) {
+                return false;
+            }
+            e.summary = summary;
+            e.transmits = 0;
+            return true;
+        }
+        entries_.push_back({summary, 0});
+        return true;
+    }
+
+    const group_summary *group_directory::find(const interned_string &group) const noexcept {
+        auto it = std::find_if(entries_.begin(), entries_.end(), [&group](const entry &e) { return e.summary.group == group; });
+        return it != entries_.end() ? &it->summary : nullptr;
+    }
+
+    void group_directory::take(size_t max, uint32_t limit, std::vector<group_summary> &out) {
+        for (auto &e: entries_) {
+            if (max == 0) {
+                return;
+            }
+            if (e.transmits < limit) {
+                ++e.transmits;
+                out.push_back(e.summary);
+                --max;
+            }
+        }
+    }
+
+    void group_directory::rotate(size_t max, std::vector<group_summary> &out) {
+        for (size_t seen = 0; seen < entries_.size() && max > 0; ++seen) {
+            if (cursor_ >= entries_.size()) {
+                cursor_ = 0;
+            }
+            const group_summary &summary = entries_[cursor_++].summary;
+            if (std::none_of(out.begin(), out.end(), [&summary](const group_summary &s) { return s.group == summary.group; })) {
+                out.push_back(summary);
+                --max;
+            }
+        }
+    }
+
+    void group_directory::append_all(std::vector<group_summary> &out) const {
+        for (const auto &e: entries_) {
+            out.push_back(e.summary);
+        }
+    }
+
+}// namespace libgossip
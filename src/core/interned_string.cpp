@@ -0,0 +1,100 @@
+/**
+ * @file interned_string.cpp
+ * @brief Implementation of the interned string pool
+ */
+
+#include "core/interned_string.hpp"
+
+#include <deque>
+#include <mutex>
+#include <shared_mutex>
+#include <unordered_map>
+
+namespace libgossip {
+
+    namespace {
+
+        // Keyed by string_view so a lookup never builds a std::string
+        // (C++17 unordered containers have no heterogeneous find)
+        struct string_pool {
+            std::shared_mutex mutex;
+            std::deque<std::string> strings;// Pool entries; a deque never moves them
+            std::unordered_map<std::string_view, const std::string *> index;// Views into strings
+            size_t limit = config::DEFAULT_INTERN_POOL_LIMIT;
+        };
+
+        // Never destroyed, so interned strings outlive every static object using them
+        string_pool &pool() {
+            static auto *instance = new string_pool();
+            return *instance;
+        }
+
+        // A private copy, tagged with interned_string::owned_bit
+        uintptr_t own(std::string_view text) {
+            return reinterpret_cast<uintptr_t>(new std::string(text)) | 1;
+        }
+
+    }// namespace
+
+    uintptr_t interned_string::intern(const std::string &text) {
+        return intern(std::string_view(text));
+    }
+
+    uintptr_t interned_string::intern(std::string_view text) {
+        if (text.empty()) {
+            return 0;
+        }
+        string_pool &p = pool();
+        {
+            std::shared_lock<std::shared_mutex> lock(p.mutex);
+            auto it = p.index.find(text);
+            if (it != p.index.end()) {
+                return reinterpret_cast<uintptr_t>(it->second);
+            }
+        }
+        std::unique_lock<std::shared_mutex> lock(p.mutex);
+        auto it = p.index.find(text);
+        if (it != p.index.end()) {
+            return reinterpret_cast<uintptr_t>(it->second);
+        }
+        if (p.strings.size() >= p.limit) {
+            lock.unlock();
+            return own(text);
+        }
+        const std::string &entry = p.strings.emplace_back(text);
+        p.index.emplace(entry, &entry);
+        return reinterpret_cast<uintptr_t>(&entry);
+    }
+
+    uintptr_t interned_string::copy(uintptr_t value) {
+        return own(text(value));
+    }
+
+    void interned_string::release(uintptr_t value) noexcept {
+        delete reinterpret_cast<const std::string *>(value & ~owned_bit);
+    }
+
+    const std::string &interned_string::empty_string() noexcept {
+        static const std::string empty;
+        return empty;
+    }
+
+    size_t interned_string::pool_size() {
+        string_pool &p = pool();
+        std::shared_lock<std::shared_mutex> lock(p.mutex);
+        return p.strings.size();
+    }
+
+    size_t interned_string::pool_limit() {
+        string_pool &p = pool();
+        std::shared_lock<std::shared_mutex> lock(p.mutex);
+        return p.limit;
+    }
+
+    void interned_string::set_pool_limit(size_t limit) {
+        string_pool &p = pool();
+        std::unique_lock<std::shared_mutex> lock(p.mutex);
+        p.limit = limit;
+    }
+
+}// namespace libgossip
@@ -0,0 +1,226 @@
+/**
+ * @file ip_address.cpp
+ * @brief Implementation of binary node addresses
+ */
+
+#include "core/ip_address.hpp"
+#include <cstring>
+
+namespace libgossip {
+
+    static_assert(sizeof(uintptr_t) <= 16, "kind::host keeps its interned_string's handle in ip_address::bytes_");
+
+    namespace {
+
+        constexpr uint8_t ipv4_mapped_prefix[12] = {0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0xFF, 0xFF};
+
+        int hex_value(char c) noexcept {
+            if (c >= '0' && c <= '9') return c - '0';
+            if (c >= 'a' && c <= 'f') return c - 'a' + 10;
+            if (c >= 'A' && c <= 'F') return c - 'A' + 10;
+            return -1;
+        }
+
+        void append_ipv4(std::string &out, const uint8_t *bytes) {
+            for (int i = 0; i < 4; ++i) {
+                if (i > 0) {
+                    out += '.';
+                }
+                out += std::to_string(bytes[i]);
+            }
+        }
+
+        // RFC 5952: lowercase, no leading zeros, the longest run of two or
+        // more zero groups (the first one on a tie) becomes "::"
+        void append_ipv6(std::string &out, const uint8_t *bytes) {
+            if (std::memcmp(bytes, ipv4_mapped_prefix, sizeof(ipv4_mapped_prefix)) == 0) {
+                out += "::ffff:";
+                append_ipv4(out, bytes + 12);
+                return;
+            }
+
+            uint16_t groups[8];
+            for (int i = 0; i < 8; ++i) {
+                groups[i] = static_cast<uint16_t>((bytes[2 * i] << 8) | bytes[2 * i + 1]);
+            }
+            int best = -1;
+            int best_length = 1;
+            for (int i = 0; i < 8;) {
+                int j = i;
+                while (j < 8 && groups[j] == 0) ++j;
+                if (j - i > best_length) {
+                    best = i;
+                    best_length = j - i;
+                }
+                i = j == i ? i + 1 : j;
+            }
+
+            static const char digits[] = "0123456789abcdef";
+            for (int i = 0; i < 8; ++i) {
+                if (i == best) {
+                    out += "::";
+                    i += best_length - 1;
+                    continue;
+                }
+                if (i > 0 && i != best + best_length) {
+                    out += ':';
+                }
+                bool leading = true;
+                for (int shift = 12; shift >= 0; shift -= 4) {
+                    const int digit = (groups[i] >> shift) & 0xF;
+                    if (digit == 0 && leading && shift > 0) {
+                        continue;
+                    }
+                    leading = false;
+                    out += digits[digit];
+                }
+            }
+        }
+
+    }// namespace
+
+    ip_address::ip_address(std::string_view text) {
+        if (text.empty()) {
+            return;
+        }
+        if (parse_ipv4(text, bytes_.data() + 12)) {
+            std::memcpy(bytes_.data(), ipv4_mapped_prefix, sizeof(ipv4_mapped_prefix));
+            kind_ = kind::v4;
+            return;
+        }
+        if (parse_ipv6(text, bytes_.data())) {
+            kind_ = kind::v6;
+            return;
+        }
+        bytes_ = {};
+        set_host(interned_string::intern(text));
+        kind_ = kind::host;
+    }
+
+    std::string ip_address::str() const {
+        std::string out;
+        switch (kind_) {
+            case kind::v4:
+                append_ipv4(out, bytes_.data() + 12);
+                break;
+            case kind::v6:
+                append_ipv6(out, bytes_.data());
+                break;
+            case kind::host:
+                out = host();
+                break;
+            case kind::none:
+                break;
+        }
+        return out;
+    }
+
+    bool ip_address::parse_ipv4(std::string_view text, uint8_t *out) noexcept {
+        int part = 0;
+        int value = -1;
+        for (size_t i = 0; i <= text.size(); ++i) {
+            if (i == text.size() || text[i] == '.') {
+                if (value < 0 || part > 3) {
+                    return false;
+                }
+                out[part++] = static_cast<uint8_t>(value);
+                value = -1;
+            } else if (text[i] >= '0' && text[i] <= '9') {
+                value = (value < 0 ? 0 : value * 10) + (text[i] - '0');
+                if (value > 255) {
+                    return false;
+                }
+            } else {
+                return false;
+            }
+        }
+        return part == 4;
+    }
+
+    bool ip_address::parse_ipv6(std::string_view text, uint8_t *out) noexcept {
+        uint16_t groups[8] = {};
+        int count = 0;
+        int gap = -1;// Group index where "::" was seen
+        const char *p = text.data();
+        const char *end = p + text.size();
+
+        if (end - p >= 2 && p[0] == ':' && p[1] == ':') {
+            gap = 0;
+            p += 2;
+        }
+        while (p < end) {
+            if (count == 8) {
+                return false;
+            }
+            // Embedded IPv4 tail, e.g. ::ffff:10.0.0.1
+            const char *dot = p;
+            while (dot < end && *dot != ':' && *dot != '.') ++dot;
+            if (dot < end && *dot == '.') {
+                if (count > 6) {
+                    return false;
+                }
+                uint8_t v4[4];
+                if (!parse_ipv4(std::string_view(p, static_cast<size_t>(end - p)), v4)) {
+                    return false;
+                }
+                groups[count++] = static_cast<uint16_t>((v4[0] << 8) | v4[1]);
+                groups[count++] = static_cast<uint16_t>((v4[2] << 8) | v4[3]);
+                p = end;
+                break;
+            }
+
+            int digits = 0;
+            uint32_t value = 0;
+            while (p < end && hex_value(*p) >= 0) {
+                value = (value << 4) | static_cast<uint32_t>(hex_value(*p));
+                ++p;
+                if (++digits > 4) {
+                    return false;
+                }
+            }
+            if (digits == 0) {
+                return false;
+            }
+            groups[count++] = static_cast<uint16_t>(value);
+
+            if (p == end) {
+                break;
+            }
+            if (*p != ':') {
+                return false;
+            }
+            ++p;
+            if (p < end && *p == ':') {
+                if (gap >= 0) {
+                    return false;
+                }
+                gap = count;
+                ++p;
+            } else if (p == end) {
+                return false;
+            }
+        }
+
+        if (gap < 0 && count != 8) {
+            return false;
+        }
+        if (gap >= 0 && count > 7) {
+            return false;
+        }
+
+        uint16_t full[8] = {};
+        if (gap < 0) {
+            std::memcpy(full, groups, sizeof(full));
+        } else {
+            int tail = count - gap;
+            for (int i = 0; i < gap; ++i) full[i] = groups[i];
+            for (int i = 0; i < tail; ++i) full[8 - tail + i] = groups[gap + i];
+        }
+        for (int i = 0; i < 8; ++i) {
+            out[2 * i] = static_cast<uint8_t>(full[i] >> 8);
+            out[2 * i + 1] = static_cast<uint8_t>(full[i] & 0xFF);
+        }
+        return true;
+    }
+
+}// namespace libgossip
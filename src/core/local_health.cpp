@@ -0,0 +1,89 @@
+/**
+ * @file local_health.cpp
+ * @brief Implementation of the local health score
+ */
+
+#include "core/local_health.hpp"
+#include <algorithm>
+
+namespace libgossip {
+
+    void local_health::tick(time_point now, duration_ms interval) {
+        if (!enabled()) {
+            return;
+        }
+        lag_counted_ = false;
+        if (ticked_ && interval.count() > 0 && now - last_tick_ >= 2 * interval) {
+            const auto missed = (now - last_tick_) / interval - 1;
+            raise(static_cast<uint32_t>(std::min<int64_t>(missed, max_score_)));
+        }
+        last_tick_ = now;
+        ticked_ = true;
+    }
+
+    void local_health::probe_sent(node_handle target, time_point sent) {
+        if (!enabled()) {
+            return;
+        }
+        // A node pinged again before it answered keeps its first ping
+        auto it = std::find_if(probes_.begin(), probes_.end(), [target](const probe &p) { return p.target == target; });
+        if (it == probes_.end()) {
+            probes_.push_back({target, sent});
+        }
+    }
+
+    void local_health::ack_received(node_handle from, time_point arrival, duration_ms timeout) {
+        if (probes_.empty()) {
+            return;
+        }
+        auto it = std::find_if(probes_.begin(), probes_.end(), [from](const probe &p) { return p.target == from; });
+        if (it == probes_.end()) {
+            return;// Not an answer to one of our pings
+        }
+        if (arrival - it->sent <= timeout) {
+            lower();
+        } else {
+            raise(1);
+        }
+        *it = probes_.back();
+        probes_.pop_back();
+    }
+
+    void local_health::expire_probes(time_point now, duration_ms timeout) {
+        for (size_t i = 0; i < probes_.size();) {
+            if (now - probes_[i].sent <= timeout) {
+                ++i;
+                continue;
+            }
+            raise(1);
+            probes_[i] = probes_.back();
+            probes_.pop_back();
+        }
+    }
+
+    void local_health::receive_lag(std::chrono::steady_clock::duration lag, duration_ms limit) {
+        if (!enabled() || lag_counted_ || lag <= limit) {
+            return;
+        }
+        lag_counted_ = true;
+        raise(1);
+    }
+
+    void local_health::clear() noexcept {
+        probes_.clear();
+        ticked_ = false;
+        lag_counted_ = false;
+        score_ = 0;
+    }
+
+    void local_health::raise(uint32_t by) noexcept {
+        score_ = std::min(max_score_, score_ + std::min(by, max_score_));
+    }
+
+    void local_health::lower() noexcept {
+        if (score_ > 0) {
+            score_--;
+        }
+    }
+
+}// namespace libgossip
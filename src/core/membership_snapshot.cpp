@@ -0,0 +1,148 @@
+/**
+ * @file membership_snapshot.cpp
+ * @brief Implementation of membership snapshots and their publisher
+ */
+
+#include "core/membership_snapshot.hpp"
+
+#include <atomic>
+
+namespace libgossip {
+
+    const node_view *membership_snapshot::find(const node_id_t &id) const noexcept {
+        if (self_ && self_->id == id) {
+            return self_.get();
+        }
+        if (!index_ || index_->empty()) {
+            return nullptr;
+        }
+        const size_t mask = index_->size() - 1;
+        for (size_t i = static_cast<size_t>(hash_node_id(id)) & mask;; i = (i + 1) & mask) {
+            const uint32_t entry = (*index_)[i];
+            if (entry == 0) {
+                return nullptr;
+            }
+            const node_view *node = at_slot(entry - 1);
+            if (node && node->id == id) {
+                return node;
+            }
+        }
+    }
+
+    void membership_publisher::mark(uint32_t index) {
+        const size_t word = index / 64;
+        if (word >= dirty_marks_.size()) {
+            dirty_marks_.resize(word + 1, 0);
+        }
+        const uint64_t bit = 1ULL << (index % 64);
+        if (!(dirty_marks_[word] & bit)) {
+            dirty_marks_[word] |= bit;
+            dirty_.push_back(index);
+        }
+    }
+
+    void membership_publisher::clear() noexcept {
+        for (auto &word: dirty_marks_) {
+            word = 0;
+        }
+        dirty_.clear();
+        cleared_ = true;
+    }
+
+    std::shared_ptr<const membership_snapshot> membership_publisher::publish(const membership_table &table,
+                                                                              const node_view &self) {
+        auto next = recycle();
+        next->version_ = last_ ? last_->version_ + 1 : 1;
+        next->size_ = table.size();
+        if (!self_dirty_ && last_) {
+            next->self_ = last_->self_;
+        } else if (next->self_ && next->self_.use_count() == 1) {
+            next->self_->assign(self);
+        } else {
+            next->self_ = std::make_shared<node_view>(self);
+        }
+
+        // Start from the previous chunks (shared, not copied) unless everything was removed
+        bool structural = cleared_ || !last_;
+        if (!structural) {
+            next->chunks_ = last_->chunks_;
+        } else {
+            next->chunks_.clear();
+        }
+        const size_t chunk_count =
+                (static_cast<size_t>(table.slot_count()) + membership_snapshot::chunk_size - 1) / membership_snapshot::chunk_size;
+        if (next->chunks_.size() < chunk_count) {
+            next->chunks_.resize(chunk_count);
+        }
+        writable_.assign(next->chunks_.size(), nullptr);
+
+        // Copy-on-write: the first change in a chunk copies its 64 pointers
+        for (uint32_t index: dirty_) {
+            dirty_marks_[index / 64] &= ~(1ULL << (index % 64));
+
+            const uint32_t c = index / membership_snapshot::chunk_size;
+            membership_snapshot::chunk *writable = writable_[c];
+            if (!writable) {
+                auto copy = next->chunks_[c] ? std::make_shared<membership_snapshot::chunk>(*next->chunks_[c])
+                                             : std::make_shared<membership_snapshot::chunk>();
+                writable = copy.get();
+                next->chunks_[c] = std::move(copy);
+                writable_[c] = writable;
+            }
+
+            auto &cell = (*writable)[index % membership_snapshot::chunk_size];
+            const node_view *node = table.get(table.handle_of(index));
+            if (!node) {
+                structural = structural || cell != nullptr;
+                cell.reset();
+                continue;
+            }
+            structural = structural || !cell || cell->id != node->id;
+            cell = std::make_shared<const node_view>(*node);
+        }
+        dirty_.clear();
+
+        // Slots are stable, so the ID index only changes with the set of IDs
+        if (structural) {
+            rebuild_index(table, *next);
+        } else {
+            next->index_ = last_->index_;
+        }
+
+        self_dirty_ = false;
+        cleared_ = false;
+        spare_ = std::move(last_);
+        last_ = next;
+        return next;
+    }
+
+    std::shared_ptr<membership_snapshot> membership_publisher::recycle() {
+        // spare_ is no longer published, so once its count drops to one it
+        // cannot be picked up again; the fence orders our writes after the
+        // last reader's release of it
+        if (spare_ && spare_.use_count() == 1) {
+            std::atomic_thread_fence(std::memory_order_acquire);
+            return std::move(spare_);
+        }
+        return std::make_shared<membership_snapshot>();
+    }
+
+    void membership_publisher::rebuild_index(const membership_table &table, membership_snapshot &next) const {
+        size_t capacity = 16;
+        while (capacity < table.size() * 2) {
+            capacity <<= 1;
+        }
+        auto index = std::make_shared<std::vector<uint32_t>>(capacity, 0);
+        const size_t mask = capacity - 1;
+        for (size_t pos = 0; pos < table.size(); ++pos) {
+            const node_handle handle = table.handle_at(pos);
+            size_t i = static_cast<size_t>(hash_node_id(table.get(handle)->id)) & mask;
+            while ((*index)[i] != 0) {
+                i = (i + 1) & mask;
+            }
+            (*index)[i] = handle.index + 1;
+        }
+        next.index_ = std::move(index);
+    }
+
+}// namespace libgossip
@@ -0,0 +1,272 @@
+/**
+ * @file membership_table.cpp
+ * @brief Implementation of the hash-indexed membership table
+ */
+
+#include "core/membership_table.hpp"
+#include <cstring>
+
+namespace libgossip {
+
+    namespace {
+
+        // murmur3 64-bit finalizer
+        uint64_t mix64(uint64_t h) noexcept {
+            h ^= h >> 33;
+            h *= 0xFF51AFD7ED558CCDULL;
+            h ^= h >> 33;
+            h *= 0xC4CEB9FE1A85EC53ULL;
+            h ^= h >> 33;
+            return h;
+        }
+
+        uint64_t hash_bytes16(const uint8_t *bytes, uint64_t seed) noexcept {
+            uint64_t lo = 0;
+            uint64_t hi = 0;
+            std::memcpy(&lo, bytes, sizeof(lo));
+            std::memcpy(&hi, bytes + sizeof(lo), sizeof(hi));
+            return mix64(lo * 0x9E3779B97F4A7C15ULL ^ (hi + seed));
+        }
+
+    }// namespace
+
+    uint64_t hash_node_id(const node_id_t &id) noexcept {
+        // Mix both halves so that sequential or zero-padded IDs still spread
+        return hash_bytes16(id.data(), 0x632BE59BD9B4E019ULL);
+    }
+
+    endpoint_key make_endpoint_key(const ip_address &ip, int port) noexcept {
+        endpoint_key key;
+        key.port = static_cast<uint16_t>(port);
+        if (ip.type() == ip_address::kind::v4 || ip.type() == ip_address::kind::v6) {
+            key.address = ip.bytes();// IPv4 is stored IPv4-mapped (::ffff:a.b.c.d)
+            return key;
+        }
+
+        // Host names: two independent FNV-1a digests. The 0xFE marker lives in
+        // the reserved fe00::/9 range, which never appears as a node address.
+        uint64_t h1 = 0xCBF29CE484222325ULL;
+        uint64_t h2 = 0x84222325CBF29CE4ULL;
+        for (char c: ip.host()) {
+            h1 = (h1 ^ static_cast<uint8_t>(c)) * 0x100000001B3ULL;
+            h2 = (h2 ^ static_cast<uint8_t>(c)) * 0x100000001B3ULL;
+        }
+        std::memcpy(key.address.data(), &h1, sizeof(h1));
+        std::memcpy(key.address.data() + sizeof(h1), &h2, sizeof(h2));
+        key.address[0] = 0xFE;
+        key.address[1] = 0x7F;
+        return key;
+    }
+
+    uint64_t hash_endpoint(const endpoint_key &key) noexcept {
+        return hash_bytes16(key.address.data(), 0xD6E8FEB86659FD93ULL + key.port);
+    }
+
+    // ---------------------------------------------------------
+    // hash_index
+    // ---------------------------------------------------------
+
+    void membership_table::hash_index::insert(uint32_t slot_index, uint32_t hash) {
+        const size_t mask = buckets.size() - 1;
+        size_t i = hash & mask;
+        while (buckets[i].slot != empty_bucket) {
+            i = (i + 1) & mask;
+        }
+        buckets[i].slot = slot_index;
+        buckets[i].hash = hash;
+    }
+
+    void membership_table::hash_index::erase(uint32_t slot_index, uint32_t hash) noexcept {
+        const size_t mask = buckets.size() - 1;
+        size_t i = hash & mask;
+        while (buckets[i].slot != slot_index) {
+            i = (i + 1) & mask;
+        }
+
+        // Backward-shift deletion: pull later members of the probe run into
+        // the hole so lookups never need tombstones
+        size_t hole = i;
+        for (size_t j = (hole + 1) & mask; buckets[j].slot != empty_bucket; j = (j + 1) & mask) {
+            size_t home = buckets[j].hash & mask;
+            // Move j into the hole unless its home lies cyclically in (hole, j]
+            bool home_in_range = (hole <= j) ? (hole < home && home <= j)
+                                             : (hole < home || home <= j);
+            if (!home_in_range) {
+                buckets[hole] = buckets[j];
+                hole = j;
+            }
+        }
+        buckets[hole] = bucket{};
+    }
+
+    void membership_table::hash_index::clear() noexcept {
+        for (auto &b: buckets) {
+            b = bucket{};
+        }
+    }
+
+    // ---------------------------------------------------------
+    // membership_table
+    // ---------------------------------------------------------
+
+    node_handle membership_table::find(const node_id_t &id) const noexcept {
+        if (id_index_.buckets.empty()) {
+            return {};
+        }
+
+        const uint32_t hash = static_cast<uint32_t>(hash_node_id(id));
+        const size_t mask = id_index_.buckets.size() - 1;
+        for (size_t i = hash & mask;; i = (i + 1) & mask) {
+            const bucket &b = id_index_.buckets[i];
+            if (b.slot == empty_bucket) {
+                return {};
+            }
+            if (b.hash == hash) {
+                const slot &s = slot_at(b.slot);
+                if (s.node.id == id) {
+                    return {b.slot, s.generation};
+                }
+            }
+        }
+    }
+
+    void membership_table::refresh_endpoint(node_handle h) {
+        if (!get(h)) {
+            return;
+        }
+        slot &s = slot_at(h.index);
+        endpoint_key key = make_endpoint_key(s.node.ip, s.node.port);
+        if (key != s.endpoint) {
+            endpoint_index_.erase(h.index, static_cast<uint32_t>(hash_endpoint(s.endpoint)));
+            s.endpoint = key;
+            endpoint_index_.insert(h.index, static_cast<uint32_t>(hash_endpoint(key)));
+        }
+    }
+
+    node_view *membership_table::get(node_handle h) noexcept {
+        if (!h.valid() || h.index >= slot_count_) {
+            return nullptr;
+        }
+        slot &s = slot_at(h.index);
+        return (s.occupied && s.generation == h.generation) ? &s.node : nullptr;
+    }
+
+    const node_view *membership_table::get(node_handle h) const noexcept {
+        if (!h.valid() || h.index >= slot_count_) {
+            return nullptr;
+        }
+        const slot &s = slot_at(h.index);
+        return (s.occupied && s.generation == h.generation) ? &s.node : nullptr;
+    }
+
+    node_handle membership_table::insert(const node_view &node) {
+        if (find(node.id).valid()) {
+            return {};
+        }
+
+        // Keep the load factor at or below 1/2
+        if ((dense_.size() + 1) * 2 > id_index_.buckets.size()) {
+            grow_indexes();
+        }
+
+        uint32_t index = allocate_slot();
+        slot &s = slot_at(index);
+        s.node = node;
+        s.endpoint = make_endpoint_key(node.ip, node.port);
+        s.occupied = true;
+        s.dense_pos = static_cast<uint32_t>(dense_.size());
+        dense_.push_back(index);
+        id_index_.insert(index, static_cast<uint32_t>(hash_node_id(node.id)));
+        endpoint_index_.insert(index, static_cast<uint32_t>(hash_endpoint(s.endpoint)));
+        return {index, s.generation};
+    }
+
+    bool membership_table::erase(node_handle h) noexcept {
+        if (!get(h)) {
+            return false;
+        }
+
+        slot &s = slot_at(h.index);
+        id_index_.erase(h.index, static_cast<uint32_t>(hash_node_id(s.node.id)));
+        endpoint_index_.erase(h.index, static_cast<uint32_t>(hash_endpoint(s.endpoint)));
+
+        // Swap-remove from the dense array
+        uint32_t last = dense_.back();
+        dense_[s.dense_pos] = last;
+        slot_at(last).dense_pos = s.dense_pos;
+        dense_.pop_back();
+
+        s.node = node_view{};
+        s.occupied = false;
+        s.generation++;
+        free_.push_back(h.index);
+        return true;
+    }
+
+    bool membership_table::rekey(node_handle h, const node_id_t &new_id) {
+        node_view *node = get(h);
+        if (!node) {
+            return false;
+        }
+        if (node->id == new_id) {
+            return true;
+        }
+        if (find(new_id).valid()) {
+            return false;
+        }
+
+        id_index_.erase(h.index, static_cast<uint32_t>(hash_node_id(node->id)));
+        node->id = new_id;
+        id_index_.insert(h.index, static_cast<uint32_t>(hash_node_id(new_id)));
+        return true;
+    }
+
+    void membership_table::clear() noexcept {
+        for (uint32_t index: dense_) {
+            slot &s = slot_at(index);
+            s.node = node_view{};
+            s.occupied = false;
+            s.generation++;
+            free_.push_back(index);
+        }
+        dense_.clear();
+        id_index_.clear();
+        endpoint_index_.clear();
+    }
+
+    node_handle membership_table::handle_at(size_t pos) const noexcept {
+        uint32_t index = dense_[pos];
+        return {index, slot_at(index).generation};
+    }
+
+    node_handle membership_table::handle_of(uint32_t index) const noexcept {
+        if (index >= slot_count_ || !slot_at(index).occupied) {
+            return {};
+        }
+        return {index, slot_at(index).generation};
+    }
+
+    uint32_t membership_table::allocate_slot() {
+        if (!free_.empty()) {
+            uint32_t index = free_.back();
+            free_.pop_back();
+            return index;
+        }
+        if ((slot_count_ & (chunk_size - 1)) == 0) {
+            chunks_.push_back(std::make_unique<slot[]>(chunk_size));
+        }
+        return slot_count_++;
+    }
+
+    void membership_table::grow_indexes() {
+        size_t capacity = id_index_.buckets.empty() ? 16 : id_index_.buckets.size() * 2;
+        id_index_.buckets.assign(capacity, bucket{});
+        endpoint_index_.buckets.assign(capacity, bucket{});
+        for (uint32_t index: dense_) {
+            const slot &s = slot_at(index);
+            id_index_.insert(index, static_cast<uint32_t>(hash_node_id(s.node.id)));
+            endpoint_index_.insert(index, static_cast<uint32_t>(hash_endpoint(s.endpoint)));
+        }
+    }
+
+}// namespace libgossip
@@ -0,0 +1,124 @@
+/**
+ * @file merkle_tree.cpp
+ * @brief Implementation of the anti-entropy Merkle tree
+ */
+
+#include "core/merkle_tree.hpp"
+
+namespace libgossip {
+
+    static_assert(merkle_tree::leaf_count == merkle_tree::fanout * merkle_tree::fanout * merkle_tree::fanout,
+                  "leaf_count must be fanout ^ depth");
+    static_assert(merkle_tree::first_leaf == 1 + merkle_tree::fanout + merkle_tree::fanout * merkle_tree::fanout,
+                  "first_leaf must follow the interior levels");
+
+    namespace {
+
+        // splitmix64 finalizer
+        uint64_t mix64(uint64_t x) noexcept {
+            x ^= x >> 30;
+            x *= 0xBF58476D1CE4E5B9ULL;
+            x ^= x >> 27;
+            x *= 0x94D049BB133111EBULL;
+            x ^= x >> 31;
+            return x;
+        }
+
+    }// namespace
+
+    uint64_t merkle_tree::entry_hash(const node_view &node) noexcept {
+        const uint64_t state = (static_cast<uint64_t>(state_hash(node)) << 32) ^ mix64(node.config_epoch);
+        return mix64(hash_node_id(node.id) ^ mix64(state));
+    }
+
+    merkle_tree::merkle_tree() : hashes_(node_count, 0), heads_(leaf_count, nil) {}
+
+    void merkle_tree::set(uint32_t key, uint32_t generation, const node_id_t &id, uint64_t hash) {
+        if (key >= entries_.size()) {
+            entries_.resize(static_cast<size_t>(key) + 1);
+        }
+
+        const uint32_t leaf = leaf_of(id);
+        entry &e = entries_[key];
+        if (e.present) {
+            if (e.leaf == leaf) {
+                apply(leaf, e.hash ^ hash);
+                e.hash = hash;
+                e.generation = generation;
+                return;
+            }
+            // Re-keyed to another ID: move buckets
+            apply(e.leaf, e.hash);
+            unlink(key);
+        }
+
+        e.leaf = leaf;
+        e.hash = hash;
+        e.generation = generation;
+        link(key);
+        apply(leaf, hash);
+    }
+
+    void merkle_tree::remove(uint32_t key) noexcept {
+        if (key < entries_.size() && entries_[key].present) {
+            apply(entries_[key].leaf, entries_[key].hash);
+            unlink(key);
+        }
+    }
+
+    void merkle_tree::clear() noexcept {
+        for (auto &h: hashes_) {
+            h = 0;
+        }
+        for (auto &head: heads_) {
+            head = nil;
+        }
+        for (auto &e: entries_) {
+            e.present = false;
+        }
+        entry_count_ = 0;
+    }
+
+    void merkle_tree::apply(uint32_t leaf, uint64_t delta) noexcept {
+        if (delta == 0) {
+            return;
+        }
+        uint32_t index = leaf;
+        while (true) {
+            hashes_[index] ^= delta;
+            if (index == 0) {
+                break;
+            }
+            index = (index - 1) / fanout;
+        }
+    }
+
+    void merkle_tree::link(uint32_t key) noexcept {
+        entry &e = entries_[key];
+        uint32_t &head = heads_[e.leaf - first_leaf];
+        e.prev = nil;
+        e.next = head;
+        if (head != nil) {
+            entries_[head].prev = key;
+        }
+        head = key;
+        e.present = true;
+        ++entry_count_;
+    }
+
+    void merkle_tree::unlink(uint32_t key) noexcept {
+        entry &e = entries_[key];
+        if (e.prev != nil) {
+            entries_[e.prev].next = e.next;
+        } else {
+            heads_[e.leaf - first_leaf] = e.next;
+        }
+        if (e.next != nil) {
+            entries_[e.next].prev = e.prev;
+        }
+        e.prev = e.next = nil;
+        e.present = false;
+        --entry_count_;
+    }
+
+}// namespace libgossip
@@ -0,0 +1,56 @@
+/**
+ * @file region_index.cpp
+ * @brief Implementation of the local/remote member split
+ */
+
+#include "core/region_index.hpp"
+
+namespace libgossip {
+
+    void region_index::place(node_handle handle, group g) {
+        if (handle.index >= entries_.size()) {
+            entries_.resize(static_cast<size_t>(handle.index) + 1);
+        }
+        entry &e = entries_[handle.index];
+        if (e.group == g) {
+            members_[g][e.pos] = handle;// Same slot, maybe a new generation
+            return;
+        }
+        remove(handle.index);
+        e.group = g;
+        e.pos = static_cast<uint32_t>(members_[g].size());
+        members_[g].push_back(handle);
+    }
+
+    void region_index::remove(uint32_t index) noexcept {
+        if (index >= entries_.size() || entries_[index].group == nil) {
+            return;
+        }
+        entry &e = entries_[index];
+        auto &members = members_[e.group];
+        const node_handle last = members.back();
+        members[e.pos] = last;
+        entries_[last.index].pos = e.pos;
+        members.pop_back();
+        e.group = nil;
+    }
+
+    void region_index::clear() noexcept {
+        members_[local].clear();
+        members_[remote].clear();
+        for (auto &e: entries_) {
+            e.group = nil;
+        }
+    }
+
+    size_t region_index::position_of(node_handle handle, group g) const noexcept {
+        if (handle.index < entries_.size()) {
+            const entry &e = entries_[handle.index];
+            if (e.group == g && members_[g][e.pos] == handle) {
+                return e.pos;
+            }
+        }
+        return members_[g].size();
+    }
+
+}// namespace libgossip
@@ -0,0 +1,108 @@
+/**
+ * @file timer_wheel.cpp
+ * @brief Implementation of the hashed timer wheel
+ */
+
+#include "core/timer_wheel.hpp"
+
+namespace libgossip {
+
+    timer_wheel::timer_wheel(size_t bucket_count) {
+        size_t buckets = 1;
+        while (buckets < bucket_count) {
+            buckets <<= 1;
+        }
+        heads_.assign(buckets, nil);
+    }
+
+    void timer_wheel::schedule(uint32_t id, uint32_t generation, int64_t tick) {
+        if (tick < cursor_) {
+            tick = cursor_;
+        }
+        if (id >= entries_.size()) {
+            entries_.resize(static_cast<size_t>(id) + 1);
+        }
+
+        entry &e = entries_[id];
+        if (e.armed) {
+            if (e.generation == generation && e.tick <= tick) {
+                return;
+            }
+            unlink(id);
+        }
+        e.tick = tick;
+        e.generation = generation;
+        link(id);
+    }
+
+    void timer_wheel::cancel(uint32_t id) noexcept {
+        if (armed(id)) {
+            unlink(id);
+        }
+    }
+
+    void timer_wheel::clear() noexcept {
+        for (auto &head: heads_) {
+            head = nil;
+        }
+        for (auto &e: entries_) {
+            e.armed = false;
+        }
+        armed_count_ = 0;
+        cursor_ = std::numeric_limits<int64_t>::min();
+    }
+
+    void timer_wheel::link(uint32_t id) noexcept {
+        entry &e = entries_[id];
+        uint32_t &head = heads_[bucket_of(e.tick)];
+        e.prev = nil;
+        e.next = head;
+        if (head != nil) {
+            entries_[head].prev = id;
+        }
+        head = id;
+        e.armed = true;
+        ++armed_count_;
+    }
+
+    void timer_wheel::unlink(uint32_t id) noexcept {
+        entry &e = entries_[id];
+        if (e.prev != nil) {
+            entries_[e.prev].next = e.next;
+        } else {
+            heads_[bucket_of(e.tick)] = e.next;
+        }
+        if (e.next != nil) {
+            entries_[e.next].prev = e.prev;
+        }
+        e.prev = e.next = nil;
+        e.armed = false;
+        --armed_count_;
+    }
+
+    void timer_wheel::collect_expired(int64_t now) {
+        // Scan the buckets of ticks [cursor_, now], or every bucket once if
+        // that range wraps the wheel (first call, or a long pause)
+        const size_t bucket_count = heads_.size();
+        size_t first = 0;
+        size_t count = bucket_count;
+        if (cursor_ != std::numeric_limits<int64_t>::min() &&
+            static_cast<uint64_t>(now - cursor_) < bucket_count) {
+            first = bucket_of(cursor_);
+            count = static_cast<size_t>(now - cursor_) + 1;
+        }
+
+        for (size_t i = 0; i < count; ++i) {
+            uint32_t id = heads_[(first + i) & (bucket_count - 1)];
+            while (id != nil) {
+                const uint32_t next = entries_[id].next;
+                if (entries_[id].tick <= now) {
+                    expired_.emplace_back(id, entries_[id].generation);
+                    unlink(id);
+                }
+                id = next;
+            }
+        }
+    }
+
+}// namespace libgossip
@@ -0,0 +1,79 @@
+/**
+ * @file tombstone_store.cpp
+ * @brief Implementation of the failed-member store
+ */
+
+#include "core/tombstone_store.hpp"
+
+namespace libgossip {
+
+    void tombstone_store::bury(const node_view &node, time_point died) {
+        erase(node.id);
+        if (capacity_ > 0) {
+            while (queue_.size() >= capacity_) {
+                pop_front();
+            }
+        }
+        if (!queue_.empty() && died < queue_.back().died) {
+            died = queue_.back().died;
+        }
+
+        queue_.push_back({});
+        entry &e = queue_.back();
+        e.node.assign_without_metadata(node);
+        e.died = died;
+        index_[node.id] = front_seq_ + queue_.size() - 1;
+    }
+
+    const node_view *tombstone_store::find(const node_id_t &id) const noexcept {
+        auto it = index_.find(id);
+        return it != index_.end() ? &queue_[it->second - front_seq_].node : nullptr;
+    }
+
+    bool tombstone_store::erase(const node_id_t &id) {
+        auto it = index_.find(id);
+        if (it == index_.end()) {
+            return false;
+        }
+        entry &e = queue_[it->second - front_seq_];
+        e.buried = false;
+        e.node = node_view{};// Release its strings now
+        index_.erase(it);
+        return true;
+    }
+
+    size_t tombstone_store::expire(time_point cutoff) {
+        size_t dropped = 0;
+        while (!queue_.empty() && queue_.front().died <= cutoff) {
+            dropped += queue_.front().buried ? 1 : 0;
+            pop_front();
+        }
+        return dropped;
+    }
+
+    void tombstone_store::clear() noexcept {
+        queue_.clear();
+        index_.clear();
+        front_seq_ = 0;
+        pending_seq_ = 0;
+    }
+
+    void tombstone_store::skip_sent(uint32_t retransmit_limit) noexcept {
+        while (pending_seq_ - front_seq_ < queue_.size()) {
+            const entry &e = queue_[pending_seq_ - front_seq_];
+            if (e.buried && e.transmits < retransmit_limit) {
+                break;
+            }
+            ++pending_seq_;
+        }
+    }
+
+    void tombstone_store::pop_front() {
+        if (queue_.front().buried) {
+            index_.erase(queue_.front().node.id);
+        }
+        queue_.pop_front();
+        ++front_seq_;
+    }
+
+}// namespace libgossip
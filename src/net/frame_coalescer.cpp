@@ -0,0 +1,65 @@
+/**
+ * @file frame_coalescer.cpp
+ * @brief Implementation of per-target datagram assembly
+ */
+
+#include "net/frame_coalescer.hpp"
+
+namespace libgossip {
+    namespace net {
+
+        void frame_coalescer::frame(const std::vector<uint8_t> &payload, std::vector<uint8_t> &out) {
+            const auto length = static_cast<uint32_t>(payload.size());
+            out.push_back(static_cast<uint8_t>((length >> 24) & 0xFF));
+            out.push_back(static_cast<uint8_t>((length >> 16) & 0xFF));
+            out.push_back(static_cast<uint8_t>((length >> 8) & 0xFF));
+            out.push_back(static_cast<uint8_t>(length & 0xFF));
+            out.insert(out.end(), payload.begin(), payload.end());
+        }
+
+        bool frame_coalescer::append(const ip_address &ip, int port, const std::vector<uint8_t> &payload,
+                                     const emit_fn &emit) {
+            const bool first = order_.empty();
+            frames_++;
+
+            const endpoint_key key = make_endpoint_key(ip, port);
+            auto it = index_.find(key);
+            if (it == index_.end()) {
+                it = index_.emplace(key, order_.size()).first;
+                order_.emplace_back();
+                datagram &d = order_.back();
+                d.ip = ip;
+                d.port = port;
+                if (!spare_.empty()) {
+                    d.bytes = std::move(spare_.back());
+                    spare_.pop_back();
+                }
+            }
+
+            datagram &d = order_[it->second];
+            if (!d.bytes.empty() && d.bytes.size() + 4 + payload.size() > max_datagram_) {
+                emit_one(d, emit);// Full: this frame starts the next one
+            }
+            frame(payload, d.bytes);
+            return first;
+        }
+
+        void frame_coalescer::flush(const emit_fn &emit) {
+            for (auto &d: order_) {
+                emit_one(d, emit);
+                spare_.push_back(std::move(d.bytes));
+            }
+            order_.clear();
+            index_.clear();
+        }
+
+        void frame_coalescer::emit_one(datagram &d, const emit_fn &emit) {
+            if (!d.bytes.empty()) {
+                datagrams_++;
+                emit(d.ip, d.port, d.bytes);
+                d.bytes.clear();
+            }
+        }
+
+    } // namespace net
+} // namespace libgossip
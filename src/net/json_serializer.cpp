@@ -39,6 +39,37 @@ namespace libgossip {
                 j["entries"].push_back(serialize_node_to_json(node));
             }
 
+            // Serialize digests as compact [id, heartbeat, config_epoch, state_hash]
+            // arrays, only when present so other messages are unchanged
+            if (!msg.digests.empty()) {
+                j["digests"] = json::array();
+                for (const auto &digest : msg.digests) {
+                    std::ostringstream id_hex;
+                    for (uint8_t byte : digest.id) {
+                        id_hex << std::hex << std::setw(2) << std::setfill('0') << static_cast<int>(byte);
+                    }
+                    j["digests"].push_back(json::array({id_hex.str(), digest.heartbeat, digest.config_epoch, digest.state_hash}));
+                }
+            }
+
+            // Serialize Merkle tree hashes as [index, hash] arrays, only when present
+            if (!msg.tree.empty()) {
+                j["tree"] = json::array();
+                for (const auto &node : msg.tree) {
+                    j["tree"].push_back(json::array({node.index, node.hash}));
+                }
+            }
+
+            // Serialize group summaries as [group, term, version, members,
+            // representative] arrays, only when present
+            if (!msg.groups.empty()) {
+                j["groups"] = json::array();
+                for (const auto &summary : msg.groups) {
+                    j["groups"].push_back(json::array({summary.group.str(), summary.term, summary.version, summary.members,
+                                                       serialize_node_to_json(summary.representative)}));
+                }
+            }
+
             // Convert to JSON string and then to byte vector
             std::string json_str = j.dump();
             data.assign(json_str.begin(), json_str.end());
@@ -85,6 +116,44 @@ namespace libgossip {
                 }
             }
 
+            if (j.contains("digests") && j["digests"].is_array()) {
+                for (const auto &entry : j["digests"]) {
+                    if (!entry.is_array() || entry.size() != 4 || !entry[0].is_string()) {
+                        continue;
+                    }
+                    node_digest digest;
+                    parse_node_id_from_hex(entry[0].get<std::string>(), digest.id);
+                    digest.heartbeat = entry[1].get<uint64_t>();
+                    digest.config_epoch = entry[2].get<uint64_t>();
+                    digest.state_hash = entry[3].get<uint32_t>();
+                    msg.digests.push_back(digest);
+                }
+            }
+
+            if (j.contains("tree") && j["tree"].is_array()) {
+                for (const auto &entry : j["tree"]) {
+                    if (!entry.is_array() || entry.size() != 2) {
+                        continue;
+                    }
+                    msg.tree.push_back({entry[0].get<uint32_t>(), entry[1].get<uint64_t>()});
+                }
+            }
+
+            if (j.contains("groups") && j["groups"].is_array()) {
+                for (const auto &entry : j["groups"]) {
+                    if (!entry.is_array() || entry.size() != 5 || !entry[0].is_string()) {
+                        continue;
+                    }
+                    group_summary summary;
+                    summary.group = entry[0].get<std::string>();
+                    summary.term = entry[1].get<uint64_t>();
+                    summary.version = entry[2].get<uint64_t>();
+                    summary.members = entry[3].get<uint32_t>();
+                    summary.representative = deserialize_node_from_json(entry[4]);
+                    msg.groups.push_back(summary);
+                }
+            }
+
             return serialization_error::success;
         } catch (...) {
             msg = gossip_message{};
@@ -103,15 +172,25 @@ namespace libgossip {
         }
         j["id"] = id_hex.str();
 
-        j["ip"] = node.ip;
+        j["ip"] = node.ip.str();
         j["port"] = node.port;
         j["config_epoch"] = node.config_epoch;
         j["heartbeat"] = node.heartbeat;
         j["version"] = node.version;
         j["status"] = static_cast<int>(node.status);
-        j["role"] = node.role;
-        j["region"] = node.region;
+        j["role"] = node.role.str();
+        j["region"] = node.region.str();
         j["metadata"] = node.metadata;
+        if (node.metadata_version != 0) {
+            j["metadata_version"] = node.metadata_version;
+            j["metadata_hash"] = node.metadata_hash;
+        }
+        if (!node.metadata_versions.empty()) {
+            j["metadata_versions"] = node.metadata_versions;
+        }
+        if (node.metadata_since != 0) {
+            j["metadata_since"] = node.metadata_since;
+        }
         j["suspicion_count"] = node.suspicion_count;
 
         return j;
@@ -137,6 +216,15 @@ namespace libgossip {
             if (j.contains("metadata") && j["metadata"].is_object()) {
                 node.metadata = j["metadata"].get<std::map<std::string, std::string>>();
             }
+            if (j.contains("metadata_version") && j.contains("metadata_hash")) {
+                node.metadata_version = j["metadata_version"].get<uint64_t>();
+                node.metadata_hash = j["metadata_hash"].get<uint64_t>();
+            }
+            if (j.contains("metadata_versions") && j["metadata_versions"].is_array() &&
+                j["metadata_versions"].size() == node.metadata.size()) {
+                node.metadata_versions = j["metadata_versions"].get<std::vector<uint64_t>>();
+            }
+            if (j.contains("metadata_since")) node.metadata_since = j["metadata_since"].get<uint64_t>();
 
             if (j.contains("suspicion_count")) node.suspicion_count = j["suspicion_count"].get<int>();
         } catch (...) {
@@ -150,6 +238,14 @@ namespace libgossip {
         try {
             node_id.fill(0);
 
+            // Compact form without separators, as used by digests
+            if (hex_str.size() == node_id.size() * 2 && hex_str.find(',') == std::string::npos) {
+                for (size_t i = 0; i < node_id.size(); ++i) {
+                    node_id[i] = static_cast<uint8_t>(std::stoi(hex_str.substr(i * 2, 2), nullptr, 16));
+                }
+                return;
+            }
+
             std::vector<std::string> bytes;
             size_t start = 0;
             size_t pos = 0;
@@ -119,7 +119,7 @@ namespace libgossip {
 
                 packet.insert(packet.end(), data.begin(), data.end());
 
-                auto socket = get_or_create_socket(target.ip, target.port);
+                auto socket = get_or_create_socket(target.ip.str(), target.port);
                 if (!socket) {
                     return error_code::network_error;
                 }
@@ -166,7 +166,7 @@ namespace libgossip {
 
                 packet.insert(packet.end(), data.begin(), data.end());
 
-                auto socket = get_or_create_socket(target.ip, target.port);
+                auto socket = get_or_create_socket(target.ip.str(), target.port);
                 if (!socket) {
                     if (callback) {
                         callback(error_code::network_error);
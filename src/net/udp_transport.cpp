@@ -1,9 +1,12 @@
 #include "net/udp_transport.hpp"
 #include "core/enum_reflection.inl"
+#include "net/frame_coalescer.hpp"
 #include <asio.hpp>
+#include <atomic>
 #include <chrono>
 #include <functional>
 #include <iostream>
+#include <mutex>
 #include <thread>
 
 namespace libgossip {
@@ -33,6 +36,7 @@ namespace libgossip {
                   socket_(io_context_),
                   endpoint_(asio::ip::make_address(host), port),
                   work_(asio::make_work_guard(io_context_)),
+                  flush_timer_(io_context_),
                   receive_buffer_(65536),
                   core_(nullptr),
                   serializer_(nullptr) {
@@ -61,6 +65,7 @@ namespace libgossip {
 
             error_code stop() {
                 try {
+                    flush();// Nothing waiting for a window is lost
                     if (socket_.is_open()) {
                         asio::post(io_context_, [this]() {
                             socket_.close();
@@ -87,6 +92,19 @@ namespace libgossip {
                 serializer_ = std::move(serializer);
             }
 
+            void set_coalesce_window(std::chrono::microseconds window) {
+                std::lock_guard<std::mutex> lock(send_mutex_);
+                window_ = window;
+            }
+
+            void flush() {
+                std::lock_guard<std::mutex> lock(send_mutex_);
+                coalescer_.flush(emit_);
+            }
+
+            uint64_t frames_sent() const { return frames_sent_; }
+            uint64_t datagrams_sent() const { return datagrams_sent_; }
+
             error_code send_message(const gossip_message &msg,
                                     const node_view &target) {
                 if (!serializer_) {
@@ -99,33 +117,22 @@ namespace libgossip {
                     return to_error_code(se);
                 }
 
+                std::lock_guard<std::mutex> lock(send_mutex_);
+                frames_sent_++;
+                if (window_.count() > 0) {
+                    // Sent with whatever else is bound for the target when the window closes
+                    if (coalescer_.append(target.ip, target.port, data, emit_)) {
+                        arm_flush_timer();
+                    }
+                    return error_code::success;
+                }
+
                 // Prepare message with 4-byte length prefix
                 std::vector<uint8_t> packet;
                 packet.reserve(4 + data.size());
-
-                uint32_t length = static_cast<uint32_t>(data.size());
-                packet.push_back((length >> 24) & 0xFF);
-                packet.push_back((length >> 16) & 0xFF);
-                packet.push_back((length >> 8) & 0xFF);
-                packet.push_back(length & 0xFF);
-
-                packet.insert(packet.end(), data.begin(), data.end());
-
-                asio::ip::udp::endpoint target_endpoint(
-                    asio::ip::make_address(target.ip),
-                    static_cast<unsigned short>(target.port)
-                );
-
-                asio::error_code send_ec;
-                socket_.send_to(asio::buffer(packet), target_endpoint, 0, send_ec);
-
-                if (send_ec) {
-                    std::cerr << "Failed to send UDP message to " << target.ip << ":" << target.port
-                              << ": " << send_ec.message() << std::endl;
-                    return error_code::network_error;
-                }
-
-                return error_code::success;
+                frame_coalescer::frame(data, packet);
+                return send_datagram(target.ip, target.port, packet) ? error_code::success
+                                                                     : error_code::network_error;
             }
 
             void send_message_async(const gossip_message &msg,
@@ -159,7 +166,7 @@ namespace libgossip {
                 packet.insert(packet.end(), data.begin(), data.end());
 
                 asio::ip::udp::endpoint target_endpoint(
-                    asio::ip::make_address(target.ip),
+                    asio::ip::make_address(target.ip.str()),
                     static_cast<unsigned short>(target.port)
                 );
 
@@ -184,6 +191,39 @@ namespace libgossip {
             }
 
         private:
+            /// Send one datagram (send_mutex_ held); false and a log line on error
+            bool send_datagram(const ip_address &ip, int port, const std::vector<uint8_t> &packet) {
+                datagrams_sent_++;// Before the send: a receiver may see the datagram before send_to returns
+                asio::error_code send_ec;
+                asio::ip::udp::endpoint target_endpoint(
+                    asio::ip::make_address(ip.str(), send_ec),
+                    static_cast<unsigned short>(port)
+                );
+                if (!send_ec) {
+                    socket_.send_to(asio::buffer(packet), target_endpoint, 0, send_ec);
+                }
+
+                if (send_ec) {
+                    std::cerr << "Failed to send UDP message to " << ip << ":" << port
+                              << ": " << send_ec.message() << std::endl;
+                    return false;
+                }
+                return true;
+            }
+
+            /// Flush when the window that starts now closes (send_mutex_ held)
+            void arm_flush_timer() {
+                const auto window = window_;
+                asio::post(io_context_, [this, window]() {
+                    flush_timer_.expires_after(window);
+                    flush_timer_.async_wait([this](const asio::error_code &ec) {
+                        if (!ec) {
+                            flush();
+                        }
+                    });
+                });
+            }
+
             void start_receive() {
                 socket_.async_receive_from(
                         asio::buffer(receive_buffer_),
@@ -236,11 +276,23 @@ namespace libgossip {
             asio::ip::udp::socket socket_;
             asio::ip::udp::endpoint endpoint_;
             asio::executor_work_guard<asio::io_context::executor_type> work_;
+            asio::steady_timer flush_timer_;// Only touched on the IO thread
             std::thread io_thread_;
             std::vector<char> receive_buffer_;
             asio::ip::udp::endpoint remote_endpoint_;
             std::shared_ptr<gossip_core> core_;
             std::unique_ptr<message_serializer> serializer_;
+
+            // Sending: send_message() may be called from any thread (the core
+            // sends from tick() and from the IO thread's handle_message())
+            std::mutex send_mutex_;
+            std::chrono::microseconds window_{config::DEFAULT_UDP_COALESCE_WINDOW_US};
+            frame_coalescer coalescer_;
+            frame_coalescer::emit_fn emit_ = [this](const ip_address &ip, int port, const std::vector<uint8_t> &datagram) {
+                send_datagram(ip, port, datagram);
+            };
+            std::atomic<uint64_t> frames_sent_{0};
+            std::atomic<uint64_t> datagrams_sent_{0};
         };
 
         // UDP transport public interface implementation
@@ -277,5 +329,21 @@ namespace libgossip {
             pimpl_->set_serializer(std::move(serializer));
         }
 
+        void udp_transport::set_coalesce_window(std::chrono::microseconds window) {
+            pimpl_->set_coalesce_window(window);
+        }
+
+        void udp_transport::flush() {
+            pimpl_->flush();
+        }
+
+        uint64_t udp_transport::frames_sent() const {
+            return pimpl_->frames_sent();
+        }
+
+        uint64_t udp_transport::datagrams_sent() const {
+            return pimpl_->datagrams_sent();
+        }
+
     } // namespace net
 } // namespace libgossip
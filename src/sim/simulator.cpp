@@ -0,0 +1,401 @@
+/**
+ * @file simulator.cpp
+ * @brief Implementation of the discrete-event simulator
+ */
+
+#include "sim/simulator.hpp"
+#include <algorithm>
+#include <stdexcept>
+
+namespace libgossip {
+    namespace sim {
+
+        namespace {
+
+            // The simulator whose virtual clock is installed as clock's source
+            const simulator *active = nullptr;
+
+            time_point virtual_now() {
+                return active ? active->now() : std::chrono::steady_clock::now();
+            }
+
+            // splitmix64 finalizer: spreads nearby seeds far apart
+            uint64_t mix(uint64_t z) noexcept {
+                z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+                z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+                return z ^ (z >> 31);
+            }
+
+            // Virtual time starts here rather than at zero, so time_point{}
+            // still reads as "long ago" to the cores
+            const time_point start_time{std::chrono::duration_cast<time_point::duration>(std::chrono::hours(1))};
+
+        }// namespace
+
+        simulator::simulator(simulation_options options) : options_(std::move(options)), rng_(mix(options_.seed)) {
+            if (active) {
+                throw std::logic_error("another simulator owns the clock");
+            }
+            active = this;
+            clock::set_source(&virtual_now);
+        }
+
+        simulator::~simulator() {
+            nodes_.clear();// Cores go while the virtual clock is still installed
+            clock::set_source(nullptr);
+            active = nullptr;
+        }
+
+        uint32_t simulator::add_node(const node_view &self) {
+            const auto index = static_cast<uint32_t>(nodes_.size());
+            if (!index_.emplace(self.id, index).second) {
+                throw std::invalid_argument("duplicate node ID");
+            }
+
+            gossip_core_options core_options = options_.core;
+            core_options.seed = mix(options_.seed ^ mix(index + 1)) | 1;// Never 0, which means random
+
+            node n;
+            n.core = std::make_unique<gossip_core>(
+                    self,
+                    [this, index](const gossip_message &msg, const node_view &target) { send(index, msg, target); },
+                    [this, index](const node_view &node, node_status old_status) { on_event(index, node, old_status); },
+                    core_options);
+            n.region = region_index_of(self.region.str());
+            ++region_up_[n.region];
+            nodes_.push_back(std::move(n));
+            crash_of_.push_back(none);
+
+            // Spread the first ticks over one interval
+            const auto phase = static_cast<int64_t>(rng_() % static_cast<uint64_t>(interval_ns()));
+            schedule(now_ + phase, index, none);
+            return index;
+        }
+
+        void simulator::add_nodes(uint32_t n, const std::function<std::string(uint32_t)> &region_of) {
+            nodes_.reserve(nodes_.size() + n);
+            crash_of_.reserve(crash_of_.size() + n);
+            index_.reserve(index_.size() + n);
+            for (uint32_t i = 0; i < n; ++i) {
+                const auto number = static_cast<uint32_t>(nodes_.size());
+                node_view self;
+                self.id[0] = 0x51;
+                self.id[12] = static_cast<uint8_t>(number >> 24);
+                self.id[13] = static_cast<uint8_t>(number >> 16);
+                self.id[14] = static_cast<uint8_t>(number >> 8);
+                self.id[15] = static_cast<uint8_t>(number);
+                self.ip = "10." + std::to_string((number >> 16) & 0xFF) + "." +
+                          std::to_string((number >> 8) & 0xFF) + "." + std::to_string(number & 0xFF);
+                self.port = 7946;
+                if (region_of) {
+                    self.region = region_of(number);
+                }
+                add_node(self);
+            }
+        }
+
+        void simulator::meet(uint32_t from, uint32_t to) {
+            nodes_[from].core->meet(nodes_[to].core->self());
+        }
+
+        void simulator::crash(uint32_t index) {
+            node &n = nodes_[index];
+            if (!n.up) {
+                return;
+            }
+            n.up = false;
+            --region_up_[n.region];
+
+            // A crashed observer will not detect anything any more
+            for (size_t d = 0; d < watchers_.size(); ++d) {
+                auto it = std::find(watchers_[d].begin(), watchers_[d].end(), index);
+                if (it != watchers_[d].end()) {
+                    settle(static_cast<uint32_t>(d), static_cast<size_t>(it - watchers_[d].begin()));
+                }
+            }
+
+            detection record;
+            record.node = index;
+            record.crashed = now();
+            std::vector<uint32_t> watchers;
+            const node_id_t &id = n.core->self().id;
+            for (uint32_t i = 0; i < nodes_.size(); ++i) {
+                if (nodes_[i].up && nodes_[i].core->snapshot()->find(id)) {
+                    watchers.push_back(i);
+                }
+            }
+            record.observers = record.pending = static_cast<uint32_t>(watchers.size());
+            crash_of_[index] = static_cast<uint32_t>(detections_.size());
+            detections_.push_back(record);
+            watchers_.push_back(std::move(watchers));
+
+            if (!checking_) {
+                checking_ = true;
+                schedule(now_ + interval_ns(), none, none);
+            }
+        }
+
+        void simulator::recover(uint32_t index) {
+            node &n = nodes_[index];
+            if (n.up) {
+                return;
+            }
+            n.up = true;
+            ++region_up_[n.region];
+            if (crash_of_[index] != none) {
+                watchers_[crash_of_[index]].clear();// Back before everyone dropped it
+                crash_of_[index] = none;
+            }
+        }
+
+        uint32_t simulator::partition(const std::vector<uint32_t> &members) {
+            const uint32_t number = ++partitions_;
+            for (uint32_t index: members) {
+                nodes_[index].partition = number;
+            }
+            return number;
+        }
+
+        void simulator::heal() {
+            for (auto &n: nodes_) {
+                n.partition = 0;
+            }
+            partitions_ = 0;
+        }
+
+        void simulator::run_for(sim_duration d) {
+            const int64_t end = now_ + std::chrono::duration_cast<std::chrono::nanoseconds>(d).count();
+            while (!queue_.empty() && queue_.front().at <= end) {
+                std::pop_heap(queue_.begin(), queue_.end(), std::greater<event>());
+                const event e = queue_.back();
+                queue_.pop_back();
+                now_ = e.at;
+                run_event(e);
+            }
+            now_ = end;
+        }
+
+        std::optional<sim_duration> simulator::run_until(const std::function<bool()> &pred, sim_duration limit) {
+            const int64_t start = now_;
+            const int64_t deadline = start + std::chrono::duration_cast<std::chrono::nanoseconds>(limit).count();
+            while (!pred()) {
+                if (now_ >= deadline) {
+                    return std::nullopt;
+                }
+                run_for(std::chrono::duration_cast<sim_duration>(
+                        std::chrono::nanoseconds(std::min(interval_ns(), deadline - now_))));
+            }
+            return std::chrono::duration_cast<sim_duration>(std::chrono::nanoseconds(now_ - start));
+        }
+
+        bool simulator::converged() const {
+            const bool hierarchical = options_.core.hierarchical;
+            uint32_t up_total = 0;
+            uint32_t regions_up = 0;
+            for (uint32_t count: region_up_) {
+                up_total += count;
+                regions_up += count > 0;
+            }
+
+            // Counts first: cheap, and they fail long before the full check would
+            for (const auto &n: nodes_) {
+                if (!n.up) {
+                    continue;
+                }
+                if (n.core->size() != (hierarchical ? region_up_[n.region] : up_total) - 1 ||
+                    (hierarchical && n.core->get_stats().groups < regions_up)) {
+                    return false;
+                }
+            }
+
+            // With the counts right, holding only nodes that are up means holding all of them
+            for (const auto &n: nodes_) {
+                if (!n.up) {
+                    continue;
+                }
+                bool only_up = true;
+                n.core->snapshot()->for_each([this, &only_up](const node_view &view) {
+                    auto it = index_.find(view.id);
+                    only_up &= it != index_.end() && nodes_[it->second].up;
+                });
+                if (!only_up) {
+                    return false;
+                }
+                if (hierarchical) {
+                    uint32_t represented = 0;
+                    for (const auto &summary: n.core->get_groups()) {
+                        auto it = index_.find(summary.representative.id);
+                        represented += summary.term > 0 && it != index_.end() && nodes_[it->second].up;
+                    }
+                    if (represented != regions_up) {
+                        return false;
+                    }
+                }
+            }
+            return true;
+        }
+
+        time_point simulator::now() const noexcept {
+            return start_time + std::chrono::duration_cast<time_point::duration>(std::chrono::nanoseconds(now_));
+        }
+
+        sim_duration simulator::elapsed() const noexcept {
+            return std::chrono::duration_cast<sim_duration>(std::chrono::nanoseconds(now_));
+        }
+
+        void simulator::schedule(int64_t at, uint32_t node, uint32_t message) {
+            queue_.push_back({at, seq_++, node, message});
+            std::push_heap(queue_.begin(), queue_.end(), std::greater<event>());
+        }
+
+        void simulator::run_event(const event &e) {
+            if (e.node == none) {
+                check_detections();
+                return;
+            }
+
+            node &n = nodes_[e.node];
+            if (e.message == none) {
+                if (n.up) {
+                    n.core->tick();
+                    ++stats_.ticks;
+                }
+                schedule(e.at + interval_ns(), e.node, none);
+                return;
+            }
+
+            if (n.up) {
+                n.core->handle_message(pool_[e.message], now());
+                ++stats_.messages_delivered;
+            } else {
+                ++stats_.messages_undelivered;
+            }
+            free_.push_back(e.message);
+        }
+
+        void simulator::send(uint32_t from, const gossip_message &msg, const node_view &target) {
+            ++stats_.messages_sent;
+            stats_.entries_sent += msg.entries.size();
+
+            auto it = index_.find(target.id);
+            if (it == index_.end()) {
+                ++stats_.messages_undelivered;
+                return;
+            }
+            const uint32_t to = it->second;
+            if (nodes_[from].partition != nodes_[to].partition) {
+                ++stats_.messages_partitioned;
+                return;
+            }
+            const network_options &network = options_.network;
+            if (network.loss > 0 && static_cast<double>(rng_() >> 11) * 0x1.0p-53 < network.loss) {
+                ++stats_.messages_lost;
+                return;
+            }
+
+            int64_t latency = std::chrono::duration_cast<std::chrono::nanoseconds>(network.latency_min).count();
+            const int64_t spread = std::chrono::duration_cast<std::chrono::nanoseconds>(network.latency_max).count() - latency;
+            if (spread > 0) {
+                latency += static_cast<int64_t>(rng_() % static_cast<uint64_t>(spread + 1));
+            }
+            if (nodes_[from].region != nodes_[to].region) {
+                latency += std::chrono::duration_cast<std::chrono::nanoseconds>(network.cross_region_latency).count();
+            }
+
+            uint32_t slot;
+            if (!free_.empty()) {
+                slot = free_.back();
+                free_.pop_back();
+                pool_[slot] = msg;// Reuses the entry buffers of an earlier message
+            } else {
+                slot = static_cast<uint32_t>(pool_.size());
+                pool_.push_back(msg);
+            }
+            schedule(now_ + latency, to, slot);
+        }
+
+        void simulator::on_event(uint32_t observer, const node_view &view, node_status old_status) {
+            if (observer_) {
+                observer_(observer, view, old_status);
+            }
+            auto it = index_.find(view.id);
+            if (it == index_.end()) {
+                return;
+            }
+            const uint32_t subject = it->second;
+            const bool failed = view.status == node_status::failed;
+            if (nodes_[subject].up) {
+                stats_.false_suspicions += view.status == node_status::suspect;
+                stats_.false_failures += failed;
+                return;
+            }
+
+            const uint32_t d = crash_of_[subject];
+            if (d == none) {
+                return;
+            }
+            detection &record = detections_[d];
+            const auto since = std::chrono::duration_cast<sim_duration>(now() - record.crashed);
+            if (view.status == node_status::suspect && !record.first_suspect) {
+                record.first_suspect = since;
+            }
+            if (failed) {
+                if (!record.first_failed) {
+                    record.first_failed = since;
+                }
+                auto &watchers = watchers_[d];
+                auto pos = std::find(watchers.begin(), watchers.end(), observer);
+                if (pos != watchers.end()) {
+                    settle(d, static_cast<size_t>(pos - watchers.begin()));
+                }
+            }
+        }
+
+        void simulator::check_detections() {
+            bool open = false;
+            for (size_t d = 0; d < watchers_.size(); ++d) {
+                auto &watchers = watchers_[d];
+                const node_id_t &id = nodes_[detections_[d].node].core->self().id;
+                for (size_t pos = 0; pos < watchers.size();) {
+                    if (!nodes_[watchers[pos]].core->snapshot()->find(id)) {
+                        settle(static_cast<uint32_t>(d), pos);// Evicted at max_nodes, or already failed
+                    } else {
+                        ++pos;
+                    }
+                }
+                open |= !watchers.empty();
+            }
+            if (open) {
+                schedule(now_ + interval_ns(), none, none);
+            } else {
+                checking_ = false;
+            }
+        }
+
+        void simulator::settle(uint32_t d, size_t pos) {
+            auto &watchers = watchers_[d];
+            watchers[pos] = watchers.back();
+            watchers.pop_back();
+            detection &record = detections_[d];
+            if (--record.pending == 0) {
+                record.all_failed = std::chrono::duration_cast<sim_duration>(now() - record.crashed);
+                watchers.shrink_to_fit();
+            }
+        }
+
+        uint32_t simulator::region_index_of(const std::string &region) {
+            auto it = std::find(regions_.begin(), regions_.end(), region);
+            if (it != regions_.end()) {
+                return static_cast<uint32_t>(it - regions_.begin());
+            }
+            regions_.push_back(region);
+            region_up_.push_back(0);
+            return static_cast<uint32_t>(regions_.size() - 1);
+        }
+
+        int64_t simulator::interval_ns() const noexcept {
+            return static_cast<int64_t>(options_.core.heartbeat_interval_ms) * 1000000;
+        }
+
+    }// namespace sim
+}// namespace libgossip
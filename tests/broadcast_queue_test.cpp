@@ -0,0 +1,96 @@
+#include "core/broadcast_queue.hpp"
+#include <gtest/gtest.h>
+#include <vector>
+
+using namespace libgossip;
+
+namespace {
+
+    std::vector<uint32_t> take_indices(broadcast_queue &queue, size_t max, uint32_t limit) {
+        std::vector<node_handle> out;
+        queue.take(max, limit, [](node_handle) { return true; }, out);
+        std::vector<uint32_t> indices;
+        for (const auto &h: out) {
+            indices.push_back(h.index);
+        }
+        return indices;
+    }
+
+}// namespace
+
+TEST(BroadcastQueueTest, NewestFirst) {
+    broadcast_queue queue;
+    queue.push({1, 0});
+    queue.push({2, 0});
+    queue.push({3, 0});
+    EXPECT_EQ(queue.size(), 3);
+
+    EXPECT_EQ(take_indices(queue, 2, 10), (std::vector<uint32_t>{3, 2}));
+    // 1 has not been sent yet, so it goes before the ones sent once
+    EXPECT_EQ(take_indices(queue, 2, 10), (std::vector<uint32_t>{1, 2}));
+}
+
+TEST(BroadcastQueueTest, DroppedAfterRetransmitLimit) {
+    broadcast_queue queue;
+    queue.push({7, 0});
+    for (int i = 0; i < 3; ++i) {
+        EXPECT_EQ(take_indices(queue, 4, 3), std::vector<uint32_t>{7});
+    }
+    EXPECT_TRUE(queue.empty());
+    EXPECT_TRUE(take_indices(queue, 4, 3).empty());
+}
+
+TEST(BroadcastQueueTest, LoweredLimitDropsOldBroadcasts) {
+    broadcast_queue queue;
+    queue.push({1, 0});
+    queue.push({2, 0});
+    take_indices(queue, 1, 10);// 2 sent once
+    take_indices(queue, 1, 10);// 1 sent once
+    queue.push({3, 0});
+
+    EXPECT_EQ(take_indices(queue, 4, 1), std::vector<uint32_t>{3});
+    EXPECT_TRUE(queue.empty());
+}
+
+TEST(BroadcastQueueTest, PushRestartsTransmitCount) {
+    broadcast_queue queue;
+    queue.push({1, 0});
+    queue.push({2, 0});
+    take_indices(queue, 2, 10);
+    take_indices(queue, 2, 10);
+
+    // A newer change of 1 jumps ahead of 2, which has been sent twice
+    queue.push({1, 0});
+    EXPECT_EQ(queue.size(), 2);
+    EXPECT_EQ(take_indices(queue, 1, 10), std::vector<uint32_t>{1});
+}
+
+TEST(BroadcastQueueTest, SkippedEntriesStayQueued) {
+    broadcast_queue queue;
+    queue.push({1, 0});
+    queue.push({2, 4});
+
+    std::vector<node_handle> out;
+    queue.take(4, 1, [](node_handle h) { return h.index != 2; }, out);
+    ASSERT_EQ(out.size(), 1);
+    EXPECT_EQ(out[0].index, 1);
+
+    queue.take(4, 1, [](node_handle) { return true; }, out);
+    ASSERT_EQ(out.size(), 1);
+    EXPECT_EQ(out[0], (node_handle{2, 4}));
+    EXPECT_TRUE(queue.empty());
+}
+
+TEST(BroadcastQueueTest, RemoveAndClear) {
+    broadcast_queue queue;
+    queue.push({1, 0});
+    queue.push({2, 0});
+    queue.push({3, 0});
+    queue.remove(2);
+    queue.remove(9);
+    EXPECT_EQ(take_indices(queue, 4, 10), (std::vector<uint32_t>{3, 1}));
+
+    queue.clear();
+    EXPECT_TRUE(queue.empty());
+    EXPECT_TRUE(take_indices(queue, 4, 10).empty());
+}
@@ -0,0 +1,147 @@
+#include "core/event_queue.hpp"
+#include <gtest/gtest.h>
+#include <vector>
+
+using namespace libgossip;
+
+namespace {
+
+    node_view make_node(int port) {
+        node_view node;
+        node.id[15] = static_cast<uint8_t>(port);
+        node.ip = "10.0.0.1";
+        node.port = port;
+        return node;
+    }
+
+    std::vector<int> drain(event_queue &queue) {
+        std::vector<int> ports;
+        queued_event event;
+        while (queue.pop(event)) {
+            ports.push_back(event.node.port);
+        }
+        return ports;
+    }
+
+}// namespace
+
+TEST(EventQueueTest, FifoAcrossWrapAround) {
+    event_queue queue(4, event_overflow_policy::drop_oldest);
+    for (int round = 0; round < 3; ++round) {
+        for (int i = 0; i < 3; ++i) {
+            EXPECT_TRUE(queue.push(make_node(round * 10 + i), node_status::online, time_point{}));
+        }
+        EXPECT_EQ(drain(queue), (std::vector<int>{round * 10, round * 10 + 1, round * 10 + 2}));
+    }
+    EXPECT_TRUE(queue.empty());
+    EXPECT_EQ(queue.peak(), 3);
+    EXPECT_EQ(queue.dropped(), 0);
+}
+
+TEST(EventQueueTest, DropOldestKeepsTheNewestEvents) {
+    event_queue queue(3, event_overflow_policy::drop_oldest);
+    for (int i = 1; i <= 5; ++i) {
+        queue.push(make_node(i), node_status::online, time_point{});
+    }
+    EXPECT_EQ(queue.dropped(), 2);
+    EXPECT_EQ(drain(queue), (std::vector<int>{3, 4, 5}));
+}
+
+TEST(EventQueueTest, DropNewestKeepsTheOldestEvents) {
+    event_queue queue(3, event_overflow_policy::drop_newest);
+    for (int i = 1; i <= 5; ++i) {
+        EXPECT_EQ(queue.push(make_node(i), node_status::online, time_point{}), i <= 3);
+    }
+    EXPECT_EQ(queue.dropped(), 2);
+    EXPECT_EQ(drain(queue), (std::vector<int>{1, 2, 3}));
+}
+
+TEST(EventQueueTest, GrowNeverDropsAndKeepsOrder) {
+    event_queue queue(2, event_overflow_policy::grow);
+    queued_event event;
+    queue.push(make_node(1), node_status::online, time_point{});
+    queue.push(make_node(2), node_status::online, time_point{});
+    ASSERT_TRUE(queue.pop(event));// Head is now mid-ring
+    for (int i = 3; i <= 9; ++i) {
+        EXPECT_TRUE(queue.push(make_node(i), node_status::online, time_point{}));
+    }
+    EXPECT_EQ(queue.dropped(), 0);
+    EXPECT_GE(queue.capacity(), 8);
+    EXPECT_EQ(drain(queue), (std::vector<int>{2, 3, 4, 5, 6, 7, 8, 9}));
+}
+
+TEST(EventQueueTest, PopCarriesTheEvent) {
+    event_queue queue(2, event_overflow_policy::drop_oldest);
+    node_view node = make_node(7);
+    node.metadata["k"] = "v";
+    const time_point when = time_point{} + std::chrono::milliseconds(5);
+    queue.push(node, node_status::suspect, when);
+
+    queued_event event;
+    ASSERT_TRUE(queue.pop(event));
+    EXPECT_EQ(event.node, node);
+    EXPECT_EQ(event.old_status, node_status::suspect);
+    EXPECT_EQ(event.queued_at, when);
+    EXPECT_FALSE(queue.pop(event));
+}
+
+TEST(ChangeBatchTest, OneNetChangePerNode) {
+    change_batch batch;
+    auto add = [&batch](int port, node_status old_status, node_status status, uint64_t heartbeat = 0) {
+        queued_event event;
+        event.node = make_node(port);
+        event.node.status = status;
+        event.node.heartbeat = heartbeat;
+        event.old_status = old_status;
+        batch.add(event);
+    };
+    add(1, node_status::unknown, node_status::joining);// New node...
+    add(1, node_status::joining, node_status::online); // ...then online
+    add(2, node_status::online, node_status::suspect); // Flaps back: no net change
+    add(2, node_status::suspect, node_status::online);
+    add(3, node_status::online, node_status::online, 7);// Metadata/heartbeat only
+    add(4, node_status::online, node_status::suspect);
+    add(4, node_status::suspect, node_status::failed);
+    batch.finish();
+
+    ASSERT_EQ(batch.changes().size(), 3);
+    EXPECT_EQ(batch.changes()[0].node.port, 1);
+    EXPECT_EQ(batch.changes()[0].old_status, node_status::unknown);
+    EXPECT_EQ(batch.changes()[0].node.status, node_status::online);
+    EXPECT_EQ(batch.changes()[1].node.port, 3);
+    EXPECT_EQ(batch.changes()[1].node.heartbeat, 7);
+    EXPECT_EQ(batch.changes()[2].node.port, 4);
+    EXPECT_EQ(batch.changes()[2].old_status, node_status::online);
+    EXPECT_EQ(batch.changes()[2].node.status, node_status::failed);
+
+    batch.clear();
+    EXPECT_TRUE(batch.empty());
+    add(2, node_status::online, node_status::suspect);
+    batch.finish();
+    ASSERT_EQ(batch.changes().size(), 1);
+    EXPECT_EQ(batch.changes()[0].node.port, 2);
+}
+
+TEST(ChangeBatchTest, FlapWithOtherChangesIsKept) {
+    change_batch batch;
+    queued_event event;
+    event.node = make_node(1);
+    event.node.status = node_status::suspect;
+    event.old_status = node_status::online;
+    batch.add(event);
+    event.node = make_node(1);
+    event.node.status = node_status::suspect;
+    event.node.metadata["zone"] = "b";
+    event.old_status = node_status::suspect;
+    batch.add(event);
+    event.node = make_node(1);
+    event.node.status = node_status::online;
+    event.node.metadata["zone"] = "b";
+    event.old_status = node_status::suspect;
+    batch.add(event);
+    batch.finish();
+
+    ASSERT_EQ(batch.changes().size(), 1);
+    EXPECT_EQ(batch.changes()[0].node.metadata.at("zone"), "b");
+    EXPECT_EQ(batch.changes()[0].old_status, node_status::online);
+}
@@ -0,0 +1,132 @@
+#include "core/failure_detector.hpp"
+#include <gtest/gtest.h>
+#include <random>
+
+using namespace libgossip;
+
+namespace {
+
+    using std::chrono::milliseconds;
+
+    const time_point epoch = time_point{} + std::chrono::hours(1);
+
+    node_view node_seen_at(time_point seen) {
+        node_view node;
+        node.status = node_status::online;
+        node.seen_time = seen;
+        return node;
+    }
+
+}// namespace
+
+TEST(FailureDetectorTest, TimeoutDetector) {
+    timeout_detector detector(milliseconds(2000));
+    node_handle h{0, 0};
+    node_view node = node_seen_at(epoch);
+
+    EXPECT_EQ(detector.suspect_deadline(h, node), epoch + milliseconds(2000));
+    EXPECT_DOUBLE_EQ(detector.suspicion(h, node, epoch + milliseconds(1000)), 0.5);
+}
+
+TEST(FailureDetectorTest, PhiFallsBackToTimeoutUntilEnoughSamples) {
+    phi_accrual_detector detector(8.0, milliseconds(10), milliseconds(2000));
+    node_handle h{3, 1};
+    node_view node = node_seen_at(epoch);
+
+    EXPECT_EQ(detector.suspect_deadline(h, node), epoch + milliseconds(2000));
+    detector.heartbeat(h, epoch);
+    detector.heartbeat(h, epoch + milliseconds(100));
+    EXPECT_EQ(detector.suspect_deadline(h, node), epoch + milliseconds(2000));
+
+    detector.heartbeat(h, epoch + milliseconds(200));
+    detector.heartbeat(h, epoch + milliseconds(300));
+    EXPECT_LT(detector.suspect_deadline(h, node), epoch + milliseconds(2000));
+}
+
+TEST(FailureDetectorTest, PhiCrossesThresholdAtDeadline) {
+    const double threshold = 8.0;
+    phi_accrual_detector detector(threshold, milliseconds(10), milliseconds(2000));
+    node_handle h{0, 0};
+    std::mt19937 rng(1);
+
+    time_point t = epoch;
+    for (int i = 0; i < 100; ++i) {
+        t += milliseconds(80 + rng() % 40);
+        detector.heartbeat(h, t);
+    }
+    node_view node = node_seen_at(t);
+
+    time_point deadline = detector.suspect_deadline(h, node);
+    EXPECT_GT(deadline, t + milliseconds(120));
+    EXPECT_GE(detector.suspicion(h, node, deadline), threshold);
+    EXPECT_LT(detector.suspicion(h, node, deadline - milliseconds(1)), threshold);
+
+    // phi keeps accruing with silence
+    EXPECT_LT(detector.suspicion(h, node, t + milliseconds(50)), detector.suspicion(h, node, t + milliseconds(150)));
+}
+
+TEST(FailureDetectorTest, JitteryNodesGetMoreSlack) {
+    phi_accrual_detector detector(8.0, milliseconds(10), milliseconds(2000));
+    node_handle steady{0, 0};
+    node_handle jittery{1, 0};
+    std::mt19937 rng(2);
+
+    time_point t = epoch;
+    for (int i = 0; i < 64; ++i) {
+        t += milliseconds(100);
+        detector.heartbeat(steady, t);
+        detector.heartbeat(jittery, t + milliseconds(rng() % 60));
+    }
+    detector.heartbeat(jittery, t);
+
+    node_view node = node_seen_at(t);
+    EXPECT_LT(detector.suspect_deadline(steady, node), detector.suspect_deadline(jittery, node));
+}
+
+TEST(FailureDetectorTest, WindowSlides) {
+    phi_accrual_detector detector(8.0, milliseconds(10), milliseconds(5000));
+    node_handle h{0, 0};
+
+    time_point t = epoch;
+    detector.heartbeat(h, t);
+    for (int i = 0; i < 200; ++i) {
+        t += milliseconds(100);
+        detector.heartbeat(h, t);
+    }
+    node_view node = node_seen_at(t);
+    auto fast = detector.suspect_deadline(h, node) - t;
+
+    // Once the window only holds 1 s intervals the old ones no longer count
+    for (size_t i = 0; i < phi_accrual_detector::window_size; ++i) {
+        t += milliseconds(1000);
+        detector.heartbeat(h, t);
+    }
+    node = node_seen_at(t);
+    auto slow = detector.suspect_deadline(h, node) - t;
+    EXPECT_EQ(std::chrono::duration_cast<milliseconds>(fast).count() + 900,
+              std::chrono::duration_cast<milliseconds>(slow).count());
+}
+
+TEST(FailureDetectorTest, ReusedSlotStartsFresh) {
+    phi_accrual_detector detector(8.0, milliseconds(10), milliseconds(2000));
+    node_handle old_handle{5, 0};
+    time_point t = epoch;
+    for (int i = 0; i < 10; ++i) {
+        t += milliseconds(100);
+        detector.heartbeat(old_handle, t);
+    }
+
+    node_view node = node_seen_at(t);
+    node_handle new_handle{5, 1};
+    EXPECT_EQ(detector.suspect_deadline(new_handle, node), t + milliseconds(2000));
+
+    detector.forget(old_handle);
+    EXPECT_EQ(detector.suspect_deadline(old_handle, node), t + milliseconds(2000));
+}
+
+TEST(FailureDetectorTest, FactorySelectsPolicy) {
+    gossip_core_options options;
+    EXPECT_NE(dynamic_cast<timeout_detector *>(make_failure_detector(options).get()), nullptr);
+    options.detector = failure_detector_type::phi_accrual;
+    EXPECT_NE(dynamic_cast<phi_accrual_detector *>(make_failure_detector(options).get()), nullptr);
+}
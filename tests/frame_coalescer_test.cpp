@@ -0,0 +1,104 @@
+#include "net/frame_coalescer.hpp"
+#include <gtest/gtest.h>
+#include <string>
+#include <vector>
+
+using namespace libgossip;
+using namespace libgossip::net;
+
+namespace {
+
+    struct sent_datagram {
+        std::string ip;
+        int port;
+        std::vector<uint8_t> bytes;
+    };
+
+    // Split a datagram the way udp_transport's receive loop does
+    std::vector<std::vector<uint8_t>> parse_frames(const std::vector<uint8_t> &datagram) {
+        std::vector<std::vector<uint8_t>> frames;
+        size_t offset = 0;
+        while (offset + 4 <= datagram.size()) {
+            const uint32_t length = (static_cast<uint32_t>(datagram[offset]) << 24) |
+                                    (static_cast<uint32_t>(datagram[offset + 1]) << 16) |
+                                    (static_cast<uint32_t>(datagram[offset + 2]) << 8) |
+                                    static_cast<uint32_t>(datagram[offset + 3]);
+            offset += 4;
+            if (offset + length > datagram.size()) {
+                break;
+            }
+            frames.emplace_back(datagram.begin() + offset, datagram.begin() + offset + length);
+            offset += length;
+        }
+        EXPECT_EQ(offset, datagram.size());
+        return frames;
+    }
+
+    std::vector<uint8_t> payload(uint8_t tag, size_t size) {
+        return std::vector<uint8_t>(size, tag);
+    }
+
+}// namespace
+
+TEST(FrameCoalescerTest, MergesFramesPerTargetInOrderOfFirstFrame) {
+    frame_coalescer coalescer;
+    std::vector<sent_datagram> sent;
+    const frame_coalescer::emit_fn emit = [&sent](const ip_address &ip, int port, const std::vector<uint8_t> &datagram) {
+        sent.push_back({ip.str(), port, datagram});
+    };
+
+    EXPECT_TRUE(coalescer.append("10.0.0.2", 7000, payload(1, 10), emit));
+    EXPECT_FALSE(coalescer.append("10.0.0.1", 7000, payload(2, 20), emit));
+    EXPECT_FALSE(coalescer.append("10.0.0.2", 7000, payload(3, 30), emit));
+    EXPECT_FALSE(coalescer.append("10.0.0.2", 7001, payload(4, 40), emit));// Another port, another target
+    EXPECT_TRUE(coalescer.pending());
+    EXPECT_TRUE(sent.empty());
+
+    coalescer.flush(emit);
+    EXPECT_FALSE(coalescer.pending());
+    ASSERT_EQ(sent.size(), 3);
+    EXPECT_EQ(sent[0].ip, "10.0.0.2");
+    EXPECT_EQ(sent[0].port, 7000);
+    EXPECT_EQ(sent[1].ip, "10.0.0.1");
+    EXPECT_EQ(sent[2].port, 7001);
+
+    const auto frames = parse_frames(sent[0].bytes);
+    ASSERT_EQ(frames.size(), 2);
+    EXPECT_EQ(frames[0], payload(1, 10));
+    EXPECT_EQ(frames[1], payload(3, 30));
+    EXPECT_EQ(parse_frames(sent[1].bytes).size(), 1);
+    EXPECT_EQ(coalescer.frames(), 4);
+    EXPECT_EQ(coalescer.datagrams(), 3);
+
+    // The next window starts afresh
+    sent.clear();
+    EXPECT_TRUE(coalescer.append("10.0.0.1", 7000, payload(5, 5), emit));
+    coalescer.flush(emit);
+    ASSERT_EQ(sent.size(), 1);
+    EXPECT_EQ(parse_frames(sent[0].bytes), (std::vector<std::vector<uint8_t>>{payload(5, 5)}));
+}
+
+TEST(FrameCoalescerTest, EmitsEarlyAtTheSizeLimit) {
+    frame_coalescer coalescer(100);
+    std::vector<sent_datagram> sent;
+    const frame_coalescer::emit_fn emit = [&sent](const ip_address &ip, int port, const std::vector<uint8_t> &datagram) {
+        sent.push_back({ip.str(), port, datagram});
+    };
+
+    coalescer.append("10.0.0.1", 7000, payload(1, 40), emit);
+    coalescer.append("10.0.0.1", 7000, payload(2, 40), emit);// 88 bytes
+    EXPECT_TRUE(sent.empty());
+    coalescer.append("10.0.0.1", 7000, payload(3, 40), emit);// Would be 132
+    ASSERT_EQ(sent.size(), 1);
+    EXPECT_EQ(parse_frames(sent[0].bytes).size(), 2);
+
+    coalescer.append("10.0.0.1", 7000, payload(4, 200), emit);// Larger than the limit, alone
+    ASSERT_EQ(sent.size(), 2);
+    EXPECT_EQ(parse_frames(sent[1].bytes), (std::vector<std::vector<uint8_t>>{payload(3, 40)}));
+
+    coalescer.flush(emit);
+    ASSERT_EQ(sent.size(), 3);
+    EXPECT_EQ(parse_frames(sent[2].bytes), (std::vector<std::vector<uint8_t>>{payload(4, 200)}));
+    EXPECT_EQ(coalescer.frames(), 4);
+    EXPECT_EQ(coalescer.datagrams(), 3);
+}
@@ -1,5 +1,11 @@
 #include "core/gossip_core.hpp"
+#include <algorithm>
+#include <atomic>
 #include <gtest/gtest.h>
+#include <map>
+#include <memory>
+#include <set>
+#include <thread>
 
 using namespace libgossip;
 
@@ -157,7 +163,1453 @@ TEST_F(GossipCoreTest, NodeViewCanReplaceTest) {
     EXPECT_TRUE(node2.can_replace(node1));
 }
 
+TEST_F(GossipCoreTest, TemporaryIdReplacedByRealId) {
+    gossip_core core(self_node, mock_send_callback, mock_event_callback);
+
+    // Meet a peer by address only, as gossip_manager::meet_node does
+    node_view seed;
+    seed.ip = "127.0.0.2";
+    seed.port = 8001;
+    core.meet(seed);
+    ASSERT_EQ(core.size(), 1);
+
+    // Its pong carries the real ID for the same address
+    node_view real = seed;
+    real.id = {{0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 2}};
+    real.heartbeat = 5;
+    real.status = node_status::online;
+
+    gossip_message pong;
+    pong.sender = real.id;
+    pong.type = message_type::pong;
+    pong.timestamp = real.heartbeat;
+    pong.entries.push_back(real);
+    core.handle_message(pong, clock::now());
+
+    EXPECT_EQ(core.size(), 1);
+    EXPECT_FALSE(core.find_node(node_id_t{}).has_value());
+    auto found = core.find_node(real.id);
+    ASSERT_TRUE(found.has_value());
+    EXPECT_EQ(found->ip, seed.ip);
+    EXPECT_EQ(found->heartbeat, 5u);
+}
+
+TEST_F(GossipCoreTest, TickSelectsDistinctRandomPeers) {
+    std::vector<std::pair<gossip_message, node_view>> sent;
+    gossip_core core(
+            self_node,
+            [&sent](const gossip_message &msg, const node_view &target) { sent.emplace_back(msg, target); },
+            mock_event_callback);
+
+    const int cluster = 20;
+    for (int i = 0; i < cluster; ++i) {
+        node_view node;
+        node.id = {{0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 1, static_cast<uint8_t>(i)}};
+        node.ip = "127.0.1." + std::to_string(i);
+        node.port = 9000;
+        core.meet(node);
+    }
+
+    std::map<node_id_t, int> hits;
+    const int ticks = 2000;
+    for (int t = 0; t < ticks; ++t) {
+        sent.clear();
+        core.tick();
+        ASSERT_EQ(sent.size(), static_cast<size_t>(config::DEFAULT_GOSSIP_NODES));
+
+        std::set<node_id_t> targets;
+        for (const auto &[msg, target]: sent) {
+            EXPECT_TRUE(targets.insert(target.id).second);
+            hits[target.id]++;
+
+            // Self first, then distinct extras that never include the target
+            ASSERT_EQ(msg.entries.size(), 1 + static_cast<size_t>(config::DEFAULT_SYNC_NODES));
+            EXPECT_EQ(msg.entries[0].id, self_node.id);
+            std::set<node_id_t> extras;
+            for (size_t e = 1; e < msg.entries.size(); ++e) {
+                EXPECT_NE(msg.entries[e].id, target.id);
+                EXPECT_TRUE(extras.insert(msg.entries[e].id).second);
+            }
+        }
+    }
+
+    // Every member is picked about gossip_nodes / cluster of the time
+    ASSERT_EQ(hits.size(), static_cast<size_t>(cluster));
+    const double expected = static_cast<double>(ticks) * config::DEFAULT_GOSSIP_NODES / cluster;
+    for (const auto &[id, count]: hits) {
+        EXPECT_GT(count, expected * 0.75);
+        EXPECT_LT(count, expected * 1.25);
+    }
+}
+
 int main(int argc, char **argv) {
     ::testing::InitGoogleTest(&argc, argv);
     return RUN_ALL_TESTS();
-}
\ No newline at end of file
+}
+TEST_F(GossipCoreTest, RoundRobinProbesEveryMemberEachRound) {
+    std::vector<node_id_t> pinged;
+    gossip_core_options options;
+    options.scheduler = probe_scheduler::round_robin;
+    gossip_core core(
+            self_node,
+            [&pinged](const gossip_message &msg, const node_view &target) {
+                if (msg.type == message_type::ping) {
+                    pinged.push_back(target.id);
+                }
+            },
+            mock_event_callback, options);
+    EXPECT_EQ(core.options().scheduler, probe_scheduler::round_robin);
+
+    const int cluster = 25;
+    for (int i = 0; i < cluster; ++i) {
+        node_view node;
+        node.id = {{0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 1, static_cast<uint8_t>(i)}};
+        node.ip = "127.0.1." + std::to_string(i);
+        node.port = 9000;
+        core.meet(node);
+    }
+
+    const int k = config::DEFAULT_GOSSIP_NODES;
+    const int round_ticks = (cluster + k - 1) / k;
+
+    // Each member is probed once per round, so the gap between two probes
+    // of the same member never exceeds two rounds of ceil(N / k) ticks
+    std::map<node_id_t, int> last_probe;
+    int max_gap = 0;
+    for (int t = 0; t < 20 * round_ticks; ++t) {
+        pinged.clear();
+        core.tick();
+        for (const auto &id: pinged) {
+            auto it = last_probe.find(id);
+            if (it != last_probe.end()) {
+                max_gap = std::max(max_gap, t - it->second);
+            }
+            last_probe[id] = t;
+        }
+    }
+    EXPECT_EQ(last_probe.size(), static_cast<size_t>(cluster));
+    EXPECT_LE(max_gap, 2 * round_ticks);
+
+    // A member that joins mid-round is probed within the next two rounds
+    node_view late;
+    late.id = {{0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 2, 0}};
+    late.ip = "127.0.2.1";
+    late.port = 9000;
+    core.meet(late);
+    bool probed = false;
+    for (int t = 0; t < 2 * (round_ticks + 1) && !probed; ++t) {
+        pinged.clear();
+        core.tick();
+        probed = std::find(pinged.begin(), pinged.end(), late.id) != pinged.end();
+    }
+    EXPECT_TRUE(probed);
+}
+
+TEST_F(GossipCoreTest, FailureDetectionAndCleanupUseTimers) {
+    std::vector<std::pair<node_id_t, node_status>> events;
+    gossip_core_options options;
+    options.failure_timeout_ms = 20;
+    options.indirect_probes = 0;
+    gossip_core core(
+            self_node, mock_send_callback,
+            [&events](const node_view &node, node_status) { events.emplace_back(node.id, node.status); },
+            options);
+
+    // Two members learned as online entries of a message
+    gossip_message msg;
+    msg.sender = self_node.id;
+    msg.type = message_type::update;
+    for (uint8_t i = 0; i < 2; ++i) {
+        node_view node;
+        node.id = {{0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 3, i}};
+        node.ip = "127.0.3.1";
+        node.port = 9000 + i;
+        node.heartbeat = 1;
+        node.status = node_status::online;
+        msg.entries.push_back(node);
+    }
+    const node_id_t quiet = msg.entries[0].id;
+    const node_id_t chatty = msg.entries[1].id;
+    core.handle_message(msg, clock::now());
+    ASSERT_EQ(core.size(), 2);
+
+    core.tick();
+    EXPECT_EQ(core.find_node(quiet)->status, node_status::online);
+
+    // Only the member that stays silent past the timeout becomes suspect, then failed
+    gossip_message heartbeat;
+    heartbeat.sender = chatty;
+    heartbeat.type = message_type::update;
+    for (int round = 0; round < 6; ++round) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(25));
+        heartbeat.timestamp++;
+        core.handle_message(heartbeat, clock::now());
+        core.tick();
+    }
+    EXPECT_FALSE(core.find_node(quiet).has_value());// Buried
+    EXPECT_EQ(core.find_tombstone(quiet)->status, node_status::failed);
+    EXPECT_EQ(core.find_node(chatty)->status, node_status::online);
+    ASSERT_GE(events.size(), 2);
+    EXPECT_EQ(events[events.size() - 2], std::make_pair(quiet, node_status::suspect));
+    EXPECT_EQ(events.back(), std::make_pair(quiet, node_status::failed));
+
+    // Tombstones are dropped once old enough, online members are kept
+    core.cleanup_expired(std::chrono::milliseconds(10000));
+    EXPECT_EQ(core.size(), 1);
+    EXPECT_EQ(core.get_stats().tombstones, 1);
+    std::this_thread::sleep_for(std::chrono::milliseconds(60));
+    core.cleanup_expired(std::chrono::milliseconds(50));
+    EXPECT_FALSE(core.find_tombstone(quiet).has_value());
+    EXPECT_EQ(core.get_stats().tombstones, 0);
+    EXPECT_TRUE(core.find_node(chatty).has_value());
+}
+
+TEST_F(GossipCoreTest, PhiAccrualDetectorAdaptsToHeartbeatRate) {
+    std::vector<std::pair<node_id_t, node_status>> events;
+    gossip_core_options options;
+    options.failure_timeout_ms = 5000;
+    options.detector = failure_detector_type::phi_accrual;
+    options.phi_min_std_deviation_ms = 5;
+    gossip_core core(
+            self_node, mock_send_callback,
+            [&events](const node_view &node, node_status) { events.emplace_back(node.id, node.status); },
+            options);
+
+    node_view peer;
+    peer.id = {{0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 4, 1}};
+    peer.ip = "127.0.4.1";
+    peer.port = 9000;
+    peer.heartbeat = 1;
+    peer.status = node_status::online;
+    gossip_message hello;
+    hello.sender = peer.id;
+    hello.type = message_type::update;
+    hello.entries.push_back(peer);
+    core.handle_message(hello, clock::now());
+
+    // Regular 10 ms heartbeats teach the detector to expect them
+    gossip_message heartbeat;
+    heartbeat.sender = peer.id;
+    heartbeat.type = message_type::update;
+    for (int i = 0; i < 20; ++i) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        heartbeat.timestamp++;
+        core.handle_message(heartbeat, clock::now());
+        core.tick();
+    }
+    EXPECT_EQ(core.find_node(peer.id)->status, node_status::online);
+    ASSERT_TRUE(core.suspicion_level(peer.id).has_value());
+    EXPECT_LT(*core.suspicion_level(peer.id), options.phi_threshold);
+
+    // A silence far shorter than failure_timeout_ms is already suspicious
+    std::this_thread::sleep_for(std::chrono::milliseconds(150));
+    EXPECT_GT(*core.suspicion_level(peer.id), options.phi_threshold);
+    core.tick();
+    EXPECT_EQ(core.find_node(peer.id)->status, node_status::suspect);
+    ASSERT_FALSE(events.empty());
+    EXPECT_EQ(events.back(), std::make_pair(peer.id, node_status::suspect));
+    EXPECT_FALSE(core.suspicion_level(self_node.id).has_value());
+}
+
+namespace {
+
+    // Three cores exchanging messages through a queue; once broken, the a <-> t link drops everything
+    struct indirect_probe_cluster {
+        struct envelope {
+            size_t to;
+            gossip_message msg;
+        };
+
+        std::vector<node_view> views;
+        std::vector<std::unique_ptr<gossip_core>> cores;
+        std::vector<envelope> queue;
+        std::vector<std::pair<node_id_t, node_status>> a_events;
+        bool link_broken = false;
+
+        explicit indirect_probe_cluster(int indirect_probes) {
+            gossip_core_options options;
+            options.failure_timeout_ms = 40;
+            options.sync_nodes = 0;// Only direct contact refreshes a node
+            options.indirect_probes = indirect_probes;
+            options.indirect_probe_timeout_ms = 100;
+
+            for (uint8_t i = 0; i < 3; ++i) {
+                node_view view;
+                view.id = {{0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 5, i}};
+                view.ip = "127.0.5.1";
+                view.port = 9000 + i;
+                views.push_back(view);
+            }
+            for (size_t i = 0; i < 3; ++i) {
+                event_callback on_event = nullptr;
+                if (i == 0) {
+                    on_event = [this](const node_view &node, node_status) { a_events.emplace_back(node.id, node.status); };
+                }
+                cores.push_back(std::make_unique<gossip_core>(
+                        views[i],
+                        [this, i](const gossip_message &msg, const node_view &target) {
+                            size_t to = static_cast<size_t>(target.port - 9000);
+                            if (!link_broken || !((i == 0 && to == 2) || (i == 2 && to == 0))) {
+                                queue.push_back({to, msg});
+                            }
+                        },
+                        on_event, options));
+            }
+            for (size_t i = 0; i < 3; ++i) {
+                for (size_t j = 0; j < 3; ++j) {
+                    if (i != j) {
+                        cores[i]->meet(views[j]);
+                    }
+                }
+            }
+        }
+
+        void run(int rounds) {
+            for (int r = 0; r < rounds; ++r) {
+                for (auto &core: cores) {
+                    core->tick();
+                }
+                while (!queue.empty()) {
+                    envelope e = std::move(queue.front());
+                    queue.erase(queue.begin());
+                    cores[e.to]->handle_message(e.msg, clock::now());
+                }
+                std::this_thread::sleep_for(std::chrono::milliseconds(5));
+            }
+        }
+
+        bool a_saw(node_status status) const {
+            return std::any_of(a_events.begin(), a_events.end(), [&](const auto &event) {
+                return event.first == views[2].id && event.second == status;
+            });
+        }
+    };
+
+}// namespace
+
+TEST_F(GossipCoreTest, IndirectProbeRescuesNodeBehindBrokenLink) {
+    indirect_probe_cluster cluster(config::DEFAULT_INDIRECT_PROBES);
+    cluster.run(5);
+    ASSERT_EQ(cluster.cores[0]->find_node(cluster.views[2].id)->status, node_status::online);
+    cluster.link_broken = true;
+    cluster.run(60);
+
+    // a never hears from t directly, but m keeps vouching for it
+    auto stats = cluster.cores[0]->get_stats();
+    EXPECT_GT(stats.indirect_probes_sent, 0);
+    EXPECT_GT(stats.indirect_probe_rescues, 0);
+    EXPECT_FALSE(cluster.a_saw(node_status::failed));
+    EXPECT_NE(cluster.cores[0]->find_node(cluster.views[2].id)->status, node_status::failed);
+}
+
+TEST_F(GossipCoreTest, WithoutIndirectProbesBrokenLinkLooksLikeFailure) {
+    indirect_probe_cluster cluster(0);
+    cluster.run(5);
+    cluster.link_broken = true;
+    cluster.run(60);
+
+    auto stats = cluster.cores[0]->get_stats();
+    EXPECT_EQ(stats.indirect_probes_sent, 0);
+    EXPECT_TRUE(cluster.a_saw(node_status::suspect));
+    EXPECT_FALSE(cluster.cores[0]->find_node(cluster.views[2].id).has_value());
+    EXPECT_EQ(cluster.cores[0]->find_tombstone(cluster.views[2].id)->status, node_status::failed);
+}
+
+TEST_F(GossipCoreTest, BroadcastQueueCarriesChangesLogNTimes) {
+    std::vector<gossip_message> sent;
+    gossip_core_options options;
+    options.dissemination = dissemination_mode::broadcast_queue;
+    options.retransmit_mult = 2;
+    gossip_core core(
+            self_node, [&sent](const gossip_message &msg, const node_view &) { sent.push_back(msg); },
+            mock_event_callback, options);
+
+    const int cluster = 8;
+    for (int i = 0; i < cluster; ++i) {
+        node_view node;
+        node.id = {{0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 6, static_cast<uint8_t>(i)}};
+        node.ip = "127.0.6.1";
+        node.port = 9000 + i;
+        core.meet(node);
+    }
+
+    // Joins are queued: 2 * ceil(log10(9 + 1)) = 2 transmissions each
+    std::map<node_id_t, int> carried;
+    for (int t = 0; t < 20; ++t) {
+        sent.clear();
+        core.tick();
+        for (const auto &msg: sent) {
+            ASSERT_GE(msg.entries.size(), 1);
+            EXPECT_EQ(msg.entries[0].id, self_node.id);
+            EXPECT_LE(msg.entries.size(), 1 + static_cast<size_t>(config::DEFAULT_MAX_PIGGYBACK_ENTRIES));
+            for (size_t e = 1; e < msg.entries.size(); ++e) {
+                carried[msg.entries[e].id]++;
+            }
+        }
+    }
+    ASSERT_EQ(carried.size(), static_cast<size_t>(cluster));
+    for (const auto &[id, count]: carried) {
+        EXPECT_EQ(count, 2);
+    }
+
+    // Once everything has been sent, pings only carry self
+    sent.clear();
+    core.tick();
+    for (const auto &msg: sent) {
+        EXPECT_EQ(msg.entries.size(), 1);
+    }
+}
+
+TEST_F(GossipCoreTest, DigestSyncSendsOnlyWhatThePeerIsMissing) {
+    std::vector<std::pair<node_id_t, gossip_message>> sent;
+    gossip_core_options options;
+    options.dissemination = dissemination_mode::digest_sync;
+    options.sync_nodes = 0;// Only our own digest rides along
+    gossip_core core(
+            self_node, [&sent](const gossip_message &msg, const node_view &target) { sent.emplace_back(target.id, msg); },
+            mock_event_callback, options);
+
+    node_view peer;
+    peer.id = {{0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 7, 1}};
+    peer.ip = "127.0.7.1";
+    peer.port = 9001;
+    peer.heartbeat = 1;
+    core.meet(peer);
+    peer.status = node_status::online;
+
+    node_view other = peer;
+    other.id[15] = 2;
+    other.port = 9002;
+    other.heartbeat = 10;
+    other.metadata["k"] = "v";
+    node_view unknown = other;
+    unknown.id[15] = 3;
+    unknown.port = 9003;
+
+    auto digest_of = [](const node_view &node) {
+        return node_digest{node.id, node.heartbeat, node.config_epoch, state_hash(node)};
+    };
+    auto receive = [&](message_type type, std::vector<node_view> entries, std::vector<node_digest> digests) {
+        sent.clear();
+        gossip_message msg;
+        msg.sender = peer.id;
+        msg.type = type;
+        msg.timestamp = peer.heartbeat;
+        msg.entries = std::move(entries);
+        msg.digests = std::move(digests);
+        core.handle_message(msg, clock::now());
+    };
+
+    receive(message_type::update, {other}, {});
+
+    // Pings carry digests instead of views
+    sent.clear();
+    core.tick();
+    ASSERT_FALSE(sent.empty());
+    for (const auto &[target, msg]: sent) {
+        EXPECT_TRUE(msg.entries.empty());
+        ASSERT_FALSE(msg.digests.empty());
+        EXPECT_EQ(msg.digests[0].id, self_node.id);
+    }
+
+    // Same state, newer heartbeat: applied from the digest alone
+    other.heartbeat = 20;
+    receive(message_type::ping, {}, {digest_of(peer), digest_of(other)});
+    ASSERT_EQ(sent.size(), 1);
+    EXPECT_EQ(sent[0].second.type, message_type::pong);
+    EXPECT_TRUE(sent[0].second.entries.empty());
+    EXPECT_EQ(sent[0].second.digests.size(), 1);// Only our own
+    EXPECT_EQ(core.find_node(other.id)->heartbeat, 20);
+
+    // Changed state or unknown node: request the views, keep ours meanwhile
+    other.heartbeat = 30;
+    other.metadata["k"] = "v2";
+    receive(message_type::ping, {}, {digest_of(other), digest_of(unknown)});
+    ASSERT_EQ(sent.size(), 1);
+    const auto &requests = sent[0].second.digests;
+    EXPECT_NE(std::find(requests.begin(), requests.end(), node_digest{other.id, 0, 0, 0}), requests.end());
+    EXPECT_NE(std::find(requests.begin(), requests.end(), node_digest{unknown.id, 0, 0, 0}), requests.end());
+    EXPECT_EQ(core.find_node(other.id)->heartbeat, 20);
+    EXPECT_FALSE(core.find_node(unknown.id).has_value());
+
+    // The peer is behind on a changed view: it gets the view
+    node_view stale = other;
+    stale.heartbeat = 5;
+    stale.metadata["k"] = "old";
+    receive(message_type::ping, {}, {digest_of(stale)});
+    ASSERT_EQ(sent.size(), 1);
+    ASSERT_EQ(sent[0].second.entries.size(), 1);
+    EXPECT_EQ(sent[0].second.entries[0].id, other.id);
+    EXPECT_EQ(sent[0].second.entries[0].metadata.at("k"), "v");
+
+    // Requests in a pong are answered with an update, which ends the exchange
+    receive(message_type::pong, {}, {node_digest{other.id, 0, 0, 0}});
+    ASSERT_EQ(sent.size(), 1);
+    EXPECT_EQ(sent[0].second.type, message_type::update);
+    ASSERT_EQ(sent[0].second.entries.size(), 1);
+    EXPECT_TRUE(sent[0].second.digests.empty());
+
+    // Digests in an update (the last leg) are never answered with requests
+    receive(message_type::update, {}, {digest_of(other), digest_of(unknown)});
+    EXPECT_TRUE(sent.empty());
+}
+
+TEST_F(GossipCoreTest, DigestSyncConvergesOnMetadataChanges) {
+    struct envelope {
+        size_t to;
+        gossip_message msg;
+    };
+    std::vector<envelope> queue;
+    std::vector<node_view> views;
+    std::vector<std::unique_ptr<gossip_core>> cores;
+    gossip_core_options options;
+    options.dissemination = dissemination_mode::digest_sync;
+
+    const size_t cluster = 6;
+    for (size_t i = 0; i < cluster; ++i) {
+        node_view view;
+        view.id = {{0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 8, static_cast<uint8_t>(i)}};
+        view.ip = "127.0.8.1";
+        view.port = 9000 + static_cast<int>(i);
+        view.heartbeat = 1;
+        views.push_back(view);
+    }
+    for (size_t i = 0; i < cluster; ++i) {
+        cores.push_back(std::make_unique<gossip_core>(
+                views[i],
+                [&queue](const gossip_message &msg, const node_view &target) {
+                    queue.push_back({static_cast<size_t>(target.port - 9000), msg});
+                },
+                mock_event_callback, options));
+    }
+    // Everyone only knows core 0 at first
+    for (size_t i = 1; i < cluster; ++i) {
+        cores[i]->meet(views[0]);
+    }
+
+    auto run_until = [&](auto &&done) {
+        for (int round = 0; round < 50; ++round) {
+            while (!queue.empty()) {
+                envelope e = std::move(queue.front());
+                queue.erase(queue.begin());
+                cores[e.to]->handle_message(e.msg, clock::now());
+            }
+            if (done()) {
+                return true;
+            }
+            for (auto &core: cores) {
+                core->tick();
+            }
+        }
+        return false;
+    };
+
+    EXPECT_TRUE(run_until([&] {
+        return std::all_of(cores.begin(), cores.end(), [&](const auto &core) { return core->size() == cluster - 1; });
+    }));
+
+    cores[3]->update_self_metadata({{"shard", "7"}});
+    EXPECT_TRUE(run_until([&] {
+        for (size_t i = 0; i < cluster; ++i) {
+            auto view = cores[i]->find_node(views[3].id);
+            if (!view || view->metadata.count("shard") == 0) {
+                return false;
+            }
+        }
+        return true;
+    }));
+}
+
+TEST_F(GossipCoreTest, MerkleAntiEntropyRepairsDivergedMembership) {
+    struct envelope {
+        size_t to;
+        gossip_message msg;
+    };
+    std::vector<envelope> queue;
+    gossip_core_options options;
+    options.gossip_nodes = 0;// No regular gossip: only anti-entropy can repair
+    options.sync_nodes = 0;
+    options.failure_timeout_ms = 600000;
+    options.anti_entropy_interval_ms = 1;
+
+    std::vector<node_view> views(2);
+    std::vector<std::unique_ptr<gossip_core>> cores;
+    for (size_t i = 0; i < 2; ++i) {
+        views[i].id = {{0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 9, static_cast<uint8_t>(i)}};
+        views[i].ip = "127.0.9.1";
+        views[i].port = 9000 + static_cast<int>(i);
+        views[i].heartbeat = 1;
+    }
+    for (size_t i = 0; i < 2; ++i) {
+        cores.push_back(std::make_unique<gossip_core>(
+                views[i],
+                [&queue](const gossip_message &msg, const node_view &target) {
+                    if (target.port < 9002) {// Other members are unreachable
+                        queue.push_back({static_cast<size_t>(target.port - 9000), msg});
+                    }
+                },
+                mock_event_callback, options));
+    }
+    auto deliver = [&] {
+        size_t delivered = 0;
+        while (!queue.empty()) {
+            envelope e = std::move(queue.front());
+            queue.erase(queue.begin());
+            cores[e.to]->handle_message(e.msg, clock::now());
+            ++delivered;
+        }
+        return delivered;
+    };
+    cores[0]->meet(views[1]);
+    deliver();
+
+    // Members that never talk themselves: core 0 knows 0..39, core 1 knows
+    // 20..59, and core 0 has newer views of 20..39
+    auto member = [](int n, uint64_t heartbeat) {
+        node_view node;
+        node.id = {{0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 9, 1, static_cast<uint8_t>(n)}};
+        node.ip = "127.0.9.2";
+        node.port = 10000 + n;
+        node.heartbeat = heartbeat;
+        node.status = node_status::online;
+        node.metadata["gen"] = std::to_string(heartbeat);
+        return node;
+    };
+    gossip_message from_1;
+    from_1.sender = views[1].id;
+    from_1.type = message_type::update;
+    gossip_message from_0 = from_1;
+    from_0.sender = views[0].id;
+    for (int n = 0; n < 60; ++n) {
+        if (n < 40) {
+            from_1.entries.push_back(member(n, n < 20 ? 1 : 2));
+        }
+        if (n >= 20) {
+            from_0.entries.push_back(member(n, 1));
+        }
+    }
+    cores[0]->handle_message(from_1, clock::now());
+    cores[1]->handle_message(from_0, clock::now());
+    ASSERT_EQ(cores[0]->size(), 41);
+    ASSERT_EQ(cores[1]->size(), 41);
+
+    // Sessions go to a random member, so most of them are lost
+    auto converged = [&] {
+        for (auto &core: cores) {
+            auto view = core->find_node(member(30, 1).id);
+            if (core->size() != 61 || !view || view->metadata.at("gen") != "2") {
+                return false;
+            }
+        }
+        return true;
+    };
+    for (int round = 0; round < 2000 && !converged(); ++round) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        for (auto &core: cores) {
+            core->tick();
+        }
+        deliver();
+    }
+
+    EXPECT_EQ(cores[0]->size(), 61);
+    EXPECT_EQ(cores[1]->size(), 61);
+    for (int n = 0; n < 60; ++n) {
+        for (auto &core: cores) {
+            auto view = core->find_node(member(n, 1).id);
+            ASSERT_TRUE(view.has_value()) << n;
+            EXPECT_EQ(view->metadata.at("gen"), n >= 20 && n < 40 ? "2" : "1") << n;
+        }
+    }
+    EXPECT_GT(cores[0]->get_stats().anti_entropy_buckets + cores[1]->get_stats().anti_entropy_buckets, 0);
+
+    // In sync: a session is a single root hash, answered with nothing
+    for (int round = 0; round < 2000 && queue.empty(); ++round) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        cores[0]->tick();
+    }
+    ASSERT_EQ(queue.size(), 1);
+    EXPECT_EQ(queue[0].msg.type, message_type::sync_tree);
+    EXPECT_EQ(queue[0].msg.tree.size(), 1);
+    EXPECT_EQ(deliver(), 1);
+}
+
+TEST_F(GossipCoreTest, SnapshotsAreVersionedAndImmutable) {
+    gossip_core core(self_node, mock_send_callback, mock_event_callback);
+    auto empty = core.snapshot();
+    EXPECT_EQ(empty->size(), 0);
+    EXPECT_EQ(empty->self().id, self_node.id);
+
+    node_view other;
+    other.id = {{0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 2}};
+    other.ip = "127.0.0.2";
+    other.port = 8001;
+    core.meet(other);
+
+    auto met = core.snapshot();
+    EXPECT_GT(met->version(), empty->version());
+    EXPECT_EQ(empty->find(other.id), nullptr);// Held snapshots do not change
+    ASSERT_NE(met->find(other.id), nullptr);
+    EXPECT_EQ(met->find(other.id)->status, node_status::joining);
+
+    // A ping from the node: the next snapshot has it online with its heartbeat
+    gossip_message ping;
+    ping.sender = other.id;
+    ping.type = message_type::ping;
+    ping.timestamp = 5;
+    core.handle_message(ping, clock::now());
+    auto pinged = core.snapshot();
+    EXPECT_EQ(met->find(other.id)->status, node_status::joining);
+    EXPECT_EQ(pinged->find(other.id)->status, node_status::online);
+    EXPECT_EQ(pinged->find(other.id)->heartbeat, 5);
+
+    core.tick();
+    EXPECT_EQ(core.snapshot()->self().heartbeat, core.self().heartbeat);
+}
+
+TEST_F(GossipCoreTest, ReadersDoNotBlockTheReceiveLoop) {
+    gossip_core core(self_node, mock_send_callback, mock_event_callback);
+    const uint32_t members = 64;
+    for (uint32_t n = 0; n < members; ++n) {
+        node_view node;
+        node.id = {{0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 1, static_cast<uint8_t>(n)}};
+        node.ip = "127.0.1.1";
+        node.port = 10000 + static_cast<int>(n);
+        core.meet(node);
+    }
+
+    std::atomic<bool> stop{false};
+    std::atomic<size_t> misses{0};
+    std::vector<std::thread> readers;
+    for (int t = 0; t < 4; ++t) {
+        readers.emplace_back([&core, &stop, &misses, t] {
+            uint32_t n = static_cast<uint32_t>(t);
+            while (!stop.load()) {
+                auto snapshot = core.snapshot();
+                node_id_t id{{0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 1, static_cast<uint8_t>(n++ % members)}};
+                const node_view *node = snapshot->find(id);
+                if (!node || node->id != id || snapshot->size() != members) {
+                    misses++;
+                }
+            }
+        });
+    }
+
+    for (uint64_t round = 1; round <= 2000; ++round) {
+        gossip_message ping;
+        ping.sender = {{0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 1, static_cast<uint8_t>(round % members)}};
+        ping.type = message_type::ping;
+        ping.timestamp = round;
+        core.handle_message(ping, clock::now());
+        if (round % 100 == 0) {
+            core.tick();
+        }
+    }
+    stop = true;
+    for (auto &reader: readers) {
+        reader.join();
+    }
+
+    EXPECT_EQ(misses.load(), 0);
+    node_id_t last{{0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 1, 1999 % members}};// Last pinged in round 1999
+    EXPECT_EQ(core.find_node(last)->heartbeat, 1999);
+}
+
+TEST_F(GossipCoreTest, EventCallbackRunsWithoutTheLock) {
+    std::unique_ptr<gossip_core> core;
+    std::vector<node_status> seen;
+    bool saw_snapshot = false;
+    core = std::make_unique<gossip_core>(
+            self_node, mock_send_callback, [&](const node_view &node, node_status) {
+                // Calls that take the core's mutex would deadlock if it were held
+                seen.push_back(core->suspicion_level(node.id) ? node.status : node_status::unknown);
+                saw_snapshot = saw_snapshot || core->find_node(node.id).has_value();
+                if (seen.size() == 1) {
+                    node_view second;
+                    second.id = {{0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 3}};
+                    second.ip = "127.0.0.3";
+                    second.port = 8002;
+                    core->meet(second);// Re-entrant: delivered after this callback returns
+                    EXPECT_EQ(seen.size(), 1);
+                }
+            });
+
+    node_view other;
+    other.id = {{0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 2}};
+    other.ip = "127.0.0.2";
+    other.port = 8001;
+    core->meet(other);
+
+    EXPECT_EQ(seen, (std::vector<node_status>{node_status::joining, node_status::joining}));
+    EXPECT_TRUE(saw_snapshot);
+    auto stats = core->get_stats();
+    EXPECT_EQ(stats.events_delivered, 2);
+    EXPECT_EQ(stats.event_queue_depth, 0);
+    EXPECT_EQ(stats.events_dropped, 0);
+}
+
+TEST_F(GossipCoreTest, ManualEventDeliveryAndOverflow) {
+    auto meet_ten = [this](event_overflow_policy policy) {
+        gossip_core_options options;
+        options.delivery = event_delivery::manual;
+        options.event_queue_capacity = 4;
+        options.event_overflow = policy;
+        std::vector<int> ports;
+        gossip_core core(
+                self_node, mock_send_callback,
+                [&ports](const node_view &node, node_status) { ports.push_back(node.port); }, options);
+        for (int i = 0; i < 10; ++i) {
+            node_view node;
+            node.id = {{0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 2, static_cast<uint8_t>(i)}};
+            node.ip = "127.0.2.1";
+            node.port = 9000 + i;
+            core.meet(node);
+        }
+        EXPECT_TRUE(ports.empty());// Nothing until dispatch_events()
+        auto stats = core.get_stats();
+        EXPECT_EQ(stats.event_queue_depth, policy == event_overflow_policy::grow ? 10 : 4);
+        EXPECT_EQ(stats.event_queue_peak, stats.event_queue_depth);
+        EXPECT_EQ(stats.events_dropped, policy == event_overflow_policy::grow ? 0 : 6);
+
+        const size_t delivered = core.dispatch_events();
+        EXPECT_EQ(delivered, ports.size());
+        EXPECT_EQ(core.get_stats().event_queue_depth, 0);
+        EXPECT_EQ(core.get_stats().events_delivered, ports.size());
+        return ports;
+    };
+
+    EXPECT_EQ(meet_ten(event_overflow_policy::drop_oldest), (std::vector<int>{9006, 9007, 9008, 9009}));
+    EXPECT_EQ(meet_ten(event_overflow_policy::drop_newest), (std::vector<int>{9000, 9001, 9002, 9003}));
+    EXPECT_EQ(meet_ten(event_overflow_policy::grow).size(), 10);
+}
+
+TEST_F(GossipCoreTest, BatchEventCallbackGetsOneChangePerNode) {
+    size_t single_events = 0;
+    std::vector<std::vector<membership_change>> batches;
+    gossip_core core(self_node, mock_send_callback,
+                     [&single_events](const node_view &, node_status) { single_events++; });
+    core.set_batch_event_callback(
+            [&batches](const std::vector<membership_change> &changes) { batches.push_back(changes); });
+
+    // One message announcing 20 nodes, each listed again with new metadata
+    gossip_message msg;
+    msg.sender = {{0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 3, 0}};
+    msg.type = message_type::ping;
+    msg.timestamp = 1;
+    for (uint64_t heartbeat = 1; heartbeat <= 2; ++heartbeat) {
+        for (int i = 0; i < 20; ++i) {
+            node_view node;
+            node.id = {{0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 3, static_cast<uint8_t>(i)}};
+            node.ip = "127.0.3.1";
+            node.port = 9000 + i;
+            node.status = node_status::online;
+            node.heartbeat = heartbeat;
+            node.metadata["epoch"] = std::to_string(heartbeat);
+            msg.entries.push_back(node);
+        }
+    }
+    core.handle_message(msg, clock::now());
+
+    EXPECT_EQ(single_events, 0);
+    ASSERT_EQ(batches.size(), 1);
+    ASSERT_EQ(batches[0].size(), 20);
+    for (auto &change: batches[0]) {
+        EXPECT_EQ(change.node.metadata.at("epoch"), "2");
+        EXPECT_EQ(change.old_status, node_status::unknown);
+    }
+    auto stats = core.get_stats();
+    EXPECT_EQ(stats.event_batches, 1);
+    EXPECT_GE(stats.events_delivered, 40);
+
+    // Back to per-event delivery
+    core.set_batch_event_callback(nullptr);
+    node_view late;
+    late.id = {{0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 3, 99}};
+    late.ip = "127.0.3.1";
+    late.port = 9099;
+    core.meet(late);
+    EXPECT_EQ(single_events, 1);
+    EXPECT_EQ(batches.size(), 1);
+}
+
+TEST_F(GossipCoreTest, MetadataChangesAreDetectedByStamp) {
+    std::vector<std::string> zones;
+    gossip_core core(self_node, mock_send_callback, [&zones](const node_view &node, node_status) {
+        auto it = node.metadata.find("zone");
+        zones.push_back(it == node.metadata.end() ? "" : it->second);
+    });
+
+    node_view peer;
+    peer.id = {{0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 4, 1}};
+    peer.ip = "127.0.4.1";
+    peer.port = 9400;
+    peer.status = node_status::online;
+    peer.heartbeat = 1;
+    peer.metadata["zone"] = "a";
+    peer.stamp_metadata();
+    EXPECT_EQ(peer.metadata_version, 1);
+    EXPECT_EQ(peer.metadata_hash, hash_metadata(peer.metadata));
+
+    auto receive = [&core, &peer] {
+        gossip_message msg;
+        msg.sender = peer.id;
+        msg.type = message_type::update;
+        msg.timestamp = peer.heartbeat;
+        msg.entries.push_back(peer);
+        core.handle_message(msg, clock::now());
+    };
+    receive();
+    ASSERT_EQ(zones, (std::vector<std::string>{"a"}));
+
+    // Newer heartbeat, same stamp: no metadata event
+    peer.heartbeat = 2;
+    receive();
+    EXPECT_EQ(zones.size(), 1);
+
+    // New stamp
+    peer.heartbeat = 3;
+    peer.metadata["zone"] = "b";
+    peer.stamp_metadata();
+    receive();
+    EXPECT_EQ(zones, (std::vector<std::string>{"a", "b"}));
+    EXPECT_EQ(core.find_node(peer.id)->metadata_version, 2);
+
+    // Untracked views fall back to comparing the maps
+    peer.heartbeat = 4;
+    peer.metadata_version = 0;
+    peer.metadata_hash = 0;
+    receive();
+    EXPECT_EQ(zones.size(), 2);
+    peer.heartbeat = 5;
+    peer.metadata["zone"] = "c";
+    receive();
+    EXPECT_EQ(zones, (std::vector<std::string>{"a", "b", "c"}));
+
+    // Our own metadata is stamped on every update
+    const uint64_t version = core.self().metadata_version;
+    core.update_self_metadata({{"zone", "z"}});
+    EXPECT_EQ(core.self().metadata_version, version + 1);
+    EXPECT_EQ(core.self().metadata_hash, hash_metadata(core.self().metadata));
+}
+
+TEST_F(GossipCoreTest, MetadataDeltasMergeKeyByKey) {
+    node_view owner;
+    std::map<std::string, std::string> keys;
+    for (int k = 0; k < 20; ++k) {
+        keys["key" + std::to_string(k)] = "v0";
+    }
+    EXPECT_TRUE(owner.set_metadata(keys));
+    EXPECT_FALSE(owner.set_metadata({{"key3", "v0"}}));// Same value, no new version
+    EXPECT_EQ(owner.metadata_version, 1);
+
+    node_view replica;
+    EXPECT_EQ(replica.merge_metadata(owner, config::DEFAULT_NODE_METADATA_SIZE_LIMIT), metadata_merge::changed);
+    EXPECT_EQ(replica.metadata, owner.metadata);
+
+    owner.set_metadata({{"key3", "v1"}});
+    owner.set_metadata({{"key7", "v2"}, {"new", "v2"}});
+    ASSERT_EQ(owner.metadata_version, 3);
+    EXPECT_EQ(owner.metadata_hash, hash_metadata(owner.metadata));
+
+    // Only the keys written after version 1 travel, with their versions
+    node_view delta;
+    delta.assign_delta(owner, 1);
+    EXPECT_EQ(delta.metadata_since, 1);
+    EXPECT_EQ(delta.metadata, (std::map<std::string, std::string>{{"key3", "v1"}, {"key7", "v2"}, {"new", "v2"}}));
+    EXPECT_EQ(delta.metadata_versions, (std::vector<uint64_t>{2, 3, 3}));
+    EXPECT_EQ(delta.metadata_hash, owner.metadata_hash);
+    EXPECT_EQ(replica.merge_metadata(delta, config::DEFAULT_NODE_METADATA_SIZE_LIMIT), metadata_merge::changed);
+    EXPECT_EQ(replica.metadata, owner.metadata);
+    EXPECT_EQ(replica.metadata_version, 3);
+    EXPECT_EQ(replica.metadata_key_version(std::distance(replica.metadata.begin(), replica.metadata.find("new"))), 3);
+    EXPECT_EQ(replica.merge_metadata(delta, config::DEFAULT_NODE_METADATA_SIZE_LIMIT), metadata_merge::unchanged);
+
+    // A delta starting after our version cannot be applied
+    owner.set_metadata({{"key1", "v4"}});
+    owner.set_metadata({{"key1", "v5"}});
+    delta.assign_delta(owner, 4);
+    EXPECT_EQ(delta.metadata.size(), 1);
+    EXPECT_EQ(replica.merge_metadata(delta, config::DEFAULT_NODE_METADATA_SIZE_LIMIT), metadata_merge::gap);
+    EXPECT_EQ(replica.metadata_version, 3);
+    delta.assign_delta(owner, 3);
+    EXPECT_EQ(replica.merge_metadata(delta, config::DEFAULT_NODE_METADATA_SIZE_LIMIT), metadata_merge::changed);
+    EXPECT_EQ(replica.metadata, owner.metadata);
+
+    // Over the size limit: not applied, but the version is not asked for again
+    owner.set_metadata({{"blob", std::string(100, 'x')}});
+    delta.assign_delta(owner, 5);
+    const auto before = replica.metadata;
+    EXPECT_EQ(replica.merge_metadata(delta, metadata_bytes(before) + 50), metadata_merge::rejected);
+    EXPECT_EQ(replica.metadata, before);
+    EXPECT_EQ(replica.merge_metadata(delta, metadata_bytes(before) + 50), metadata_merge::unchanged);
+
+    // A delta that would hold every key is the full map
+    node_view small;
+    small.set_metadata({{"a", "1"}});
+    small.set_metadata({{"a", "2"}});
+    delta.assign_delta(small, 1);
+    EXPECT_EQ(delta.metadata_since, 0);
+    EXPECT_EQ(delta.metadata, small.metadata);
+}
+
+TEST_F(GossipCoreTest, MetadataTravelsAsDeltasAndGapsFetchTheFullView) {
+    struct envelope {
+        size_t to;
+        gossip_message msg;
+    };
+    std::vector<envelope> queue;
+    gossip_core_options options;
+    options.failure_timeout_ms = 600000;
+
+    std::vector<node_view> views(2);
+    std::vector<std::unique_ptr<gossip_core>> cores;
+    for (size_t i = 0; i < 2; ++i) {
+        views[i].id = {{0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 7, static_cast<uint8_t>(i)}};
+        views[i].ip = "127.0.7.1";
+        views[i].port = 9700 + static_cast<int>(i);
+        views[i].heartbeat = 1;
+    }
+    for (int k = 0; k < 20; ++k) {
+        views[0].metadata["key" + std::to_string(k)] = "v0";
+    }
+    for (size_t i = 0; i < 2; ++i) {
+        cores.push_back(std::make_unique<gossip_core>(
+                views[i],
+                [&queue](const gossip_message &msg, const node_view &target) {
+                    queue.push_back({static_cast<size_t>(target.port - 9700), msg});
+                },
+                mock_event_callback, options));
+    }
+    auto deliver = [&] {
+        while (!queue.empty()) {
+            envelope e = std::move(queue.front());
+            queue.erase(queue.begin());
+            cores[e.to]->handle_message(e.msg, clock::now());
+        }
+    };
+    auto replica = [&] { return cores[1]->find_node(views[0].id)->metadata; };
+    cores[1]->meet(views[0]);
+    deliver();
+    ASSERT_EQ(replica(), views[0].metadata);
+
+    // One key per change: only the keys of the last metadata_delta_window
+    // versions ride along, never the 20 keys A started with (version 1)
+    for (int n = 0; n < 12; ++n) {
+        ASSERT_TRUE(cores[0]->update_self_metadata({{"key" + std::to_string(n), "v1"}}));
+        cores[0]->tick();
+        ASSERT_FALSE(queue.empty());
+        const node_view &entry = queue[0].msg.entries.at(0);
+        ASSERT_EQ(entry.id, views[0].id);
+        const uint64_t version = cores[0]->self().metadata_version;
+        const uint64_t since = version > options.metadata_delta_window ? version - options.metadata_delta_window : 1;
+        EXPECT_EQ(entry.metadata_since, since);
+        EXPECT_EQ(entry.metadata.size(), version - since);
+        deliver();
+        ASSERT_EQ(replica(), cores[0]->self().metadata) << n;
+    }
+    EXPECT_EQ(cores[1]->get_stats().metadata_requests, 0);
+
+    // Missing more changes than the window covers: the delta does not
+    // apply, and the full view is fetched from the sender
+    for (int n = 0; n < 10; ++n) {
+        cores[0]->update_self_metadata({{"key" + std::to_string(n), "v2"}});
+    }
+    cores[0]->tick();
+    deliver();
+    EXPECT_EQ(replica(), cores[0]->self().metadata);
+    EXPECT_EQ(cores[1]->find_node(views[0].id)->metadata_version, cores[0]->self().metadata_version);
+    EXPECT_EQ(cores[1]->get_stats().metadata_requests, 1);
+}
+
+TEST_F(GossipCoreTest, UnversionedPeersGetFullMetadataMaps) {
+    std::vector<gossip_message> sent;
+    gossip_core_options options;
+    options.failure_timeout_ms = 600000;
+    self_node.metadata = {{"zone", "a"}, {"slots", "0-99"}, {"weight", "3"}};
+    gossip_core core(
+            self_node, [&sent](const gossip_message &msg, const node_view &) { sent.push_back(msg); },
+            mock_event_callback, options);
+
+    // An older release: no metadata_version, and it replaces its copy of our
+    // map with whatever a newer view of us carries
+    node_view old_peer;
+    old_peer.id = {{0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 7, 9}};
+    old_peer.ip = "127.0.7.9";
+    old_peer.port = 9709;
+    old_peer.heartbeat = 1;
+    gossip_message hello;
+    hello.sender = old_peer.id;
+    hello.type = message_type::meet;
+    hello.timestamp = 1;
+    hello.entries.push_back(old_peer);
+    core.handle_message(hello, clock::now());
+    ASSERT_EQ(core.find_node(old_peer.id)->metadata_version, 0);
+
+    std::map<std::string, std::string> old_copy = self_node.metadata;
+    for (int n = 0; n < 3; ++n) {
+        ASSERT_TRUE(core.update_self_metadata({{"weight", std::to_string(4 + n)}}));
+        sent.clear();
+        core.tick();
+        ASSERT_FALSE(sent.empty());
+        const node_view &entry = sent[0].entries.at(0);
+        ASSERT_EQ(entry.id, self_node.id);
+        EXPECT_EQ(entry.metadata_since, 0);// A full map, not a delta
+        old_copy = entry.metadata;
+        EXPECT_EQ(old_copy, core.self().metadata) << n;// No key lost
+    }
+    EXPECT_EQ(old_copy.size(), 3);
+}
+
+TEST_F(GossipCoreTest, MetadataSizeLimitIsEnforced) {
+    gossip_core_options options;
+    options.metadata_size_limit = 64;
+    gossip_core core(self_node, mock_send_callback, mock_event_callback, options);
+
+    EXPECT_TRUE(core.update_self_metadata({{"zone", "a"}}));
+    const uint64_t version = core.self().metadata_version;
+    EXPECT_FALSE(core.update_self_metadata({{"zone", "b"}, {"blob", std::string(64, 'x')}}));
+    EXPECT_EQ(core.self().metadata, (std::map<std::string, std::string>{{"zone", "a"}}));
+    EXPECT_EQ(core.self().metadata_version, version);
+
+    // Remote views over the limit are taken without their metadata
+    node_view peer;
+    peer.id = {{0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 7, 9}};
+    peer.ip = "127.0.7.9";
+    peer.port = 9709;
+    peer.status = node_status::online;
+    peer.heartbeat = 1;
+    peer.metadata["blob"] = std::string(100, 'x');
+    gossip_message msg;
+    msg.sender = peer.id;
+    msg.type = message_type::update;
+    msg.timestamp = 1;
+    msg.entries.push_back(peer);
+    core.handle_message(msg, clock::now());
+    ASSERT_TRUE(core.find_node(peer.id).has_value());
+    EXPECT_TRUE(core.find_node(peer.id)->metadata.empty());
+    EXPECT_EQ(core.get_stats().metadata_rejected, 1);
+
+    msg.entries[0].heartbeat = 2;
+    msg.entries[0].stamp_metadata();
+    core.handle_message(msg, clock::now());
+    EXPECT_TRUE(core.find_node(peer.id)->metadata.empty());
+    EXPECT_EQ(core.get_stats().metadata_rejected, 2);
+}
+
+TEST_F(GossipCoreTest, LeftMembersAreBuriedUntilANewerViewArrives) {
+    std::vector<std::pair<node_id_t, node_status>> events;
+    gossip_core core(self_node, mock_send_callback,
+                     [&events](const node_view &node, node_status old_status) { events.emplace_back(node.id, old_status); });
+
+    auto make_peer = [](uint8_t n) {
+        node_view peer;
+        peer.id = {{0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 8, n}};
+        peer.ip = "127.0.8." + std::to_string(n);
+        peer.port = 9800 + n;
+        peer.status = node_status::online;
+        return peer;
+    };
+    auto send = [&core](message_type type, const node_view &from, const node_view &entry) {
+        gossip_message msg;
+        msg.sender = from.id;
+        msg.type = type;
+        msg.timestamp = from.heartbeat;
+        msg.entries.push_back(entry);
+        core.handle_message(msg, clock::now());
+    };
+
+    node_view peer = make_peer(1);
+    node_view relay = make_peer(2);
+    peer.heartbeat = 5;
+    relay.heartbeat = 5;
+    send(message_type::update, peer, peer);
+    send(message_type::update, relay, relay);
+    ASSERT_EQ(core.size(), 2);
+
+    // Leaving moves it out of the live membership
+    peer.heartbeat = 6;
+    send(message_type::leave, peer, peer);
+    EXPECT_FALSE(core.find_node(peer.id).has_value());
+    ASSERT_TRUE(core.find_tombstone(peer.id).has_value());
+    EXPECT_EQ(core.find_tombstone(peer.id)->status, node_status::failed);
+    EXPECT_EQ(core.size(), 1);
+    EXPECT_EQ(core.get_nodes().size(), 1);
+    EXPECT_EQ(core.get_stats().tombstones, 1);
+
+    // Gossip no newer than the tombstone does not bring it back
+    send(message_type::update, relay, peer);
+    send(message_type::ping, peer, peer);
+    EXPECT_FALSE(core.find_node(peer.id).has_value());
+
+    // A newer view of itself does
+    const size_t before = events.size();
+    peer.heartbeat = 7;
+    send(message_type::ping, peer, peer);
+    ASSERT_TRUE(core.find_node(peer.id).has_value());
+    EXPECT_EQ(core.find_node(peer.id)->status, node_status::online);
+    EXPECT_FALSE(core.find_tombstone(peer.id).has_value());
+    ASSERT_GT(events.size(), before);
+    EXPECT_EQ(events[before], std::make_pair(peer.id, node_status::failed));
+}
+
+TEST_F(GossipCoreTest, DeathsSpreadByGossipInEveryMode) {
+    struct envelope {
+        size_t to;
+        gossip_message msg;
+    };
+    for (auto mode: {dissemination_mode::random_entries, dissemination_mode::broadcast_queue,
+                     dissemination_mode::digest_sync}) {
+        SCOPED_TRACE(static_cast<int>(mode));
+        gossip_core_options options;
+        options.dissemination = mode;
+        options.failure_timeout_ms = 60000;// Nobody detects anything on its own
+        options.indirect_probes = 0;
+
+        std::vector<node_view> views;
+        std::vector<std::unique_ptr<gossip_core>> cores;
+        std::vector<envelope> queue;
+        for (uint8_t i = 0; i < 3; ++i) {
+            node_view view;
+            view.id = {{0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 9, i}};
+            view.ip = "127.0.9.1";
+            view.port = 9900 + i;
+            views.push_back(view);
+        }
+        for (size_t i = 0; i < 3; ++i) {
+            cores.push_back(std::make_unique<gossip_core>(
+                    views[i],
+                    [&queue](const gossip_message &msg, const node_view &target) {
+                        queue.push_back({static_cast<size_t>(target.port - 9900), msg});
+                    },
+                    mock_event_callback, options));
+        }
+        auto deliver = [&] {
+            while (!queue.empty()) {
+                envelope e = std::move(queue.front());
+                queue.erase(queue.begin());
+                if (e.to != 1) {// 1 is gone once it has left
+                    cores[e.to]->handle_message(e.msg, clock::now());
+                }
+            }
+        };
+        for (size_t i = 1; i < 3; ++i) {
+            cores[i]->meet(views[0]);
+        }
+        for (int r = 0; r < 10; ++r) {
+            for (auto &core: cores) {
+                core->tick();
+            }
+            // Node 1 is still up here
+            while (!queue.empty()) {
+                envelope e = std::move(queue.front());
+                queue.erase(queue.begin());
+                cores[e.to]->handle_message(e.msg, clock::now());
+            }
+        }
+        ASSERT_EQ(cores[2]->size(), 2);
+
+        // Node 1 tells only node 0 it is leaving, then goes silent
+        gossip_message leave;
+        leave.sender = views[1].id;
+        leave.type = message_type::leave;
+        leave.timestamp = cores[1]->self().heartbeat;
+        leave.entries.push_back(cores[1]->self());
+        cores[0]->handle_message(leave, clock::now());
+        ASSERT_TRUE(cores[0]->find_tombstone(views[1].id).has_value());
+
+        // Node 2 only ever hears of it from node 0
+        for (int r = 0; r < 5 && cores[2]->find_node(views[1].id); ++r) {
+            cores[0]->tick();
+            cores[2]->tick();
+            deliver();
+        }
+        EXPECT_FALSE(cores[2]->find_node(views[1].id).has_value());
+        ASSERT_TRUE(cores[2]->find_tombstone(views[1].id).has_value());
+        EXPECT_EQ(cores[2]->find_tombstone(views[1].id)->status, node_status::failed);
+    }
+}
+
+TEST_F(GossipCoreTest, AdaptiveFanoutFollowsClusterSize) {
+    std::vector<size_t> ping_entries;
+    gossip_core_options options;
+    options.adaptive_fanout = true;
+    options.indirect_probes = 0;
+    gossip_core core(
+            self_node,
+            [&ping_entries](const gossip_message &msg, const node_view &) {
+                if (msg.type == message_type::ping) {
+                    ping_entries.push_back(msg.entries.size());
+                }
+            },
+            mock_event_callback, options);
+
+    // Small clusters keep the configured values as a floor
+    EXPECT_EQ(core.get_stats().gossip_nodes, 3);
+    EXPECT_EQ(core.get_stats().sync_nodes, 2);
+
+    gossip_message msg;
+    msg.sender = self_node.id;
+    msg.type = message_type::update;
+    for (uint32_t i = 0; i < 150; ++i) {
+        node_view node;
+        node.id = {{0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 5, 0, 0, static_cast<uint8_t>(i >> 8), static_cast<uint8_t>(i)}};
+        node.ip = "127.0.5.1";
+        node.port = static_cast<int>(10000 + i);
+        node.heartbeat = 1;
+        node.status = node_status::online;
+        msg.entries.push_back(node);
+    }
+    core.handle_message(msg, clock::now());
+    ASSERT_EQ(core.size(), 150);
+
+    // ceil(ln(151)) = 6 pings per tick, each with self and 6 entries
+    EXPECT_EQ(core.get_stats().gossip_nodes, 6);
+    EXPECT_EQ(core.get_stats().sync_nodes, 6);
+    core.tick();
+    EXPECT_EQ(ping_entries, std::vector<size_t>(6, 7));
+
+    // Members that leave shrink it again
+    for (uint32_t i = 0; i < 140; ++i) {
+        core.leave(msg.entries[i].id);
+    }
+    EXPECT_EQ(core.size(), 10);
+    EXPECT_EQ(core.get_stats().gossip_nodes, 3);
+    EXPECT_EQ(core.get_stats().sync_nodes, 3);
+}
+
+TEST_F(GossipCoreTest, AdaptiveFanoutStaysWithinTheTickBudget) {
+    gossip_core_options options;
+    options.adaptive_fanout = true;
+    // Six pings of self + 6 views do not fit; six of self + 1 view do
+    options.tick_budget_bytes = 6 * (config::ESTIMATED_MESSAGE_BYTES + 2 * config::ESTIMATED_VIEW_BYTES);
+    gossip_core core(self_node, mock_send_callback, mock_event_callback, options);
+
+    gossip_message msg;
+    msg.sender = self_node.id;
+    msg.type = message_type::update;
+    for (uint32_t i = 0; i < 150; ++i) {
+        node_view node;
+        node.id = {{0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 6, 0, 0, static_cast<uint8_t>(i >> 8), static_cast<uint8_t>(i)}};
+        node.ip = "127.0.6.1";
+        node.port = static_cast<int>(10000 + i);
+        node.heartbeat = 1;
+        node.status = node_status::online;
+        msg.entries.push_back(node);
+    }
+    core.handle_message(msg, clock::now());
+    EXPECT_EQ(core.get_stats().gossip_nodes, 6);
+    EXPECT_EQ(core.get_stats().sync_nodes, 1);
+
+    // Heavier views cost pings once the entries are down to one
+    ASSERT_TRUE(core.update_self_metadata({{"blob", std::string(config::ESTIMATED_VIEW_BYTES, 'x')}}));
+    EXPECT_EQ(core.get_stats().sync_nodes, 1);
+    EXPECT_LT(core.get_stats().gossip_nodes, 6);
+    EXPECT_GE(core.get_stats().gossip_nodes, 1);
+}
+
+TEST_F(GossipCoreTest, RegionAwareSelectionPrefersOurRegion) {
+    node_view self = self_node;
+    self.region = "eu-west-1";
+    size_t local_pings = 0;
+    size_t remote_pings = 0;
+    std::vector<node_id_t> tick_targets;
+    bool distinct = true;
+    gossip_core_options options;
+    options.region_aware = true;
+    options.cross_region_fraction = 0.1;
+    options.indirect_probes = 0;
+    gossip_core core(
+            self,
+            [&](const gossip_message &msg, const node_view &target) {
+                if (msg.type != message_type::ping) {
+                    return;
+                }
+                (target.region == self.region ? local_pings : remote_pings)++;
+                if (std::find(tick_targets.begin(), tick_targets.end(), target.id) != tick_targets.end()) {
+                    distinct = false;
+                }
+                tick_targets.push_back(target.id);
+            },
+            mock_event_callback, options);
+
+    // As many members in our region as in the others
+    gossip_message msg;
+    msg.sender = self.id;
+    msg.type = message_type::update;
+    for (uint32_t i = 0; i < 200; ++i) {
+        node_view node;
+        node.id = {{0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 7, 0, 0, 0, static_cast<uint8_t>(i)}};
+        node.ip = "127.0.7.1";
+        node.port = static_cast<int>(10000 + i);
+        node.heartbeat = 1;
+        node.status = node_status::online;
+        node.region = i % 2 == 0 ? "eu-west-1" : (i % 4 == 1 ? "us-east-1" : "ap-south-1");
+        msg.entries.push_back(node);
+    }
+    core.handle_message(msg, clock::now());
+    ASSERT_EQ(core.size(), 200);
+
+    for (int round = 0; round < 300; ++round) {
+        tick_targets.clear();
+        core.tick();
+        EXPECT_EQ(tick_targets.size(), 3);
+    }
+    EXPECT_TRUE(distinct);
+    const double remote_share = static_cast<double>(remote_pings) / static_cast<double>(local_pings + remote_pings);
+    EXPECT_GT(remote_share, 0.05);
+    EXPECT_LT(remote_share, 0.15);
+}
+
+TEST_F(GossipCoreTest, RegionAwareSelectionFallsBackToOtherRegions) {
+    node_view self = self_node;
+    self.region = "eu-west-1";
+    std::vector<node_view> targets;
+    gossip_core_options options;
+    options.region_aware = true;
+    options.cross_region_fraction = 0.0;
+    options.indirect_probes = 0;
+    gossip_core core(
+            self,
+            [&targets](const gossip_message &msg, const node_view &target) {
+                if (msg.type == message_type::ping) {
+                    targets.push_back(target);
+                }
+            },
+            mock_event_callback, options);
+
+    gossip_message msg;
+    msg.sender = self.id;
+    msg.type = message_type::update;
+    for (uint32_t i = 0; i < 5; ++i) {
+        node_view node;
+        node.id = {{0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 8, 0, 0, 0, static_cast<uint8_t>(i)}};
+        node.ip = "127.0.8.1";
+        node.port = static_cast<int>(10000 + i);
+        node.heartbeat = 1;
+        node.status = node_status::online;
+        node.region = i == 0 ? "eu-west-1" : "us-east-1";
+        msg.entries.push_back(node);
+    }
+    core.handle_message(msg, clock::now());
+
+    // One member in our region: the other two pings go cross-region
+    core.tick();
+    ASSERT_EQ(targets.size(), 3);
+    EXPECT_EQ(std::count_if(targets.begin(), targets.end(),
+                            [&self](const node_view &n) { return n.region == self.region; }),
+              1);
+
+    // A member that moves into our region is picked as a local one
+    msg.entries.resize(2);
+    msg.entries[1].heartbeat = 2;
+    msg.entries[1].region = "eu-west-1";
+    msg.entries[0].heartbeat = 2;
+    core.handle_message(msg, clock::now());
+    for (int round = 0; round < 20; ++round) {
+        targets.clear();
+        core.tick();
+        ASSERT_EQ(targets.size(), 3);
+        EXPECT_EQ(std::count_if(targets.begin(), targets.end(),
+                                [&self](const node_view &n) { return n.region == self.region; }),
+                  2);
+    }
+}
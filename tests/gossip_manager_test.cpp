@@ -113,6 +113,22 @@ TEST_F(GossipManagerTest, GetStats) {
     EXPECT_EQ(stats.known_nodes, 0);
     EXPECT_EQ(stats.sent_messages, 0);
     EXPECT_EQ(stats.received_messages, 0);
+    EXPECT_EQ(stats.frames_sent, 0);
+    EXPECT_EQ(stats.datagrams_sent, 0);
+
+    manager.stop();
+}
+
+TEST_F(GossipManagerTest, StatsCountTransportSends) {
+    config.udp_coalesce_window_us = 0;
+    gossip_manager manager;
+    ASSERT_TRUE(manager.init(config));
+    ASSERT_TRUE(manager.start());
+
+    ASSERT_TRUE(manager.meet_node("127.0.0.1", 17947));// Nobody listens: UDP sends anyway
+    auto stats = manager.get_stats();
+    EXPECT_EQ(stats.frames_sent, 1);
+    EXPECT_EQ(stats.datagrams_sent, 1);
 
     manager.stop();
 }
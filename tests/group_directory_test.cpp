@@ -0,0 +1,244 @@
+#include "core/gossip_core.hpp"
+#include "core/group_directory.hpp"
+#include <chrono>
+#include <deque>
+#include <gtest/gtest.h>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace libgossip;
+
+namespace {
+
+    group_summary make_summary(const std::string &group, uint8_t representative, uint64_t term, uint64_t version) {
+        group_summary summary;
+        summary.group = group;
+        summary.representative.id[15] = representative;
+        summary.term = term;
+        summary.version = version;
+        summary.members = 1;
+        return summary;
+    }
+
+    // Three groups of four cores, messages delivered in memory after every tick
+    class hierarchical_cluster {
+    public:
+        static constexpr uint8_t members = 12;
+        static constexpr uint8_t group_size = 4;
+
+        explicit hierarchical_cluster(const gossip_core_options &options) {
+            const char *regions[] = {"us-east-1", "eu-west-1", "ap-south-1"};
+            for (uint8_t i = 0; i < members; ++i) {
+                node_view self;
+                self.id[15] = i + 1;// Group g's lowest ID is member g * group_size
+                self.ip = "127.0.9." + std::to_string(i + 1);
+                self.port = 9000;
+                self.region = regions[i / group_size];
+                self.role = i == 0 ? "replica" : "master";
+                cores_.push_back(std::make_unique<gossip_core>(
+                        self,
+                        [this](const gossip_message &msg, const node_view &target) {
+                            queue_.push_back({static_cast<uint8_t>(target.id[15] - 1), msg});
+                        },
+                        nullptr, options));
+            }
+            // Every member meets the first of its group, the first of each group meets member 0
+            for (uint8_t i = 0; i < members; ++i) {
+                const uint8_t first = i / group_size * group_size;
+                if (i != first) {
+                    cores_[i]->meet(cores_[first]->self());
+                } else if (i != 0) {
+                    cores_[i]->meet(cores_[0]->self());
+                }
+            }
+            deliver();
+        }
+
+        void round() {
+            for (uint8_t i = 0; i < members; ++i) {
+                if (!down_[i]) {
+                    cores_[i]->tick();
+                }
+            }
+            deliver();
+        }
+
+        void crash(uint8_t i) { down_[i] = true; }
+
+        gossip_core &core(uint8_t i) { return *cores_[i]; }
+
+    private:
+        struct letter {
+            uint8_t to;
+            gossip_message msg;
+        };
+
+        void deliver() {
+            while (!queue_.empty()) {
+                letter l = std::move(queue_.front());
+                queue_.pop_front();
+                if (l.to < members && !down_[l.to]) {
+                    cores_[l.to]->handle_message(l.msg, clock::now());
+                }
+            }
+        }
+
+        std::vector<std::unique_ptr<gossip_core>> cores_;
+        std::deque<letter> queue_;
+        bool down_[members] = {};
+    };
+
+    const group_summary *find_group(const std::vector<group_summary> &groups, const std::string &group) {
+        for (const auto &summary: groups) {
+            if (summary.group == group) {
+                return &summary;
+            }
+        }
+        return nullptr;
+    }
+
+}// namespace
+
+TEST(GroupDirectoryTest, NewerTermThenVersionWins) {
+    group_directory directory;
+    EXPECT_TRUE(directory.merge(make_summary("eu", 1, 1, 5)));
+    EXPECT_FALSE(directory.merge(make_summary("eu", 2, 1, 5)));// Same order
+    EXPECT_FALSE(directory.merge(make_summary("eu", 2, 1, 4)));
+    EXPECT_TRUE(directory.merge(make_summary("eu", 1, 1, 6)));
+    EXPECT_TRUE(directory.merge(make_summary("eu", 2, 2, 1)));// New representative, new term
+    EXPECT_FALSE(directory.merge(make_summary("eu", 1, 1, 9)));
+    EXPECT_TRUE(directory.merge(make_summary("us", 3, 0, 0)));
+
+    ASSERT_EQ(directory.size(), 2);
+    const group_summary *eu = directory.find(interned_string("eu"));
+    ASSERT_NE(eu, nullptr);
+    EXPECT_EQ(eu->representative.id[15], 2);
+    EXPECT_EQ(eu->term, 2);
+    EXPECT_EQ(directory.find(interned_string("ap")), nullptr);
+}
+
+TEST(GroupDirectoryTest, ChangesArePiggybackedAFewTimes) {
+    group_directory directory;
+    directory.merge(make_summary("eu", 1, 1, 1));
+    directory.merge(make_summary("us", 2, 1, 1));
+
+    std::vector<group_summary> out;
+    directory.take(1, 2, out);
+    directory.take(1, 2, out);
+    directory.take(1, 2, out);
+    ASSERT_EQ(out.size(), 3);
+    EXPECT_EQ(out[0].group, "eu");
+    EXPECT_EQ(out[1].group, "eu");
+    EXPECT_EQ(out[2].group, "us");
+
+    out.clear();
+    directory.take(8, 2, out);
+    EXPECT_EQ(out.size(), 1);// us once more, eu is done
+    out.clear();
+    directory.take(8, 2, out);
+    EXPECT_TRUE(out.empty());
+
+    directory.merge(make_summary("eu", 1, 1, 2));// Changed: sent again
+    directory.take(8, 2, out);
+    ASSERT_EQ(out.size(), 1);
+    EXPECT_EQ(out[0].version, 2);
+
+    out.clear();
+    directory.append_all(out);
+    EXPECT_EQ(out.size(), 2);
+}
+
+TEST(GroupDirectoryTest, RotateCyclesThroughEveryGroup) {
+    group_directory directory;
+    for (uint8_t g = 0; g < 5; ++g) {
+        directory.merge(make_summary("g" + std::to_string(g), g, 1, 1));
+    }
+
+    std::vector<group_summary> out;
+    out.push_back(make_summary("g0", 0, 1, 1));// Already carried: skipped
+    directory.rotate(2, out);
+    ASSERT_EQ(out.size(), 3);
+    EXPECT_EQ(out[1].group, "g1");
+    EXPECT_EQ(out[2].group, "g2");
+
+    out.clear();
+    directory.rotate(4, out);
+    ASSERT_EQ(out.size(), 4);
+    EXPECT_EQ(out[0].group, "g3");
+    EXPECT_EQ(out[3].group, "g1");// Wrapped around
+
+    out.clear();
+    directory.rotate(9, out);
+    EXPECT_EQ(out.size(), 5);// Each group once
+}
+
+TEST(HierarchicalGossipTest, MembersHoldTheirGroupAndSummariesOfTheOthers) {
+    gossip_core_options options;
+    options.hierarchical = true;
+    options.representative_role = "master";
+    options.indirect_probes = 0;
+    hierarchical_cluster cluster(options);
+    for (int r = 0; r < 30; ++r) {
+        cluster.round();
+    }
+
+    for (uint8_t i = 0; i < hierarchical_cluster::members; ++i) {
+        gossip_core &core = cluster.core(i);
+        EXPECT_EQ(core.size(), hierarchical_cluster::group_size - 1) << "member " << int(i);
+        for (const auto &node: core.get_nodes()) {
+            EXPECT_EQ(node.region, core.self().region);
+        }
+
+        const auto groups = core.get_groups();
+        ASSERT_EQ(groups.size(), 3) << "member " << int(i);
+        // Member 0 is a replica, so member 1 represents the first group
+        const uint8_t expected[] = {2, 5, 9};
+        const char *regions[] = {"us-east-1", "eu-west-1", "ap-south-1"};
+        for (int g = 0; g < 3; ++g) {
+            const group_summary *summary = find_group(groups, regions[g]);
+            ASSERT_NE(summary, nullptr);
+            EXPECT_EQ(summary->representative.id[15], expected[g]) << "member " << int(i) << ", group " << g;
+            EXPECT_EQ(summary->members, hierarchical_cluster::group_size);
+            EXPECT_GE(summary->term, 1);
+        }
+        EXPECT_EQ(core.get_stats().representative, i == 1 || i == 4 || i == 8);
+        EXPECT_EQ(core.get_stats().groups, 3);
+    }
+}
+
+TEST(HierarchicalGossipTest, ANewRepresentativeTakesOverWhenTheOldOneDies) {
+    gossip_core_options options;
+    options.hierarchical = true;
+    options.indirect_probes = 0;
+    options.heartbeat_interval_ms = 10;
+    options.failure_timeout_ms = 100;
+    hierarchical_cluster cluster(options);
+    for (int r = 0; r < 30; ++r) {
+        cluster.round();
+    }
+    const auto old_groups = cluster.core(0).get_groups();
+    const group_summary *old_eu = find_group(old_groups, "eu-west-1");
+    ASSERT_NE(old_eu, nullptr);
+    ASSERT_EQ(old_eu->representative.id[15], 5);
+
+    // Member 4 represents eu-west-1; its group notices it is gone and member 5 takes over
+    cluster.crash(4);
+    bool failed_over = false;
+    for (int r = 0; r < 300 && !failed_over; ++r) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+        cluster.round();
+        failed_over = true;
+        for (uint8_t i = 0; i < hierarchical_cluster::members; ++i) {
+            if (i == 4) {
+                continue;
+            }
+            const auto groups = cluster.core(i).get_groups();
+            const group_summary *eu = find_group(groups, "eu-west-1");
+            failed_over &= eu && eu->representative.id[15] == 6 && eu->term > old_eu->term;
+        }
+    }
+    EXPECT_TRUE(failed_over);
+    EXPECT_TRUE(cluster.core(5).get_stats().representative);
+}
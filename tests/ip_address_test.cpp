@@ -0,0 +1,132 @@
+#include "core/node_view.hpp"
+#include <gtest/gtest.h>
+#include <string>
+
+using namespace libgossip;
+
+TEST(InternedStringTest, EqualStringsShareOneEntry) {
+    interned_string a = std::string("us-east-1");
+    interned_string b = "us-east-1";
+    interned_string c = "eu-west-1";
+    EXPECT_EQ(a, b);
+    EXPECT_EQ(a.c_str(), b.c_str());// Same pool entry
+    EXPECT_NE(a, c);
+
+    const size_t pooled = interned_string::pool_size();
+    interned_string again = std::string("eu-west-1");
+    EXPECT_EQ(interned_string::pool_size(), pooled);
+    EXPECT_EQ(again, c);
+}
+
+TEST(InternedStringTest, BehavesLikeAString) {
+    interned_string role;
+    EXPECT_TRUE(role.empty());
+    EXPECT_EQ(role, "");
+    EXPECT_EQ(role, interned_string(""));
+
+    role = "master";
+    EXPECT_EQ(role, "master");
+    EXPECT_EQ("master", role);
+    EXPECT_EQ(role, std::string("master"));
+    EXPECT_NE(role, "replica");
+    EXPECT_EQ(role.size(), 6);
+
+    std::string copy = role;
+    EXPECT_EQ(copy, "master");
+    std::ostringstream os;
+    os << role;
+    EXPECT_EQ(os.str(), "master");
+}
+
+TEST(InternedStringTest, ValuesPastThePoolLimitAreNotInterned) {
+    interned_string region = "limit-region";
+    const size_t limit = interned_string::pool_limit();
+    interned_string::set_pool_limit(interned_string::pool_size());
+
+    const size_t pooled = interned_string::pool_size();
+    interned_string a = "limit-unpooled";
+    interned_string b = std::string("limit-unpooled");
+    interned_string again = "limit-region";
+    EXPECT_EQ(interned_string::pool_size(), pooled);
+    EXPECT_FALSE(a.interned());
+    EXPECT_TRUE(again.interned());// Already pooled values still are
+    EXPECT_EQ(again.c_str(), region.c_str());
+
+    EXPECT_EQ(a, b);
+    EXPECT_EQ(a, "limit-unpooled");
+    EXPECT_NE(a, region);
+    EXPECT_NE(a.c_str(), b.c_str());
+
+    interned_string copy = a;
+    a = region;
+    EXPECT_EQ(copy, "limit-unpooled");
+    EXPECT_EQ(a, region);
+    b = std::move(copy);
+    EXPECT_EQ(b, "limit-unpooled");
+
+    ip_address host = "limit-host.local";
+    ip_address host_copy = host;
+    EXPECT_EQ(host_copy, ip_address("limit-host.local"));
+    EXPECT_EQ(host_copy.host(), "limit-host.local");
+    host_copy = "10.0.0.1";
+    EXPECT_EQ(host_copy, "10.0.0.1");
+    host_copy = host;
+    EXPECT_EQ(host_copy, host);
+
+    interned_string::set_pool_limit(limit);
+    EXPECT_TRUE(interned_string("limit-unpooled").interned());
+}
+
+TEST(IpAddressTest, LiteralsAreBinary) {
+    ip_address v4 = "10.0.0.1";
+    EXPECT_EQ(v4.type(), ip_address::kind::v4);
+    EXPECT_EQ(v4.str(), "10.0.0.1");
+    EXPECT_EQ(v4, "10.0.0.1");
+    EXPECT_EQ(v4, ip_address(std::string("10.0.0.1")));
+    EXPECT_NE(v4, ip_address("10.0.0.2"));
+
+    ip_address v6 = "fe80::1:2";
+    EXPECT_EQ(v6.type(), ip_address::kind::v6);
+    EXPECT_EQ(v6.str(), "fe80::1:2");
+    EXPECT_EQ(v6, ip_address("fe80:0:0:0:0:0:1:2"));
+
+    // Canonical forms
+    EXPECT_EQ(ip_address("0:0:0:0:0:0:0:1").str(), "::1");
+    EXPECT_EQ(ip_address("::").str(), "::");
+    EXPECT_EQ(ip_address("2001:DB8:0:0:1:0:0:1").str(), "2001:db8::1:0:0:1");
+    EXPECT_EQ(ip_address("1:0:0:2:0:0:0:3").str(), "1:0:0:2::3");
+    EXPECT_EQ(ip_address("1:2:3:4:5:6:7:8").str(), "1:2:3:4:5:6:7:8");
+    EXPECT_EQ(ip_address("1:0:2:3:4:5:6:7").str(), "1:0:2:3:4:5:6:7");
+    EXPECT_EQ(ip_address("::ffff:10.0.0.1").str(), "::ffff:10.0.0.1");
+    EXPECT_EQ(ip_address("::ffff:10.0.0.1").bytes(), v4.bytes());
+}
+
+TEST(IpAddressTest, HostNamesAreInterned) {
+    ip_address host = "node-a.local";
+    EXPECT_EQ(host.type(), ip_address::kind::host);
+    EXPECT_EQ(host.str(), "node-a.local");
+    EXPECT_EQ(host.host(), "node-a.local");
+    EXPECT_EQ(host, ip_address("node-a.local"));
+    EXPECT_NE(host, ip_address("node-b.local"));
+    EXPECT_EQ(ip_address("10.0.0.256").str(), "10.0.0.256");
+    EXPECT_EQ(ip_address("1:2").type(), ip_address::kind::host);
+
+    ip_address empty;
+    EXPECT_TRUE(empty.empty());
+    EXPECT_EQ(empty.str(), "");
+    EXPECT_EQ(ip_address(""), empty);
+}
+
+TEST(IpAddressTest, NodeViewFieldsAreCompact) {
+    EXPECT_LE(sizeof(ip_address), 17);
+    EXPECT_EQ(sizeof(interned_string), sizeof(void *));
+
+    node_view node;
+    node.ip = "127.0.0.1";
+    node.role = "replica";
+    node.region = std::string("ap-south-1");
+    node_view copy = node;
+    EXPECT_EQ(copy, node);
+    EXPECT_EQ(copy.ip, "127.0.0.1");
+    EXPECT_EQ(copy.role.c_str(), node.role.c_str());
+}
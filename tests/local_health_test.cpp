@@ -0,0 +1,123 @@
+#include "core/gossip_core.hpp"
+#include "core/local_health.hpp"
+#include <gtest/gtest.h>
+#include <thread>
+#include <vector>
+
+using namespace libgossip;
+
+namespace {
+
+    const duration_ms interval(100);
+
+}// namespace
+
+TEST(LocalHealthTest, DisabledStaysHealthy) {
+    local_health health;
+    const time_point t0 = clock::now();
+    health.tick(t0, interval);
+    health.tick(t0 + std::chrono::seconds(5), interval);
+    health.probe_sent({1, 0}, t0);
+    health.expire_probes(t0 + std::chrono::seconds(5), interval);
+    health.receive_lag(std::chrono::seconds(1), interval);
+    EXPECT_FALSE(health.enabled());
+    EXPECT_EQ(health.score(), 0);
+    EXPECT_EQ(health.scale(interval), interval);
+}
+
+TEST(LocalHealthTest, MissedTicksRaiseTheScore) {
+    local_health health(8);
+    const time_point t0 = clock::now();
+    health.tick(t0, interval);
+    health.tick(t0 + duration_ms(150), interval);// Late, but not a whole interval
+    EXPECT_EQ(health.score(), 0);
+
+    health.tick(t0 + duration_ms(150 + 350), interval);// Three intervals missed
+    EXPECT_EQ(health.score(), 2);
+    EXPECT_EQ(health.multiplier(), 3);
+    EXPECT_EQ(health.scale(duration_ms(2000)), duration_ms(6000));
+
+    health.tick(t0 + std::chrono::seconds(60), interval);
+    EXPECT_EQ(health.score(), 8);// Capped
+}
+
+TEST(LocalHealthTest, AcksOnTimeLowerLateAndMissingRaise) {
+    local_health health(8);
+    const time_point t0 = clock::now();
+    health.probe_sent({1, 0}, t0);
+    health.probe_sent({2, 0}, t0);
+    health.probe_sent({3, 0}, t0);
+
+    health.ack_received({1, 0}, t0 + duration_ms(300), interval);// Late
+    EXPECT_EQ(health.score(), 1);
+    health.ack_received({1, 0}, t0 + duration_ms(300), interval);// Already counted
+    health.ack_received({9, 0}, t0, interval);                   // Never pinged
+    EXPECT_EQ(health.score(), 1);
+
+    health.expire_probes(t0 + duration_ms(50), interval);
+    EXPECT_EQ(health.score(), 1);
+    health.expire_probes(t0 + duration_ms(200), interval);// 2 and 3 unanswered
+    EXPECT_EQ(health.score(), 3);
+
+    health.probe_sent({2, 0}, t0 + duration_ms(200));
+    health.ack_received({2, 0}, t0 + duration_ms(210), interval);
+    EXPECT_EQ(health.score(), 2);
+}
+
+TEST(LocalHealthTest, ReceiveBacklogCountsOncePerTick) {
+    local_health health(8);
+    health.receive_lag(duration_ms(10), interval);
+    EXPECT_EQ(health.score(), 0);
+    health.receive_lag(duration_ms(400), interval);
+    health.receive_lag(duration_ms(400), interval);
+    EXPECT_EQ(health.score(), 1);
+
+    health.tick(clock::now(), interval);
+    health.receive_lag(duration_ms(400), interval);
+    EXPECT_EQ(health.score(), 2);
+
+    health.clear();
+    EXPECT_EQ(health.score(), 0);
+}
+
+TEST(LocalHealthTest, StalledCoreDoesNotSuspectItsPeers) {
+    // A core that stalls past the failure timeout blames its quiet peer,
+    // unless local health notices the stall first
+    for (uint32_t max_score: {0u, 8u}) {
+        node_view self;
+        self.id = {{0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 7, 1}};
+        self.ip = "127.0.7.1";
+        self.port = 9000;
+
+        gossip_core_options options;
+        options.heartbeat_interval_ms = 20;
+        options.failure_timeout_ms = 100;
+        options.indirect_probes = 0;
+        options.local_health_max = max_score;
+        gossip_core core(self, [](const gossip_message &, const node_view &) {}, nullptr, options);
+
+        node_view peer;
+        peer.id = {{0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 7, 2}};
+        peer.ip = "127.0.7.2";
+        peer.port = 9000;
+        peer.heartbeat = 1;
+        peer.status = node_status::online;
+        gossip_message hello;
+        hello.sender = peer.id;
+        hello.type = message_type::update;
+        hello.entries.push_back(peer);
+        core.handle_message(hello, clock::now());
+        core.tick();
+
+        std::this_thread::sleep_for(std::chrono::milliseconds(250));
+        core.tick();
+
+        if (max_score == 0) {
+            EXPECT_EQ(core.find_node(peer.id)->status, node_status::suspect);
+            EXPECT_EQ(core.get_stats().local_health, 0);
+        } else {
+            EXPECT_EQ(core.find_node(peer.id)->status, node_status::online);
+            EXPECT_EQ(core.get_stats().local_health, 8);
+        }
+    }
+}
@@ -0,0 +1,203 @@
+#include "core/eviction_index.hpp"
+#include "core/gossip_core.hpp"
+#include <gtest/gtest.h>
+#include <string>
+#include <vector>
+
+using namespace libgossip;
+
+namespace {
+
+    node_id_t make_id(uint32_t n) {
+        node_id_t id{};
+        id[0] = 0xca;
+        id[12] = static_cast<uint8_t>(n >> 24);
+        id[13] = static_cast<uint8_t>(n >> 16);
+        id[14] = static_cast<uint8_t>(n >> 8);
+        id[15] = static_cast<uint8_t>(n);
+        return id;
+    }
+
+    node_view make_member(uint32_t n, node_status status, const std::string &region = "") {
+        node_view node;
+        node.id = make_id(n);
+        // Distinct addresses: a new id at a known address replaces that member
+        node.ip = "10." + std::to_string((n >> 16) & 0xFF) + "." + std::to_string((n >> 8) & 0xFF) + "." +
+                  std::to_string(n & 0xFF);
+        node.port = 7946;
+        node.heartbeat = 1;
+        node.status = status;
+        node.region = region;
+        return node;
+    }
+
+    // One message from an already known member carrying the given entries
+    void receive(gossip_core &core, const node_id_t &sender, const std::vector<node_view> &entries) {
+        gossip_message msg;
+        msg.sender = sender;
+        msg.type = message_type::update;
+        msg.timestamp = 1;
+        msg.entries = entries;
+        core.handle_message(msg, clock::now());
+    }
+
+    void no_send(const gossip_message &, const node_view &) {}
+
+}// namespace
+
+TEST(EvictionIndexTest, LowestClassLeastRecentlyTouchedFirst) {
+    eviction_index index(3);
+    EXPECT_FALSE(index.victim(3).valid());
+
+    index.touch({0, 1}, 2);
+    index.touch({1, 1}, 1);
+    index.touch({2, 1}, 1);
+    index.touch({3, 1}, 0);
+    EXPECT_EQ(index.victim(3), (node_handle{3, 1}));
+    EXPECT_EQ(index.victim(0), node_handle{});// Nothing below class 0
+
+    index.remove(3);
+    EXPECT_EQ(index.victim(3), (node_handle{1, 1}));
+    index.touch({1, 1}, 1);// Now the most recent of class 1
+    EXPECT_EQ(index.victim(3), (node_handle{2, 1}));
+    EXPECT_EQ(index.victim(3, {2, 1}), (node_handle{1, 1}));// Pinned is skipped
+    EXPECT_EQ(index.victim(1), node_handle{});
+
+    index.touch({2, 1}, 2);// Changes class
+    EXPECT_EQ(index.class_of(2), 2);
+    EXPECT_EQ(index.size(1), 1);
+    EXPECT_EQ(index.size(2), 2);
+    EXPECT_EQ(index.victim(3), (node_handle{1, 1}));
+
+    index.clear();
+    EXPECT_FALSE(index.victim(3).valid());
+    EXPECT_EQ(index.class_of(0), index.classes());
+}
+
+TEST(MembershipCapacityTest, FloodOfFakeMembersStaysBounded) {
+    gossip_core_options options;
+    options.max_nodes = 100;
+    options.failure_timeout_ms = 600000;
+    gossip_core core(make_member(0xFFFFFF, node_status::online), no_send, nullptr, options);
+
+    // 50 real members, one of which relays the flood
+    std::vector<node_view> real;
+    for (uint32_t n = 0; n < 50; ++n) {
+        real.push_back(make_member(n, node_status::online));
+    }
+    core.meet(real[0]);
+    receive(core, real[0].id, real);
+    ASSERT_EQ(core.size(), 50);
+
+    // 100k made-up live members, in messages of 20 entries
+    const uint32_t fakes = 100000;
+    std::vector<node_view> batch;
+    for (uint32_t n = 0; n < fakes; ++n) {
+        batch.push_back(make_member(1000000 + n, node_status::online));
+        if (batch.size() == 20) {
+            receive(core, real[0].id, batch);
+            batch.clear();
+            ASSERT_LE(core.size(), options.max_nodes);
+        }
+    }
+
+    // The room left is filled, nobody real is pushed out
+    EXPECT_EQ(core.size(), options.max_nodes);
+    for (const auto &member: real) {
+        EXPECT_TRUE(core.find_node(member.id).has_value());
+    }
+    const auto stats = core.get_stats();
+    EXPECT_EQ(stats.nodes_evicted, 0);
+    EXPECT_EQ(stats.nodes_rejected, fakes - 50);
+
+    // Made-up members reported failed (what they become once probed) are
+    // buried, which makes room for real newcomers; the flood cannot bring
+    // them back with the views it already sent
+    std::vector<node_view> failed;
+    for (uint32_t n = 0; n < 3; ++n) {
+        node_view fake = make_member(1000000 + n, node_status::failed);
+        fake.heartbeat = 2;
+        failed.push_back(fake);
+    }
+    receive(core, real[0].id, failed);
+    EXPECT_EQ(core.size(), options.max_nodes - 3);
+    EXPECT_EQ(core.get_stats().tombstones, 3);
+    receive(core, real[0].id, {make_member(1000000, node_status::online)});
+    EXPECT_FALSE(core.find_node(make_id(1000000)).has_value());
+    receive(core, real[0].id, {make_member(60, node_status::online)});
+    EXPECT_TRUE(core.find_node(make_id(60)).has_value());
+    EXPECT_EQ(core.size(), options.max_nodes - 2);
+    EXPECT_EQ(core.get_stats().nodes_evicted, 0);
+}
+
+TEST(MembershipCapacityTest, EvictionOrderSuspectThenRegion) {
+    gossip_core_options options;
+    options.max_nodes = 6;
+    options.failure_timeout_ms = 600000;
+    options.region_priorities = {"us-east-1", "eu-west-1"};
+    gossip_core core(make_member(0xFFFFFF, node_status::online, "us-east-1"), no_send, nullptr, options);
+
+    const node_view relay = make_member(0, node_status::online, "us-east-1");
+    core.meet(relay);
+    receive(core, relay.id, {relay,
+                             make_member(1, node_status::online, "eu-west-1"),
+                             make_member(2, node_status::online, "ap-south-1"),
+                             make_member(3, node_status::suspect, "us-east-1"),
+                             make_member(4, node_status::failed, "us-east-1"),// Buried, takes no room
+                             make_member(5, node_status::online, "ap-south-1"),
+                             make_member(6, node_status::online, "eu-west-1")});
+    ASSERT_EQ(core.size(), 6);
+
+    auto admit = [&](uint32_t n, const std::string &region) {
+        receive(core, relay.id, {make_member(n, node_status::online, region)});
+        return core.find_node(make_id(n)).has_value();
+    };
+    auto known = [&](uint32_t n) { return core.find_node(make_id(n)).has_value(); };
+
+    EXPECT_TRUE(admit(10, "ap-south-1"));// Evicts the suspect member
+    EXPECT_FALSE(known(3));
+    EXPECT_FALSE(admit(12, "ap-south-1"));// Same class as every unlisted live member
+    EXPECT_TRUE(admit(13, "eu-west-1")); // Evicts the least recently updated unlisted member
+    EXPECT_FALSE(known(2));
+    EXPECT_TRUE(known(5));
+    EXPECT_TRUE(admit(14, "us-east-1"));
+    EXPECT_FALSE(known(5));
+    EXPECT_EQ(core.size(), 6);
+
+    const auto stats = core.get_stats();
+    EXPECT_EQ(stats.nodes_evicted, 3);
+    EXPECT_EQ(stats.nodes_rejected, 1);
+}
+
+TEST(MembershipCapacityTest, PoliciesLimitWhoMakesRoom) {
+    for (auto policy: {eviction_policy::dead_only, eviction_policy::none}) {
+        gossip_core_options options;
+        options.max_nodes = 3;
+        options.eviction = policy;
+        options.failure_timeout_ms = 600000;
+        options.region_priorities = {"us-east-1"};
+        gossip_core core(make_member(0xFFFFFF, node_status::online), no_send, nullptr, options);
+
+        const node_view relay = make_member(0, node_status::online);
+        core.meet(relay);
+        receive(core, relay.id, {relay, make_member(1, node_status::online), make_member(2, node_status::suspect)});
+        ASSERT_EQ(core.size(), 3);
+
+        receive(core, relay.id, {make_member(3, node_status::online, "us-east-1")});
+        EXPECT_EQ(core.find_node(make_id(3)).has_value(), policy == eviction_policy::dead_only);
+        receive(core, relay.id, {make_member(4, node_status::online, "us-east-1")});
+        EXPECT_FALSE(core.find_node(make_id(4)).has_value());// Live members stay
+        EXPECT_EQ(core.size(), 3);
+    }
+}
+
+TEST(MembershipCapacityTest, UnlimitedWithZeroMaxNodes) {
+    gossip_core_options options;
+    options.max_nodes = 0;
+    gossip_core core(make_member(0xFFFFFF, node_status::online), no_send, nullptr, options);
+    for (uint32_t n = 0; n < config::DEFAULT_MAX_NODES + 10; ++n) {
+        core.meet(make_member(n, node_status::online));
+    }
+    EXPECT_EQ(core.size(), config::DEFAULT_MAX_NODES + 10);
+    EXPECT_EQ(core.get_stats().nodes_rejected, 0);
+}
@@ -0,0 +1,166 @@
+#include "core/membership_snapshot.hpp"
+#include <gtest/gtest.h>
+#include <random>
+#include <set>
+#include <unordered_map>
+
+using namespace libgossip;
+
+namespace {
+
+    node_id_t make_id(uint32_t n) {
+        node_id_t id{};
+        id[12] = static_cast<uint8_t>(n >> 24);
+        id[13] = static_cast<uint8_t>(n >> 16);
+        id[14] = static_cast<uint8_t>(n >> 8);
+        id[15] = static_cast<uint8_t>(n);
+        return id;
+    }
+
+    node_view make_node(uint32_t n) {
+        node_view node;
+        node.id = make_id(n);
+        node.ip = "10.0.0.1";
+        node.port = static_cast<int>(n);
+        return node;
+    }
+
+    void insert(membership_table &table, membership_publisher &publisher, uint32_t n) {
+        publisher.mark(table.insert(make_node(n)).index);
+    }
+
+}// namespace
+
+TEST(MembershipSnapshotTest, FindsNodesAndSelf) {
+    membership_table table;
+    membership_publisher publisher;
+    for (uint32_t n = 1; n <= 100; ++n) {
+        insert(table, publisher, n);
+    }
+    const node_view self = make_node(1000);
+    auto snapshot = publisher.publish(table, self);
+
+    EXPECT_EQ(snapshot->size(), 100);
+    EXPECT_EQ(snapshot->version(), 1);
+    EXPECT_EQ(snapshot->self().id, self.id);
+    EXPECT_EQ(snapshot->find(self.id), &snapshot->self());
+    for (uint32_t n = 1; n <= 100; ++n) {
+        const node_view *node = snapshot->find(make_id(n));
+        ASSERT_NE(node, nullptr);
+        EXPECT_EQ(node->port, static_cast<int>(n));
+    }
+    EXPECT_EQ(snapshot->find(make_id(101)), nullptr);
+
+    std::set<int> ports;
+    snapshot->for_each([&ports](const node_view &node) { ports.insert(node.port); });
+    EXPECT_EQ(ports.size(), 100);
+}
+
+TEST(MembershipSnapshotTest, PublishedSnapshotsNeverChange) {
+    membership_table table;
+    membership_publisher publisher;
+    insert(table, publisher, 1);
+    insert(table, publisher, 2);
+    auto before = publisher.publish(table, make_node(1000));
+
+    // Change, remove and add nodes after publishing
+    node_handle one = table.find(make_id(1));
+    table.get(one)->heartbeat = 42;
+    publisher.mark(one.index);
+    node_handle two = table.find(make_id(2));
+    table.erase(two);
+    publisher.mark(two.index);
+    insert(table, publisher, 3);
+    auto after = publisher.publish(table, make_node(1000));
+
+    EXPECT_EQ(before->size(), 2);
+    EXPECT_EQ(before->find(make_id(1))->heartbeat, 0);
+    EXPECT_NE(before->find(make_id(2)), nullptr);
+    EXPECT_EQ(before->find(make_id(3)), nullptr);
+
+    EXPECT_GT(after->version(), before->version());
+    EXPECT_EQ(after->size(), 2);
+    EXPECT_EQ(after->find(make_id(1))->heartbeat, 42);
+    EXPECT_EQ(after->find(make_id(2)), nullptr);
+    EXPECT_NE(after->find(make_id(3)), nullptr);
+}
+
+TEST(MembershipSnapshotTest, UnchangedNodesAreShared) {
+    membership_table table;
+    membership_publisher publisher;
+    for (uint32_t n = 1; n <= 200; ++n) {
+        insert(table, publisher, n);
+    }
+    auto before = publisher.publish(table, make_node(1000));
+
+    node_handle changed = table.find(make_id(7));
+    table.get(changed)->heartbeat = 1;
+    publisher.mark(changed.index);
+    auto after = publisher.publish(table, make_node(1000));
+
+    for (uint32_t n = 1; n <= 200; ++n) {
+        if (n == 7) {
+            EXPECT_NE(after->find(make_id(n)), before->find(make_id(n)));
+        } else {
+            EXPECT_EQ(after->find(make_id(n)), before->find(make_id(n))) << "node " << n << " was copied";
+        }
+    }
+    // Nothing marked: nothing to publish
+    EXPECT_FALSE(publisher.pending());
+}
+
+TEST(MembershipSnapshotTest, MatchesTableAfterRandomChanges) {
+    membership_table table;
+    membership_publisher publisher;
+    std::unordered_map<uint32_t, int> expected;// n -> heartbeat
+    std::mt19937 rng(3);
+    std::shared_ptr<const membership_snapshot> snapshot;
+    for (int op = 0; op < 5000; ++op) {
+        const uint32_t n = rng() % 300;
+        node_handle h = table.find(make_id(n));
+        switch (rng() % 3) {
+            case 0:
+                if (h.valid()) {
+                    table.erase(h);
+                    publisher.mark(h.index);
+                    expected.erase(n);
+                }
+                break;
+            case 1:
+                if (!h.valid()) {
+                    insert(table, publisher, n);
+                    expected[n] = 0;
+                }
+                break;
+            default:
+                if (h.valid()) {
+                    table.get(h)->heartbeat = op;
+                    publisher.mark(h.index);
+                    expected[n] = op;
+                }
+                break;
+        }
+        if (rng() % 10 == 0) {
+            snapshot = publisher.publish(table, make_node(1000));
+        }
+    }
+    snapshot = publisher.publish(table, make_node(1000));
+
+    EXPECT_EQ(snapshot->size(), expected.size());
+    for (uint32_t n = 0; n < 300; ++n) {
+        const node_view *node = snapshot->find(make_id(n));
+        auto it = expected.find(n);
+        if (it == expected.end()) {
+            EXPECT_EQ(node, nullptr) << "node " << n;
+        } else {
+            ASSERT_NE(node, nullptr) << "node " << n;
+            EXPECT_EQ(node->heartbeat, static_cast<uint64_t>(it->second));
+        }
+    }
+
+    table.clear();
+    publisher.clear();
+    snapshot = publisher.publish(table, make_node(1000));
+    EXPECT_EQ(snapshot->size(), 0);
+    EXPECT_EQ(snapshot->find(make_id(1)), nullptr);
+}
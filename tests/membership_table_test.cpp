@@ -0,0 +1,186 @@
+#include "core/membership_table.hpp"
+#include <gtest/gtest.h>
+#include <random>
+#include <unordered_map>
+
+using namespace libgossip;
+
+namespace {
+
+    node_id_t make_id(uint32_t n) {
+        node_id_t id{};
+        id[12] = static_cast<uint8_t>(n >> 24);
+        id[13] = static_cast<uint8_t>(n >> 16);
+        id[14] = static_cast<uint8_t>(n >> 8);
+        id[15] = static_cast<uint8_t>(n);
+        return id;
+    }
+
+    node_view make_node(uint32_t n) {
+        node_view node;
+        node.id = make_id(n);
+        node.ip = "10.0.0.1";
+        node.port = static_cast<int>(n);
+        return node;
+    }
+
+}// namespace
+
+TEST(MembershipTableTest, InsertAndFind) {
+    membership_table table;
+    EXPECT_TRUE(table.empty());
+
+    auto h = table.insert(make_node(1));
+    ASSERT_TRUE(h.valid());
+    EXPECT_EQ(table.size(), 1);
+
+    auto found = table.find(make_id(1));
+    EXPECT_EQ(found, h);
+    ASSERT_NE(table.get(found), nullptr);
+    EXPECT_EQ(table.get(found)->port, 1);
+
+    EXPECT_FALSE(table.find(make_id(2)).valid());
+}
+
+TEST(MembershipTableTest, DuplicateInsertRejected) {
+    membership_table table;
+    EXPECT_TRUE(table.insert(make_node(1)).valid());
+    EXPECT_FALSE(table.insert(make_node(1)).valid());
+    EXPECT_EQ(table.size(), 1);
+}
+
+TEST(MembershipTableTest, EraseInvalidatesHandle) {
+    membership_table table;
+    auto h1 = table.insert(make_node(1));
+    auto h2 = table.insert(make_node(2));
+
+    EXPECT_TRUE(table.erase(h1));
+    EXPECT_EQ(table.get(h1), nullptr);
+    EXPECT_FALSE(table.erase(h1));
+    EXPECT_FALSE(table.find(make_id(1)).valid());
+
+    // The freed slot is reused, but the old handle stays stale
+    auto h3 = table.insert(make_node(3));
+    EXPECT_EQ(h3.index, h1.index);
+    EXPECT_EQ(table.get(h1), nullptr);
+    EXPECT_NE(table.get(h3), nullptr);
+    EXPECT_NE(table.get(h2), nullptr);
+}
+
+TEST(MembershipTableTest, ReferencesStableAcrossGrowth) {
+    membership_table table;
+    auto h = table.insert(make_node(0));
+    node_view *first = table.get(h);
+
+    for (uint32_t i = 1; i < 5000; ++i) {
+        table.insert(make_node(i));
+    }
+    EXPECT_EQ(table.get(h), first);
+    EXPECT_EQ(table.find(make_id(0)), h);
+}
+
+TEST(MembershipTableTest, Rekey) {
+    membership_table table;
+    auto h1 = table.insert(make_node(1));
+    table.insert(make_node(2));
+
+    EXPECT_TRUE(table.rekey(h1, make_id(10)));
+    EXPECT_FALSE(table.find(make_id(1)).valid());
+    EXPECT_EQ(table.find(make_id(10)), h1);
+    EXPECT_EQ(table.get(h1)->id, make_id(10));
+
+    // Rekeying onto an ID owned by another node fails
+    EXPECT_FALSE(table.rekey(h1, make_id(2)));
+    EXPECT_EQ(table.find(make_id(10)), h1);
+}
+
+TEST(MembershipTableTest, EraseIf) {
+    membership_table table;
+    for (uint32_t i = 0; i < 100; ++i) {
+        table.insert(make_node(i));
+    }
+
+    auto erased = table.erase_if([](const node_view &n) { return n.port % 2 == 0; });
+    EXPECT_EQ(erased, 50);
+    EXPECT_EQ(table.size(), 50);
+    table.for_each([](const node_view &n) { EXPECT_EQ(n.port % 2, 1); });
+    for (uint32_t i = 0; i < 100; ++i) {
+        EXPECT_EQ(table.find(make_id(i)).valid(), i % 2 == 1);
+    }
+}
+
+TEST(MembershipTableTest, RandomizedAgainstReference) {
+    membership_table table;
+    std::unordered_map<uint32_t, node_handle> reference;
+    std::mt19937 rng(42);
+
+    for (int step = 0; step < 20000; ++step) {
+        uint32_t key = rng() % 512;
+        auto it = reference.find(key);
+        if (rng() % 3 == 0 && it != reference.end()) {
+            EXPECT_TRUE(table.erase(it->second));
+            reference.erase(it);
+        } else if (it == reference.end()) {
+            auto h = table.insert(make_node(key));
+            ASSERT_TRUE(h.valid());
+            reference.emplace(key, h);
+        }
+        ASSERT_EQ(table.size(), reference.size());
+    }
+
+    for (uint32_t key = 0; key < 512; ++key) {
+        auto it = reference.find(key);
+        if (it == reference.end()) {
+            EXPECT_FALSE(table.find(make_id(key)).valid());
+        } else {
+            EXPECT_EQ(table.find(make_id(key)), it->second);
+        }
+    }
+
+    table.clear();
+    EXPECT_TRUE(table.empty());
+    for (const auto &entry: reference) {
+        EXPECT_EQ(table.get(entry.second), nullptr);
+    }
+}
+
+TEST(MembershipTableTest, EndpointKeyParsing) {
+    auto v4 = make_endpoint_key("10.0.0.1", 7946);
+    EXPECT_EQ(v4, make_endpoint_key("::ffff:10.0.0.1", 7946));
+    EXPECT_EQ(v4, make_endpoint_key("0:0:0:0:0:ffff:a00:1", 7946));
+    EXPECT_NE(v4, make_endpoint_key("10.0.0.1", 7947));
+    EXPECT_NE(v4, make_endpoint_key("10.0.0.2", 7946));
+
+    EXPECT_EQ(make_endpoint_key("::1", 1), make_endpoint_key("0:0:0:0:0:0:0:1", 1));
+    EXPECT_EQ(make_endpoint_key("fe80::1:2", 1), make_endpoint_key("fe80:0:0:0:0:0:1:2", 1));
+    EXPECT_NE(make_endpoint_key("::1", 1), make_endpoint_key("::2", 1));
+
+    // Host names and malformed literals still produce stable, distinct keys
+    EXPECT_EQ(make_endpoint_key("node-a.local", 1), make_endpoint_key("node-a.local", 1));
+    EXPECT_NE(make_endpoint_key("node-a.local", 1), make_endpoint_key("node-b.local", 1));
+    EXPECT_NE(make_endpoint_key("10.0.0.256", 1), make_endpoint_key("10.0.0.0", 1));
+    EXPECT_NE(make_endpoint_key("1:2", 1), make_endpoint_key("1::2", 1));
+}
+
+TEST(MembershipTableTest, FindByEndpoint) {
+    membership_table table;
+    node_view temp = make_node(1);
+    temp.id = node_id_t{};
+    auto h_temp = table.insert(temp);
+    auto h_real = table.insert(make_node(1));
+
+    auto key = make_endpoint_key("10.0.0.1", 1);
+    auto other_than_real = table.find_by_endpoint(key, [](const node_view &n) { return n.id != make_id(1); });
+    EXPECT_EQ(other_than_real, h_temp);
+    auto other_than_temp = table.find_by_endpoint(key, [](const node_view &n) { return n.id != node_id_t{}; });
+    EXPECT_EQ(other_than_temp, h_real);
+
+    // Moving a node to a new address re-indexes it
+    table.get(h_real)->ip = "10.0.0.9";
+    table.refresh_endpoint(h_real);
+    EXPECT_FALSE(table.find_by_endpoint(key, [](const node_view &n) { return n.id != node_id_t{}; }).valid());
+    EXPECT_EQ(table.find_by_endpoint(make_endpoint_key("10.0.0.9", 1), [](const node_view &) { return true; }), h_real);
+
+    table.erase(h_temp);
+    EXPECT_FALSE(table.find_by_endpoint(key, [](const node_view &) { return true; }).valid());
+}
@@ -0,0 +1,160 @@
+#include "core/merkle_tree.hpp"
+#include <algorithm>
+#include <gtest/gtest.h>
+#include <random>
+#include <vector>
+
+using namespace libgossip;
+
+namespace {
+
+    node_id_t make_id(uint32_t n) {
+        node_id_t id{};
+        id[12] = static_cast<uint8_t>(n >> 24);
+        id[13] = static_cast<uint8_t>(n >> 16);
+        id[14] = static_cast<uint8_t>(n >> 8);
+        id[15] = static_cast<uint8_t>(n);
+        return id;
+    }
+
+    void expect_same_tree(const merkle_tree &a, const merkle_tree &b) {
+        for (uint32_t i = 0; i < merkle_tree::node_count; ++i) {
+            ASSERT_EQ(a.hash(i), b.hash(i)) << "tree node " << i;
+        }
+    }
+
+    std::vector<uint32_t> leaf_keys(const merkle_tree &tree, uint32_t leaf) {
+        std::vector<uint32_t> keys;
+        tree.for_each_in_leaf(leaf, [&keys](uint32_t key, uint32_t) { keys.push_back(key); });
+        std::sort(keys.begin(), keys.end());
+        return keys;
+    }
+
+}// namespace
+
+TEST(MerkleTreeTest, EntryHashIgnoresHeartbeat) {
+    node_view node;
+    node.id = make_id(1);
+    node.ip = "10.0.0.1";
+    node.port = 7946;
+    node.status = node_status::online;
+    const uint64_t base = merkle_tree::entry_hash(node);
+
+    node.heartbeat = 42;
+    EXPECT_EQ(merkle_tree::entry_hash(node), base);
+
+    node_view changed = node;
+    changed.metadata["k"] = "v";
+    EXPECT_NE(merkle_tree::entry_hash(changed), base);
+    changed = node;
+    changed.status = node_status::failed;
+    EXPECT_NE(merkle_tree::entry_hash(changed), base);
+    changed = node;
+    changed.config_epoch = 1;
+    EXPECT_NE(merkle_tree::entry_hash(changed), base);
+}
+
+TEST(MerkleTreeTest, SameEntriesSameTreeInAnyOrder) {
+    merkle_tree a;
+    merkle_tree b;
+    const uint32_t count = 1000;
+    for (uint32_t n = 0; n < count; ++n) {
+        a.set(n, 0, make_id(n), 0x9E3779B97F4A7C15ULL * (n + 1));
+    }
+    for (uint32_t n = count; n-- > 0;) {
+        b.set(count - 1 - n, 0, make_id(n), 0x9E3779B97F4A7C15ULL * (n + 1));// Different keys too
+    }
+    EXPECT_NE(a.root(), 0);
+    EXPECT_EQ(a.size(), count);
+    expect_same_tree(a, b);
+}
+
+TEST(MerkleTreeTest, IncrementalUpdatesMatchRebuild) {
+    merkle_tree tree;
+    std::vector<uint64_t> hashes(500, 0);// 0 = absent
+    std::vector<uint32_t> ids(500);
+    std::mt19937_64 rng(7);
+    for (int op = 0; op < 5000; ++op) {
+        const uint32_t key = static_cast<uint32_t>(rng() % hashes.size());
+        switch (rng() % 3) {
+            case 0:
+                tree.remove(key);
+                hashes[key] = 0;
+                break;
+            case 1:
+                ids[key] = static_cast<uint32_t>(rng());// Re-keyed to a new ID
+                [[fallthrough]];
+            default:
+                hashes[key] = rng() | 1;
+                tree.set(key, 0, make_id(ids[key]), hashes[key]);
+                break;
+        }
+    }
+
+    merkle_tree rebuilt;
+    for (uint32_t key = 0; key < hashes.size(); ++key) {
+        if (hashes[key] != 0) {
+            rebuilt.set(key, 0, make_id(ids[key]), hashes[key]);
+        }
+    }
+    EXPECT_EQ(tree.size(), rebuilt.size());
+    expect_same_tree(tree, rebuilt);
+
+    for (uint32_t key = 0; key < hashes.size(); ++key) {
+        tree.remove(key);
+    }
+    EXPECT_EQ(tree.size(), 0);
+    EXPECT_EQ(tree.root(), 0);
+}
+
+TEST(MerkleTreeTest, ChangeOnlyTouchesItsPath) {
+    merkle_tree before;
+    for (uint32_t n = 0; n < 100; ++n) {
+        before.set(n, 0, make_id(n), n + 1);
+    }
+    merkle_tree after;
+    for (uint32_t n = 0; n < 100; ++n) {
+        after.set(n, 0, make_id(n), n == 42 ? 1000 : n + 1);
+    }
+
+    std::vector<uint32_t> differing;
+    for (uint32_t i = 0; i < merkle_tree::node_count; ++i) {
+        if (before.hash(i) != after.hash(i)) {
+            differing.push_back(i);
+        }
+    }
+    // Root, two interior levels and the leaf
+    ASSERT_EQ(differing.size(), merkle_tree::depth + 1);
+    EXPECT_EQ(differing.front(), 0);
+    EXPECT_EQ(differing.back(), merkle_tree::leaf_of(make_id(42)));
+    for (size_t level = 1; level < differing.size(); ++level) {
+        const uint32_t first = merkle_tree::first_child(differing[level - 1]);
+        EXPECT_GE(differing[level], first);
+        EXPECT_LT(differing[level], first + merkle_tree::fanout);
+    }
+}
+
+TEST(MerkleTreeTest, LeafListsFollowSetAndRemove) {
+    merkle_tree tree;
+    const uint32_t leaf = merkle_tree::leaf_of(make_id(5));
+    EXPECT_TRUE(merkle_tree::is_leaf(leaf));
+
+    tree.set(3, 9, make_id(5), 11);
+    std::vector<uint32_t> generations;
+    tree.for_each_in_leaf(leaf, [&generations](uint32_t, uint32_t generation) { generations.push_back(generation); });
+    EXPECT_EQ(generations, std::vector<uint32_t>{9});
+
+    // Move key 3 to an ID in another leaf
+    uint32_t other = 6;
+    while (merkle_tree::leaf_of(make_id(other)) == leaf) {
+        ++other;
+    }
+    tree.set(3, 9, make_id(other), 11);
+    EXPECT_TRUE(leaf_keys(tree, leaf).empty());
+    EXPECT_EQ(leaf_keys(tree, merkle_tree::leaf_of(make_id(other))), std::vector<uint32_t>{3});
+    EXPECT_EQ(tree.hash(leaf), 0);
+
+    tree.remove(3);
+    EXPECT_TRUE(leaf_keys(tree, merkle_tree::leaf_of(make_id(other))).empty());
+    EXPECT_EQ(tree.root(), 0);
+}
@@ -217,9 +217,16 @@ TEST_F(SerializerTest, SerializeNodeWithComplexMetadataTest) {
     node.metadata["nested"] = "{\"json\":\"value\"}";
     node.metadata["long_value"] = std::string(100, 'x'); // Shorter string for test
     node.metadata[""] = "empty_key";  // Empty key
+    node.stamp_metadata();
+    node.set_metadata({{"key1", "value2"}});
     
     msg.entries.push_back(node);
 
+    // A delta of the last change rides along as well
+    node_view delta;
+    delta.assign_delta(node, 1);
+    msg.entries.push_back(delta);
+
     std::vector<uint8_t> data;
     auto ec = serializer->serialize(msg, data);
 
@@ -243,6 +250,14 @@ TEST_F(SerializerTest, SerializeNodeWithComplexMetadataTest) {
     // Verify metadata is preserved
     ASSERT_GT(deserialized_msg.entries.size(), 0);
     EXPECT_EQ(node.metadata, deserialized_msg.entries[0].metadata);
+    EXPECT_EQ(node.metadata_version, deserialized_msg.entries[0].metadata_version);
+    EXPECT_EQ(node.metadata_hash, deserialized_msg.entries[0].metadata_hash);
+    EXPECT_EQ(node.metadata_versions, deserialized_msg.entries[0].metadata_versions);
+
+    ASSERT_EQ(deserialized_msg.entries.size(), 2);
+    EXPECT_EQ(deserialized_msg.entries[1].metadata, (std::map<std::string, std::string>{{"key1", "value2"}}));
+    EXPECT_EQ(deserialized_msg.entries[1].metadata_since, 1);
+    EXPECT_EQ(deserialized_msg.entries[1].metadata_versions, std::vector<uint64_t>{2});
 }
 
 // Test edge cases with minimum and maximum values
@@ -403,6 +418,72 @@ TEST_F(SerializerTest, TimestampSerializationTest) {
     }
 }
 
+TEST_F(SerializerTest, DigestSerializationTest) {
+    gossip_message msg;
+    msg.sender = {{0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15}};
+    msg.type = message_type::pong;
+    msg.timestamp = 42;
+
+    // No digests: the key is left out entirely
+    std::vector<uint8_t> data;
+    ASSERT_EQ(serializer->serialize(msg, data), serialization_error::success);
+    EXPECT_EQ(std::string(data.begin(), data.end()).find("\"digests\""), std::string::npos);
+
+    node_view node = create_test_node(3);
+    msg.entries.push_back(node);
+    msg.digests.push_back({node.id, node.heartbeat, node.config_epoch, state_hash(node)});
+    msg.digests.push_back({{{0xff, 0xee, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0xab}}, 0, 0, 0});
+    msg.digests.push_back({node.id, UINT64_MAX, 7, 0xffffffffu});
+
+    ASSERT_EQ(serializer->serialize(msg, data), serialization_error::success);
+    gossip_message deserialized_msg;
+    ASSERT_EQ(serializer->deserialize(data, deserialized_msg), serialization_error::success);
+    EXPECT_EQ(msg, deserialized_msg);
+}
+
+TEST_F(SerializerTest, MerkleTreeSerializationTest) {
+    gossip_message msg;
+    msg.sender = {{0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15}};
+    msg.type = message_type::sync_bucket;
+    msg.timestamp = 7;
+    msg.tree.push_back({0, 0});
+    msg.tree.push_back({300, UINT64_MAX});
+    msg.tree.push_back({4368, 0x0123456789abcdefULL});
+    msg.digests.push_back({msg.sender, 9, 1, 12345});
+
+    std::vector<uint8_t> data;
+    ASSERT_EQ(serializer->serialize(msg, data), serialization_error::success);
+    gossip_message deserialized_msg;
+    ASSERT_EQ(serializer->deserialize(data, deserialized_msg), serialization_error::success);
+    EXPECT_EQ(msg, deserialized_msg);
+}
+
+TEST_F(SerializerTest, GroupSummarySerializationTest) {
+    gossip_message msg;
+    msg.sender = {{0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15}};
+    msg.type = message_type::group_sync;
+    msg.timestamp = 3;
+    msg.entries.push_back(create_test_node(1));
+
+    group_summary summary;
+    summary.group = "eu-west-1";
+    summary.representative = create_test_node(2);
+    summary.representative.metadata.clear();
+    summary.term = 4;
+    summary.version = UINT64_MAX;
+    summary.members = 250;
+    msg.groups.push_back(summary);
+    summary.group = "";
+    summary.term = 0;
+    msg.groups.push_back(summary);
+
+    std::vector<uint8_t> data;
+    ASSERT_EQ(serializer->serialize(msg, data), serialization_error::success);
+    gossip_message deserialized_msg;
+    ASSERT_EQ(serializer->deserialize(data, deserialized_msg), serialization_error::success);
+    EXPECT_EQ(msg, deserialized_msg);
+}
+
 int main(int argc, char **argv) {
     ::testing::InitGoogleTest(&argc, argv);
     return RUN_ALL_TESTS();
@@ -0,0 +1,150 @@
+#include "sim/simulator.hpp"
+#include <chrono>
+#include <gtest/gtest.h>
+#include <vector>
+
+using namespace libgossip;
+using namespace libgossip::sim;
+using namespace std::chrono_literals;
+
+namespace {
+
+    simulation_options small_cluster_options(uint64_t seed) {
+        simulation_options options;
+        options.seed = seed;
+        options.core.max_nodes = 0;
+        options.core.failure_timeout_ms = 1000;
+        options.core.event_queue_capacity = 16;
+        options.core.event_overflow = event_overflow_policy::grow;
+        return options;
+    }
+
+    // Every node meets node 0
+    void bootstrap(simulator &sim, uint32_t n) {
+        sim.add_nodes(n);
+        for (uint32_t i = 1; i < n; ++i) {
+            sim.meet(i, 0);
+        }
+    }
+
+    // Heartbeat of every node as seen by every core
+    std::vector<uint64_t> heartbeats(const simulator &sim) {
+        std::vector<uint64_t> seen;
+        for (uint32_t i = 0; i < sim.size(); ++i) {
+            for (const auto &node: sim.core(i).get_nodes()) {
+                seen.push_back(node.heartbeat);
+            }
+        }
+        return seen;
+    }
+
+}// namespace
+
+TEST(SimulatorTest, RunsCoresOnAVirtualClock) {
+    const auto before = std::chrono::steady_clock::now();
+    {
+        simulator sim(small_cluster_options(1));
+        bootstrap(sim, 64);
+        auto took = sim.run_until([&sim] { return sim.converged(); }, 60s);
+        ASSERT_TRUE(took.has_value());
+        EXPECT_GT(*took, 0us);
+        EXPECT_EQ(clock::now(), sim.now());
+        EXPECT_EQ(sim.core(0).size(), 63);
+
+        sim.run_for(2min);// Costs only the ticks in it
+        EXPECT_GE(sim.elapsed(), 2min);
+        EXPECT_TRUE(sim.converged());
+        EXPECT_EQ(sim.stats().false_failures, 0);
+        EXPECT_GE(sim.stats().ticks, 64u * 1200);
+    }
+    EXPECT_LT(clock::now() - before, 2min);// steady_clock again
+}
+
+TEST(SimulatorTest, TheSameSeedReplaysARunExactly) {
+    auto run = [](uint64_t seed) {
+        simulation_options options = small_cluster_options(seed);
+        options.network.loss = 0.05;
+        simulator sim(options);
+        bootstrap(sim, 48);
+        sim.run_for(5s);
+        sim.crash(7);
+        sim.run_for(5s);
+        return std::make_pair(sim.stats(), heartbeats(sim));
+    };
+
+    const auto first = run(42);
+    const auto again = run(42);
+    EXPECT_EQ(first.first.messages_sent, again.first.messages_sent);
+    EXPECT_EQ(first.first.messages_lost, again.first.messages_lost);
+    EXPECT_EQ(first.first.entries_sent, again.first.entries_sent);
+    EXPECT_EQ(first.first.false_suspicions, again.first.false_suspicions);
+    EXPECT_EQ(first.second, again.second);
+    EXPECT_GT(first.first.messages_lost, 0);
+
+    const auto other = run(43);
+    EXPECT_NE(first.first.messages_lost, other.first.messages_lost);
+}
+
+TEST(SimulatorTest, ReportsHowACrashWasDetected) {
+    simulator sim(small_cluster_options(3));
+    bootstrap(sim, 32);
+    ASSERT_TRUE(sim.run_until([&sim] { return sim.converged(); }, 60s).has_value());
+
+    sim.crash(5);
+    sim.run_for(10s);
+
+    ASSERT_EQ(sim.detections().size(), 1);
+    const detection &d = sim.detections()[0];
+    EXPECT_EQ(d.node, 5);
+    EXPECT_EQ(d.observers, 31);
+    EXPECT_EQ(d.pending, 0);
+    ASSERT_TRUE(d.first_suspect && d.first_failed && d.all_failed);
+    EXPECT_LE(*d.first_suspect, *d.first_failed);
+    EXPECT_LE(*d.first_failed, *d.all_failed);
+    EXPECT_GE(*d.first_failed, 1s);// failure_timeout_ms
+    EXPECT_EQ(sim.stats().false_failures, 0);
+    EXPECT_TRUE(sim.converged());// 31 members that hold each other
+}
+
+TEST(SimulatorTest, PartitionsDropMessagesUntilHealed) {
+    simulator sim(small_cluster_options(4));
+    bootstrap(sim, 32);
+    ASSERT_TRUE(sim.run_until([&sim] { return sim.converged(); }, 60s).has_value());
+
+    std::vector<uint32_t> minority;
+    for (uint32_t i = 24; i < 32; ++i) {
+        minority.push_back(i);
+    }
+    EXPECT_EQ(sim.partition(minority), 1);
+    sim.run_for(10s);
+
+    EXPECT_GT(sim.stats().messages_partitioned, 0);
+    EXPECT_GT(sim.stats().false_failures, 0);// Each side fails the other
+    EXPECT_EQ(sim.core(0).size(), 23);
+    EXPECT_EQ(sim.core(24).size(), 7);
+
+    // After the network heals, a member of the minority rejoins through a seed
+    sim.heal();
+    sim.meet(24, 0);
+    EXPECT_TRUE(sim.run_until([&sim] { return sim.converged(); }, 60s).has_value());
+}
+
+TEST(SimulatorTest, HierarchicalClustersConvergeToTheirRegions) {
+    simulation_options options = small_cluster_options(5);
+    options.core.hierarchical = true;
+    options.network.cross_region_latency = 40ms;
+    simulator sim(options);
+    sim.add_nodes(48, [](uint32_t i) { return "region-" + std::to_string(i / 16); });
+    for (uint32_t i = 0; i < 48; ++i) {
+        const uint32_t first = i / 16 * 16;
+        if (i != first) {
+            sim.meet(i, first);
+        } else if (i != 0) {
+            sim.meet(i, 0);
+        }
+    }
+
+    ASSERT_TRUE(sim.run_until([&sim] { return sim.converged(); }, 60s).has_value());
+    EXPECT_EQ(sim.core(20).size(), 15);
+    EXPECT_EQ(sim.core(20).get_groups().size(), 3);
+}
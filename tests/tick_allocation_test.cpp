@@ -0,0 +1,132 @@
+#include "core/gossip_core.hpp"
+#include <atomic>
+#include <cstdlib>
+#include <gtest/gtest.h>
+#include <new>
+
+using namespace libgossip;
+
+// Count every heap allocation made by this test binary
+namespace {
+    std::atomic<size_t> allocations{0};
+}// namespace
+
+void *operator new(std::size_t size) {
+    allocations.fetch_add(1, std::memory_order_relaxed);
+    if (void *p = std::malloc(size == 0 ? 1 : size)) {
+        return p;
+    }
+    throw std::bad_alloc();
+}
+
+void operator delete(void *p) noexcept {
+    std::free(p);
+}
+
+void operator delete(void *p, std::size_t) noexcept {
+    std::free(p);
+}
+
+namespace {
+
+    // Long enough to defeat the small string optimization
+    const std::string long_value = "a value longer than any small string buffer";
+
+    node_view make_node(uint32_t n) {
+        node_view node;
+        node.id[14] = static_cast<uint8_t>(n >> 8);
+        node.id[15] = static_cast<uint8_t>(n);
+        node.ip = "10.0.0." + std::to_string(n % 256);
+        node.port = 7000 + static_cast<int>(n);
+        node.status = node_status::online;
+        node.heartbeat = 1;
+        node.role = "replica";
+        node.region = "region-with-a-long-enough-name";
+        node.metadata["slots"] = long_value;
+        node.metadata["version"] = long_value;
+        return node;
+    }
+
+    size_t allocations_during(const std::function<void()> &fn) {
+        const size_t before = allocations.load();
+        fn();
+        return allocations.load() - before;
+    }
+
+}// namespace
+
+TEST(TickAllocationTest, NodeViewAssignReusesStorage) {
+    node_view target = make_node(1);
+    const node_view source = make_node(2);
+    EXPECT_GT(allocations_during([&] { node_view copy = source; }), 0);// The counter works
+    EXPECT_EQ(allocations_during([&] { target.assign(source); }), 0);
+    EXPECT_EQ(target, source);
+
+    // Different metadata keys fall back to a full copy
+    node_view other = make_node(3);
+    other.metadata.erase("slots");
+    target.assign(other);
+    EXPECT_EQ(target, other);
+}
+
+TEST(TickAllocationTest, InterningAPooledValueDoesNotAllocate) {
+    const interned_string pooled = "region-with-a-long-enough-name";
+    const std::string text = pooled.str();
+    const std::string_view view = text;
+    interned_string again;
+    EXPECT_EQ(allocations_during([&] { again = interned_string(view); }), 0);
+    EXPECT_EQ(allocations_during([&] { again = interned_string(text); }), 0);
+    EXPECT_EQ(allocations_during([&] { again = interned_string(text.c_str()); }), 0);
+    EXPECT_EQ(again.c_str(), pooled.c_str());
+}
+
+TEST(TickAllocationTest, SteadyStateTickDoesNotAllocate) {
+    for (auto scheduler: {probe_scheduler::random, probe_scheduler::round_robin}) {
+        gossip_core_options options;
+        options.scheduler = scheduler;
+        options.failure_timeout_ms = 3600 * 1000;// Nobody becomes suspect during the test
+        size_t sent = 0;
+        size_t entries = 0;
+        gossip_core core(
+                make_node(1000),
+                [&](const gossip_message &msg, const node_view &) {
+                    sent++;
+                    entries += msg.entries.size();
+                },
+                nullptr, options);
+        for (uint32_t n = 0; n < 100; ++n) {
+            core.meet(make_node(n));
+        }
+
+        // Warm up: size the reusable message and let a spare snapshot exist
+        for (int i = 0; i < 3; ++i) {
+            core.tick();
+        }
+        auto reader = core.snapshot();
+        reader.reset();
+
+        sent = 0;
+        const size_t allocated = allocations_during([&core] {
+            for (int i = 0; i < 200; ++i) {
+                core.tick();
+            }
+        });
+        EXPECT_EQ(allocated, 0) << "scheduler " << static_cast<int>(scheduler);
+        EXPECT_EQ(sent, 200 * static_cast<size_t>(config::DEFAULT_GOSSIP_NODES));
+        EXPECT_GT(entries, sent);
+        EXPECT_EQ(core.snapshot()->self().heartbeat, core.self().heartbeat);
+    }
+}
+
+TEST(TickAllocationTest, HeldSnapshotsAreNotRecycled) {
+    gossip_core core(make_node(1000), [](const gossip_message &, const node_view &) {}, nullptr);
+    core.meet(make_node(1));
+    auto held = core.snapshot();
+    const uint64_t heartbeat = held->self().heartbeat;
+    for (int i = 0; i < 5; ++i) {
+        core.tick();
+    }
+    EXPECT_EQ(held->self().heartbeat, heartbeat);
+    EXPECT_EQ(held->find(make_node(1).id)->port, 7001);
+    EXPECT_GT(core.snapshot()->version(), held->version());
+}
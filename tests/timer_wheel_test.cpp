@@ -0,0 +1,141 @@
+#include "core/timer_wheel.hpp"
+#include <algorithm>
+#include <gtest/gtest.h>
+#include <map>
+#include <random>
+#include <vector>
+
+using namespace libgossip;
+
+namespace {
+
+    std::vector<uint32_t> fire(timer_wheel &wheel, int64_t now) {
+        std::vector<uint32_t> fired;
+        wheel.advance(now, [&fired](uint32_t id, uint32_t) { fired.push_back(id); });
+        std::sort(fired.begin(), fired.end());
+        return fired;
+    }
+
+}// namespace
+
+TEST(TimerWheelTest, FiresAtDeadline) {
+    timer_wheel wheel(8);
+    wheel.schedule(1, 0, 10);
+    wheel.schedule(2, 0, 12);
+    EXPECT_EQ(wheel.size(), 2);
+
+    EXPECT_TRUE(fire(wheel, 9).empty());
+    EXPECT_EQ(fire(wheel, 10), std::vector<uint32_t>{1});
+    EXPECT_FALSE(wheel.armed(1));
+    EXPECT_TRUE(wheel.armed(2));
+    EXPECT_EQ(fire(wheel, 20), std::vector<uint32_t>{2});
+    EXPECT_EQ(wheel.size(), 0);
+}
+
+TEST(TimerWheelTest, DeadlinesBeyondOneRevolution) {
+    timer_wheel wheel(8);
+    wheel.schedule(1, 0, 3);
+    wheel.schedule(2, 0, 3 + 8);
+    wheel.schedule(3, 0, 3 + 800);
+
+    EXPECT_TRUE(fire(wheel, 0).empty());
+    EXPECT_EQ(fire(wheel, 3), std::vector<uint32_t>{1});
+    EXPECT_TRUE(fire(wheel, 10).empty());
+    EXPECT_EQ(fire(wheel, 11), std::vector<uint32_t>{2});
+
+    // A long pause scans the whole wheel once
+    EXPECT_EQ(fire(wheel, 5000), std::vector<uint32_t>{3});
+}
+
+TEST(TimerWheelTest, ScheduleOnlyMovesEarlier) {
+    timer_wheel wheel(8);
+    wheel.schedule(1, 0, 10);
+    wheel.schedule(1, 0, 20);// Later for the same generation: kept at 10
+    EXPECT_EQ(fire(wheel, 10), std::vector<uint32_t>{1});
+
+    wheel.schedule(1, 0, 20);
+    wheel.schedule(1, 0, 15);
+    EXPECT_EQ(wheel.size(), 1);
+    EXPECT_EQ(fire(wheel, 15), std::vector<uint32_t>{1});
+
+    // A new generation replaces the old timer whatever its deadline
+    wheel.schedule(1, 0, 16);
+    wheel.schedule(1, 1, 30);
+    EXPECT_TRUE(fire(wheel, 29).empty());
+    std::vector<std::pair<uint32_t, uint32_t>> fired;
+    wheel.advance(30, [&fired](uint32_t id, uint32_t generation) { fired.emplace_back(id, generation); });
+    ASSERT_EQ(fired.size(), 1);
+    EXPECT_EQ(fired[0], std::make_pair(1u, 1u));
+}
+
+TEST(TimerWheelTest, RearmFromCallbackAndPastDeadlines) {
+    timer_wheel wheel(8);
+    wheel.schedule(1, 0, 5);
+    wheel.advance(5, [&wheel](uint32_t id, uint32_t generation) {
+        // Re-arming in the past is clamped to the cursor, checked next call
+        wheel.schedule(id, generation, 1);
+    });
+    EXPECT_TRUE(wheel.armed(1));
+    EXPECT_EQ(fire(wheel, 5), std::vector<uint32_t>{1});
+
+    wheel.schedule(2, 0, 0);
+    EXPECT_EQ(fire(wheel, 6), std::vector<uint32_t>{2});
+}
+
+TEST(TimerWheelTest, CancelAndClear) {
+    timer_wheel wheel(8);
+    wheel.schedule(1, 0, 4);
+    wheel.schedule(2, 0, 4);
+    wheel.schedule(3, 0, 4);
+    wheel.cancel(2);
+    wheel.cancel(7);
+    EXPECT_EQ(wheel.size(), 2);
+    EXPECT_EQ(fire(wheel, 4), (std::vector<uint32_t>{1, 3}));
+
+    wheel.schedule(4, 0, 100);
+    wheel.clear();
+    EXPECT_EQ(wheel.size(), 0);
+    EXPECT_EQ(wheel.cursor(), std::numeric_limits<int64_t>::min());
+    EXPECT_TRUE(fire(wheel, 1000).empty());
+}
+
+TEST(TimerWheelTest, RandomizedAgainstReference) {
+    timer_wheel wheel(64);
+    std::map<uint32_t, int64_t> reference;
+    std::mt19937 rng(7);
+    int64_t now = 0;
+
+    for (int step = 0; step < 5000; ++step) {
+        uint32_t id = rng() % 200;
+        switch (rng() % 4) {
+            case 0:
+                wheel.cancel(id);
+                reference.erase(id);
+                break;
+            case 1: {
+                now += rng() % 50;
+                std::vector<uint32_t> expected;
+                for (auto it = reference.begin(); it != reference.end();) {
+                    if (it->second <= now) {
+                        expected.push_back(it->first);
+                        it = reference.erase(it);
+                    } else {
+                        ++it;
+                    }
+                }
+                ASSERT_EQ(fire(wheel, now), expected);
+                break;
+            }
+            default: {
+                int64_t tick = now + static_cast<int64_t>(rng() % 300);
+                wheel.schedule(id, 0, tick);
+                auto it = reference.find(id);
+                if (it == reference.end() || tick < it->second) {
+                    reference[id] = tick;
+                }
+                break;
+            }
+        }
+        ASSERT_EQ(wheel.size(), reference.size());
+    }
+}
@@ -0,0 +1,123 @@
+#include "core/tombstone_store.hpp"
+#include <chrono>
+#include <gtest/gtest.h>
+#include <string>
+#include <vector>
+
+using namespace libgossip;
+
+namespace {
+
+    node_view make_dead(uint8_t n, uint64_t heartbeat = 1) {
+        node_view node;
+        node.id[15] = n;
+        node.ip = "10.0.0." + std::to_string(n);
+        node.port = 7000 + n;
+        node.heartbeat = heartbeat;
+        node.status = node_status::failed;
+        node.metadata["role"] = "cache";
+        return node;
+    }
+
+    std::vector<uint8_t> buried(const tombstone_store &store) {
+        std::vector<uint8_t> out;
+        store.for_each([&out](const node_view &node) { out.push_back(node.id[15]); });
+        return out;
+    }
+
+}// namespace
+
+TEST(TombstoneStoreTest, ExpiresOldestFirst) {
+    tombstone_store store;
+    const time_point t0{};
+    store.bury(make_dead(1), t0 + std::chrono::milliseconds(10));
+    store.bury(make_dead(2), t0 + std::chrono::milliseconds(20));
+    store.bury(make_dead(3), t0 + std::chrono::milliseconds(5));// Clamped to 20, stays last
+    ASSERT_EQ(store.size(), 3);
+    EXPECT_EQ(buried(store), (std::vector<uint8_t>{1, 2, 3}));
+
+    const node_view *dead = store.find(make_dead(2).id);
+    ASSERT_NE(dead, nullptr);
+    EXPECT_EQ(dead->status, node_status::failed);
+    EXPECT_EQ(dead->port, 7002);
+    EXPECT_TRUE(dead->metadata.empty());// Not kept
+
+    EXPECT_EQ(store.expire(t0 + std::chrono::milliseconds(9)), 0);
+    EXPECT_EQ(store.expire(t0 + std::chrono::milliseconds(10)), 1);
+    EXPECT_EQ(store.find(make_dead(1).id), nullptr);
+    EXPECT_EQ(store.expire(t0 + std::chrono::milliseconds(20)), 2);
+    EXPECT_TRUE(store.empty());
+}
+
+TEST(TombstoneStoreTest, EraseAndReburyKeepTheQueueConsistent) {
+    tombstone_store store;
+    const time_point t0{};
+    for (uint8_t n = 1; n <= 4; ++n) {
+        store.bury(make_dead(n), t0 + std::chrono::milliseconds(n));
+    }
+
+    EXPECT_TRUE(store.erase(make_dead(2).id));// Came back
+    EXPECT_FALSE(store.erase(make_dead(2).id));
+    EXPECT_EQ(store.find(make_dead(2).id), nullptr);
+    store.bury(make_dead(3, 9), t0 + std::chrono::milliseconds(5));// Died again, newer view
+    EXPECT_EQ(store.size(), 3);
+    EXPECT_EQ(buried(store), (std::vector<uint8_t>{1, 4, 3}));
+    EXPECT_EQ(store.find(make_dead(3).id)->heartbeat, 9);
+
+    EXPECT_EQ(store.expire(t0 + std::chrono::milliseconds(4)), 2);// 1 and 4, the holes go too
+    EXPECT_EQ(store.find(make_dead(3).id)->heartbeat, 9);
+    store.clear();
+    EXPECT_TRUE(store.empty());
+    EXPECT_EQ(store.find(make_dead(3).id), nullptr);
+}
+
+TEST(TombstoneStoreTest, CapacityDropsTheOldest) {
+    tombstone_store store(3);
+    const time_point t0{};
+    for (uint8_t n = 1; n <= 5; ++n) {
+        store.bury(make_dead(n), t0 + std::chrono::milliseconds(n));
+        EXPECT_LE(store.size(), 3);
+    }
+    EXPECT_EQ(buried(store), (std::vector<uint8_t>{3, 4, 5}));
+    EXPECT_EQ(store.find(make_dead(1).id), nullptr);
+
+    // Holes count against the capacity as well, so flapping stays bounded
+    for (int i = 0; i < 100; ++i) {
+        store.erase(make_dead(5).id);
+        store.bury(make_dead(5), t0 + std::chrono::milliseconds(10 + i));
+    }
+    EXPECT_EQ(buried(store), (std::vector<uint8_t>{5}));
+}
+
+TEST(TombstoneStoreTest, TakeSpreadsEachDeathALimitedNumberOfTimes) {
+    tombstone_store store;
+    const time_point t0{};
+    for (uint8_t n = 1; n <= 3; ++n) {
+        store.bury(make_dead(n), t0 + std::chrono::milliseconds(n));
+    }
+    auto any = [](const node_view &) { return true; };
+    auto ids = [](const std::vector<const node_view *> &views) {
+        std::vector<uint8_t> out;
+        for (const node_view *view: views) {
+            out.push_back(view->id[15]);
+        }
+        return out;
+    };
+
+    std::vector<const node_view *> out;
+    store.take(2, 2, any, out);
+    EXPECT_EQ(ids(out), (std::vector<uint8_t>{3, 2}));// Newest first
+    store.take(2, 2, any, out);
+    EXPECT_EQ(ids(out), (std::vector<uint8_t>{1, 3}));// Then the least transmitted
+    store.take(8, 2, [](const node_view &node) { return node.id[15] != 2; }, out);
+    EXPECT_EQ(ids(out), (std::vector<uint8_t>{1}));// 3 is done, 2 skipped
+
+    store.erase(make_dead(2).id);// Came back: nothing left to send
+    store.take(8, 2, any, out);
+    EXPECT_TRUE(out.empty());
+
+    store.bury(make_dead(1, 5), t0 + std::chrono::milliseconds(9));// Died again: news again
+    store.take(8, 2, any, out);
+    EXPECT_EQ(ids(out), (std::vector<uint8_t>{1}));
+    EXPECT_EQ(out[0]->heartbeat, 5);
+}
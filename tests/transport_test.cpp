@@ -1,9 +1,11 @@
 #include "net/json_serializer.hpp"
 #include "net/transport_factory.hpp"
+#include "net/udp_transport.hpp"
 #include <chrono>
 #include <future>
 #include <gtest/gtest.h>
 #include <memory>
+#include <thread>
 
 using namespace gossip::net;
 
@@ -136,6 +138,44 @@ TEST_F(TransportTest, UdpTransportAsyncSendTest) {
     EXPECT_EQ(ec, error_code::success);
 }
 
+TEST_F(TransportTest, UdpTransportCoalesceTest) {
+    // A receiver whose core learns every sender it hears from
+    libgossip::node_view receiver_node = create_test_node(21);
+    auto receiver_core = std::make_shared<libgossip::gossip_core>(receiver_node, mock_send_callback, mock_event_callback);
+    auto receiver = transport_factory::create_transport(
+            transport_type::udp, "127.0.0.1", receiver_node.port);
+    ASSERT_NE(receiver, nullptr);
+    receiver->set_gossip_core(receiver_core);
+    ASSERT_EQ(receiver->start(), error_code::success);
+
+    auto sender = transport_factory::create_transport(
+            transport_type::udp, "127.0.0.1", 8022);
+    ASSERT_NE(sender, nullptr);
+    sender->set_gossip_core(core);
+    sender->set_coalesce_window(std::chrono::milliseconds(20));
+    ASSERT_EQ(sender->start(), error_code::success);
+
+    for (uint8_t n = 30; n < 33; ++n) {
+        libgossip::gossip_message msg;
+        msg.sender = create_test_node(n).id;
+        msg.type = libgossip::message_type::ping;
+        msg.timestamp = 12345;
+        msg.entries.push_back(create_test_node(n));
+        EXPECT_EQ(sender->send_message(msg, receiver_node), error_code::success);
+    }
+    EXPECT_EQ(sender->frames_sent(), 3);
+    EXPECT_EQ(sender->datagrams_sent(), 0);// Waiting for the window
+
+    for (int i = 0; i < 100 && receiver_core->size() < 3; ++i) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+    EXPECT_EQ(receiver_core->size(), 3);// All three frames parsed from one datagram
+    EXPECT_EQ(sender->datagrams_sent(), 1);
+
+    EXPECT_EQ(sender->stop(), error_code::success);
+    EXPECT_EQ(receiver->stop(), error_code::success);
+}
+
 // Tests for TCP transport
 TEST_F(TransportTest, TcpTransportCreateTest) {
     auto transport = transport_factory::create_transport(